@@ -0,0 +1,260 @@
+#include <iostream>
+#include <algorithm>
+#include "BridgingFaultSim.h"
+
+/*
+* Constructor for the class
+* @param inTopology -> levelized circuit to simulate
+*/
+BridgingFaultSim::BridgingFaultSim(LevelizedCircuit* inTopology) :
+    topology(inTopology), dropDetectedFaults(false)
+{
+    int numNodes = this->topology->get_num_nodes();
+    this->goodWords.assign(numNodes, 0);
+    this->faultyWords.assign(numNodes, 0);
+    this->faultyStamp.assign(numNodes, -1);
+    this->levelEvents.assign(this->topology->maxLevel + 1, std::vector<int>());
+    this->gateScheduled.assign(this->topology->gates.size(), false);
+}
+
+/*
+* Function to add a bridging fault
+* @param node1Name -> name of the first net in netlist (dominant net for DOMINANT)
+* @param node2Name -> name of the second net in netlist
+* @param faultType -> 0 = wired-AND, 1 = wired-OR, 2 = first net dominates
+* @return bool -> if the nets exist and the type is known
+*/
+bool BridgingFaultSim::add_fault(int node1Name, int node2Name, int faultType)
+{
+    BridgingFault newFault;
+    newFault.node1 = this->topology->get_node_index(node1Name);
+    newFault.node2 = this->topology->get_node_index(node2Name);
+    if (newFault.node1 == -1 || newFault.node2 == -1 || newFault.node1 == newFault.node2)
+    {
+        std::cerr << "Invalid nets for bridging fault: " << node1Name << " " << node2Name << "\n";
+        return false;
+    }
+    if (faultType < WIRED_AND || faultType > DOMINANT)
+    {
+        std::cerr << "Unknown bridging fault type: " << faultType << "\n";
+        return false;
+    }
+    newFault.type = (bridgeType)faultType;
+    this->faultList.push_back(newFault);
+    this->faultActive.push_back(true);
+    return true;
+}
+
+/*
+* Function to enable dropping of detected faults
+* When enabled, a fault is reported only by the first vector detecting it
+* @param inDropDetectedFaults -> drop faults once detected
+*/
+void BridgingFaultSim::set_fault_dropping(bool inDropDetectedFaults)
+{
+    this->dropDetectedFaults = inDropDetectedFaults;
+}
+
+/*
+* Function to get the faulty word of a node for the fault being propagated
+* @param nodeIndex -> index of the node
+* @param faultIndex -> fault being propagated
+* @return uint64_t -> faulty word, good word if not reached by the fault
+*/
+uint64_t BridgingFaultSim::get_faulty_word(int nodeIndex, int faultIndex)
+{
+    return (this->faultyStamp[nodeIndex] == faultIndex) ?
+        this->faultyWords[nodeIndex] : this->goodWords[nodeIndex];
+}
+
+/*
+* Function to propagate a bridging fault through the fanout cones of its nets
+* @param faultIndex -> fault to propagate
+* @param validMask -> bits of the vectors in the block
+* @return uint64_t -> bits of the vectors detecting the fault
+*/
+uint64_t BridgingFaultSim::propagate_fault(int faultIndex, uint64_t validMask)
+{
+    const BridgingFault& currFault = this->faultList[faultIndex];
+    uint64_t good1Word = this->goodWords[currFault.node1];
+    uint64_t good2Word = this->goodWords[currFault.node2];
+    if (((good1Word ^ good2Word) & validMask) == 0)
+    {
+        // nets driven to the same value by every vector of the block
+        return 0;
+    }
+
+    // Resolve the values of the bridged nets
+    uint64_t bridged1Word, bridged2Word;
+    switch (currFault.type)
+    {
+    case WIRED_AND:
+        bridged1Word = bridged2Word = good1Word & good2Word;
+        break;
+    case WIRED_OR:
+        bridged1Word = bridged2Word = good1Word | good2Word;
+        break;
+    default:
+        bridged1Word = bridged2Word = good1Word;
+        break;
+    }
+
+    uint64_t detectedMask = 0;
+    std::vector<int> changedNodes;
+    int bridgedNodes[2] = { currFault.node1, currFault.node2 };
+    uint64_t bridgedWords[2] = { bridged1Word, bridged2Word };
+    for (int i = 0; i < 2; ++i)
+    {
+        uint64_t diffWord = (bridgedWords[i] ^ this->goodWords[bridgedNodes[i]]) & validMask;
+        if (diffWord == 0)
+        {
+            continue;
+        }
+        this->faultyWords[bridgedNodes[i]] = bridgedWords[i];
+        this->faultyStamp[bridgedNodes[i]] = faultIndex;
+        changedNodes.push_back(bridgedNodes[i]);
+        if (this->topology->isOutput[bridgedNodes[i]])
+        {
+            detectedMask |= diffWord;
+        }
+    }
+
+    int pendingEvents = 0;
+    int firstLevel = std::min(this->topology->nodeLevel[currFault.node1], this->topology->nodeLevel[currFault.node2]);
+    for (int level = firstLevel; level <= this->topology->maxLevel; ++level)
+    {
+        // schedule the fanout of the nodes changed on the previous level
+        for (int changedNode : changedNodes)
+        {
+            for (int gateIndex : this->topology->fanoutGates[changedNode])
+            {
+                if (this->gateScheduled[gateIndex] == false)
+                {
+                    this->gateScheduled[gateIndex] = true;
+                    this->levelEvents[this->topology->gates[gateIndex].level].push_back(gateIndex);
+                    ++pendingEvents;
+                }
+            }
+        }
+        changedNodes.clear();
+        if (pendingEvents == 0)
+        {
+            // fault effect blocked on every path
+            break;
+        }
+        for (int gateIndex : this->levelEvents[level])
+        {
+            this->gateScheduled[gateIndex] = false;
+            --pendingEvents;
+            const LevelizedGate& currGate = this->topology->gates[gateIndex];
+            if (currGate.output == currFault.node1 || currGate.output == currFault.node2)
+            {
+                // bridged net reached through the other net => no feedback
+                continue;
+            }
+            uint64_t input2Word = (currGate.input2 == -1) ? 0 : this->get_faulty_word(currGate.input2, faultIndex);
+            uint64_t outputWord = evaluate_gate_word(currGate.logic,
+                this->get_faulty_word(currGate.input1, faultIndex), input2Word);
+            uint64_t diffWord = (outputWord ^ this->goodWords[currGate.output]) & validMask;
+            if (diffWord == 0)
+            {
+                continue;
+            }
+            this->faultyWords[currGate.output] = outputWord;
+            this->faultyStamp[currGate.output] = faultIndex;
+            changedNodes.push_back(currGate.output);
+            if (this->topology->isOutput[currGate.output])
+            {
+                detectedMask |= diffWord;
+            }
+        }
+        this->levelEvents[level].clear();
+    }
+    return detectedMask;
+}
+
+/*
+* Function to apply a block of test vectors, 64 vectors per simulation pass
+* @param testVectors -> test vectors applied
+* @param detectedFaults -> sorted fault indices detected by each vector (updated in place)
+* @return bool -> if all test vectors applied successfully
+*/
+bool BridgingFaultSim::apply_test_vectors(const std::vector<std::string>& testVectors,
+    std::vector<std::vector<int>>& detectedFaults)
+{
+    detectedFaults.assign(testVectors.size(), std::vector<int>());
+    std::vector<int> inputValues;
+    for (unsigned int first = 0; first < testVectors.size(); first += 64)
+    {
+        // Pack the next 64 vectors, vector k in bit k
+        int numVectors = std::min<size_t>(64, testVectors.size() - first);
+        uint64_t validMask = (numVectors >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << numVectors) - 1);
+        this->goodWords.assign(this->goodWords.size(), 0);
+        for (int k = 0; k < numVectors; ++k)
+        {
+            if (this->topology->parse_test_vector(testVectors[first + k], inputValues) == false)
+            {
+                return false;
+            }
+            for (unsigned int i = 0; i < inputValues.size(); ++i)
+            {
+                this->goodWords[this->topology->inputNodes[i]] |= (uint64_t)inputValues[i] << k;
+            }
+        }
+
+        // Good machine simulation in level order
+        for (const LevelizedGate& currGate : this->topology->gates)
+        {
+            uint64_t input2Word = (currGate.input2 == -1) ? 0 : this->goodWords[currGate.input2];
+            this->goodWords[currGate.output] = evaluate_gate_word(currGate.logic,
+                this->goodWords[currGate.input1], input2Word);
+        }
+
+        // Single fault propagation, faults in index order => per vector lists come out sorted
+        for (unsigned int faultIndex = 0; faultIndex < this->faultList.size(); ++faultIndex)
+        {
+            if (this->faultActive[faultIndex] == false)
+            {
+                continue;
+            }
+            uint64_t detectedMask = this->propagate_fault(faultIndex, validMask);
+            if (detectedMask == 0)
+            {
+                continue;
+            }
+            if (this->dropDetectedFaults)
+            {
+                // report the first detecting vector only
+                detectedMask &= ~detectedMask + 1;
+                this->faultActive[faultIndex] = false;
+            }
+            while (detectedMask != 0)
+            {
+                detectedFaults[first + __builtin_ctzll(detectedMask)].push_back(faultIndex);
+                detectedMask &= detectedMask - 1;
+            }
+        }
+        // stamps of this block must not match any fault of the next block
+        this->faultyStamp.assign(this->faultyStamp.size(), -1);
+    }
+    return true;
+}
+
+/*
+* Function to get a bridging fault
+* @param faultIndex -> index of the fault in the order added
+* @return BridgingFault -> bridged node indices and type
+*/
+const BridgingFault& BridgingFaultSim::get_fault(int faultIndex)
+{
+    return this->faultList[faultIndex];
+}
+
+/*
+* Function to get total faults graded by the engine
+* @return int -> total faults
+*/
+int BridgingFaultSim::get_total_faults_count()
+{
+    return this->faultList.size();
+}
@@ -0,0 +1,139 @@
+#ifndef __BRIDGINGFAULTSIM_H__
+#define __BRIDGINGFAULTSIM_H__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "LevelizedCircuit.h"
+
+/*
+* Enum for the bridging fault behaviour
+*/
+enum bridgeType
+{
+    // both nets take the AND of the driven values
+    WIRED_AND = 0,
+    // both nets take the OR of the driven values
+    WIRED_OR = 1,
+    // the second net takes the value driven on the first net
+    DOMINANT = 2
+};
+
+/*
+* Bridging fault between two nets, nets stored as node indices
+*/
+struct BridgingFault
+{
+    // First bridged node (the dominant node for DOMINANT bridges)
+    int node1;
+    // Second bridged node
+    int node2;
+    // Behaviour of the bridge
+    bridgeType type;
+};
+
+/*
+* Bit parallel bridging fault simulator
+* Up to 64 test vectors are packed into one word per node as in the PPSFP
+* engine. The good machine is simulated once per block; a bridge is only
+* simulated for the vectors where the two nets are driven to different values
+* and then only through the fanout cones of the two bridged nets, as far as
+* the faulty words differ from the good words. The bridged nets keep the
+* values resolved from their good machine drivers, so a bridge closing a
+* loop (one net in the fanout cone of the other) is evaluated without
+* feedback.
+*/
+class BridgingFaultSim
+{
+    // Read-only topology shared with other engines
+    LevelizedCircuit* topology;
+
+    // Bridging faults graded, in the order added
+    std::vector<BridgingFault> faultList;
+
+    // Good machine word per node for the current block
+    std::vector<uint64_t> goodWords;
+
+    // Faulty machine word per node, valid where faultyStamp matches
+    std::vector<uint64_t> faultyWords;
+
+    // Node index to fault being propagated when its faulty word was set
+    std::vector<int> faultyStamp;
+
+    // Whether the fault is still graded (not dropped)
+    std::vector<bool> faultActive;
+
+    // Drop faults from the active set once detected
+    bool dropDetectedFaults;
+
+    // Gates scheduled for fault propagation, bucketed by level
+    std::vector<std::vector<int>> levelEvents;
+
+    // Whether the gate is already in the event buckets
+    std::vector<bool> gateScheduled;
+
+    /*
+    * Function to get the faulty word of a node for the fault being propagated
+    * @param nodeIndex -> index of the node
+    * @param faultIndex -> fault being propagated
+    * @return uint64_t -> faulty word, good word if not reached by the fault
+    */
+    uint64_t get_faulty_word(int nodeIndex, int faultIndex);
+
+    /*
+    * Function to propagate a bridging fault through the fanout cones of its nets
+    * @param faultIndex -> fault to propagate
+    * @param validMask -> bits of the vectors in the block
+    * @return uint64_t -> bits of the vectors detecting the fault
+    */
+    uint64_t propagate_fault(int faultIndex, uint64_t validMask);
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inTopology -> levelized circuit to simulate
+    */
+    BridgingFaultSim(LevelizedCircuit* inTopology);
+
+    /*
+    * Function to add a bridging fault
+    * @param node1Name -> name of the first net in netlist (dominant net for DOMINANT)
+    * @param node2Name -> name of the second net in netlist
+    * @param faultType -> 0 = wired-AND, 1 = wired-OR, 2 = first net dominates
+    * @return bool -> if the nets exist and the type is known
+    */
+    bool add_fault(int node1Name, int node2Name, int faultType);
+
+    /*
+    * Function to enable dropping of detected faults
+    * When enabled, a fault is reported only by the first vector detecting it
+    * @param inDropDetectedFaults -> drop faults once detected
+    */
+    void set_fault_dropping(bool inDropDetectedFaults);
+
+    /*
+    * Function to apply a block of test vectors, 64 vectors per simulation pass
+    * @param testVectors -> test vectors applied
+    * @param detectedFaults -> sorted fault indices detected by each vector (updated in place)
+    * @return bool -> if all test vectors applied successfully
+    */
+    bool apply_test_vectors(const std::vector<std::string>& testVectors,
+        std::vector<std::vector<int>>& detectedFaults);
+
+    /*
+    * Function to get a bridging fault
+    * @param faultIndex -> index of the fault in the order added
+    * @return BridgingFault -> bridged node indices and type
+    */
+    const BridgingFault& get_fault(int faultIndex);
+
+    /*
+    * Function to get total faults graded by the engine
+    * @return int -> total faults
+    */
+    int get_total_faults_count();
+};
+
+#endif
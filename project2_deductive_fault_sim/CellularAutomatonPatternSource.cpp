@@ -0,0 +1,102 @@
+#include "CellularAutomatonPatternSource.h"
+
+// Cells following rule 150 (even cells)
+const uint64_t rule150Mask = 0x5555555555555555ULL;
+
+// Feedback mask of the boundary LFSR for taps 64, 63, 61, 60
+const uint64_t boundaryFeedbackMask = 0xD800000000000000ULL;
+
+/*
+* Constructor for the class
+* @param inWidth -> number of bits per pattern
+* @param seed -> initial value of the first 64 cells and of the boundary LFSR (0 is replaced by 1)
+*/
+CellularAutomatonPatternSource::CellularAutomatonPatternSource(int inWidth, uint64_t seed) :
+    width(inWidth), boundaryState(seed == 0 ? 1 : seed)
+{
+    int numWords = get_pattern_words(this->width);
+    this->cellState.assign(numWords, 0);
+    if (numWords > 0)
+    {
+        this->cellState[0] = this->boundaryState;
+        if (this->width < 64)
+        {
+            this->cellState[0] &= (1ULL << this->width) - 1;
+        }
+    }
+}
+
+/*
+* Function to generate the next pattern
+* @param patternWords -> packed pattern (updated in place)
+*/
+void CellularAutomatonPatternSource::next_pattern(std::vector<uint64_t>& patternWords)
+{
+    int numWords = this->cellState.size();
+    patternWords.resize(numWords);
+    if (numWords == 0)
+    {
+        return;
+    }
+
+    // next bit of the boundary LFSR enters on the left of cell 0
+    uint64_t boundaryBit = this->boundaryState & 1;
+    this->boundaryState >>= 1;
+    if (boundaryBit)
+    {
+        this->boundaryState ^= boundaryFeedbackMask;
+    }
+
+    for (int i = 0; i < numWords; ++i)
+    {
+        // cell j sees cell j - 1 on the left and cell j + 1 on the right
+        uint64_t leftCells = (this->cellState[i] << 1) | ((i > 0) ? this->cellState[i - 1] >> 63 : boundaryBit);
+        uint64_t rightCells = this->cellState[i] >> 1;
+        if (i + 1 < numWords)
+        {
+            rightCells |= this->cellState[i + 1] << 63;
+        }
+        patternWords[i] = leftCells ^ rightCells ^ (this->cellState[i] & rule150Mask);
+    }
+    if (this->width % 64 != 0)
+    {
+        patternWords[numWords - 1] &= (1ULL << (this->width % 64)) - 1;
+    }
+    this->cellState = patternWords;
+}
+
+/*
+* Function to get the pattern width
+* @return int -> number of bits per pattern
+*/
+int CellularAutomatonPatternSource::get_width()
+{
+    return this->width;
+}
+
+/*
+* Function to get the generator state, for checkpointing
+* @return vector of uint64_t -> cell words followed by the boundary LFSR state
+*/
+std::vector<uint64_t> CellularAutomatonPatternSource::get_state()
+{
+    std::vector<uint64_t> stateWords(this->cellState);
+    stateWords.push_back(this->boundaryState);
+    return stateWords;
+}
+
+/*
+* Function to restore a generator state returned by get_state
+* @param stateWords -> cell words followed by the boundary LFSR state
+* @return bool -> if the state is valid for the generator
+*/
+bool CellularAutomatonPatternSource::set_state(const std::vector<uint64_t>& stateWords)
+{
+    if (stateWords.size() != this->cellState.size() + 1 || stateWords.back() == 0)
+    {
+        return false;
+    }
+    this->cellState.assign(stateWords.begin(), stateWords.end() - 1);
+    this->boundaryState = stateWords.back();
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef __CELLULARAUTOMATONPATTERNSOURCE_H__
+#define __CELLULARAUTOMATONPATTERNSOURCE_H__
+
+#include <vector>
+#include <cstdint>
+
+#include "PatternSource.h"
+
+/*
+* Cellular automaton pattern generator of arbitrary width
+* One cell per pattern bit. Even cells follow rule 150 (left ^ self ^ right)
+* and odd cells rule 90 (left ^ right). The cells are packed in 64-bit words
+* so a whole pattern is updated with word operations. Each pattern is the
+* next state of the automaton.
+* A fixed 90/150 rule vector is not maximal length for every width, so the
+* left boundary of cell 0 is driven by a maximal length 64-bit LFSR instead
+* of 0. This keeps the automaton from cycling early or dying out.
+*/
+class CellularAutomatonPatternSource : public PatternSource
+{
+    // Number of cells (bits per pattern)
+    int width;
+
+    // Cell values, packed
+    std::vector<uint64_t> cellState;
+
+    // State of the LFSR driving the left boundary (never 0)
+    uint64_t boundaryState;
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inWidth -> number of bits per pattern
+    * @param seed -> initial value of the first 64 cells and of the boundary LFSR (0 is replaced by 1)
+    */
+    CellularAutomatonPatternSource(int inWidth, uint64_t seed);
+
+    /*
+    * Function to generate the next pattern
+    * @param patternWords -> packed pattern (updated in place)
+    */
+    void next_pattern(std::vector<uint64_t>& patternWords) override;
+
+    /*
+    * Function to get the pattern width
+    * @return int -> number of bits per pattern
+    */
+    int get_width() override;
+
+    /*
+    * Function to get the generator state, for checkpointing
+    * @return vector of uint64_t -> state words
+    */
+    std::vector<uint64_t> get_state() override;
+
+    /*
+    * Function to restore a generator state returned by get_state
+    * @param stateWords -> state words
+    * @return bool -> if the state is valid for the generator
+    */
+    bool set_state(const std::vector<uint64_t>& stateWords) override;
+};
+
+#endif
@@ -200,6 +200,42 @@ int Circuit::get_num_outputs()
     return this->outputNodes.size();
 }
 
+/*
+* Function to get the names of all nodes in creation order
+* @return list of int -> node names
+*/
+std::list<int> Circuit::get_node_list()
+{
+    return this->node_list;
+}
+
+/*
+* Function to get the list of gates in netlist order
+* @return list of Gate* -> gates in circuit
+*/
+std::list<Gate*> Circuit::get_gate_list()
+{
+    return this->gateList;
+}
+
+/*
+* Function to get the primary input node names
+* @return vector of int -> input node names in vector order
+*/
+std::vector<int> Circuit::get_input_nodes()
+{
+    return this->inputNodes;
+}
+
+/*
+* Function to get the primary output node names
+* @return vector of int -> output node names in vector order
+*/
+std::vector<int> Circuit::get_output_nodes()
+{
+    return this->outputNodes;
+}
+
 /*
 * Function to get node object from name
 * @param nodeName -> name of node in netlist
@@ -81,6 +81,30 @@ public:
     */
     int get_num_outputs();
 
+    /*
+    * Function to get the names of all nodes in creation order
+    * @return list of int -> node names
+    */
+    std::list<int> get_node_list();
+
+    /*
+    * Function to get the list of gates in netlist order
+    * @return list of Gate* -> gates in circuit
+    */
+    std::list<Gate*> get_gate_list();
+
+    /*
+    * Function to get the primary input node names
+    * @return vector of int -> input node names in vector order
+    */
+    std::vector<int> get_input_nodes();
+
+    /*
+    * Function to get the primary output node names
+    * @return vector of int -> output node names in vector order
+    */
+    std::vector<int> get_output_nodes();
+
     /*
     * Function to get node object from name
     * @param nodeName -> name of node in netlist
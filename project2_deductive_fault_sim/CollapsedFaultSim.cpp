@@ -0,0 +1,94 @@
+#include "CollapsedFaultSim.h"
+
+/*
+* Constructor for the class
+* @param inEngine -> engine created on the representative faults, deleted with this object
+* @param inCollapser -> collapsed classes of the complete fault list
+*/
+CollapsedFaultSim::CollapsedFaultSim(FaultSimEngine* inEngine, const FaultCollapser& inCollapser) :
+    engine(inEngine), collapser(inCollapser) {}
+
+/*
+* Function to apply the test vector and grade the faults
+* @param testVector -> test vector applied
+* @return bool -> if test vector applied successfully
+*/
+bool CollapsedFaultSim::apply_test_vector(std::string testVector)
+{
+    if (this->engine->apply_test_vector(testVector) == false)
+    {
+        return false;
+    }
+    this->detectedFaults = this->collapser.expand_detected_faults(this->engine->get_list_detected_faults());
+    return true;
+}
+
+/*
+* Function to apply a block of test vectors in order
+* @param testVectors -> test vectors applied
+* @param detectedPerVector -> faults detected by each vector (updated in place)
+* @return bool -> if all test vectors applied successfully
+*/
+bool CollapsedFaultSim::apply_test_vectors(const std::vector<std::string>& testVectors,
+    std::vector<std::set<std::pair<int, int>>>& detectedPerVector)
+{
+    // keep the block grading of the wrapped engine
+    if (this->engine->apply_test_vectors(testVectors, detectedPerVector) == false)
+    {
+        return false;
+    }
+    for (std::set<std::pair<int, int>>& detectedFaults : detectedPerVector)
+    {
+        detectedFaults = this->collapser.expand_detected_faults(detectedFaults);
+    }
+    if (detectedPerVector.size() > 0)
+    {
+        this->detectedFaults = detectedPerVector.back();
+    }
+    return true;
+}
+
+/*
+* Function to get the output vector of the good circuit
+* @return string -> output vector for the last test vector
+*/
+std::string CollapsedFaultSim::get_output_vector_lin()
+{
+    return this->engine->get_output_vector_lin();
+}
+
+/*
+* Function to get the faults detected by the last test vector
+* @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+*/
+std::set<std::pair<int, int>> CollapsedFaultSim::get_list_detected_faults()
+{
+    return this->detectedFaults;
+}
+
+/*
+* Function to get total faults of the complete fault list
+* @return int -> total faults
+*/
+int CollapsedFaultSim::get_total_faults_count()
+{
+    return this->collapser.get_total_faults_count();
+}
+
+/*
+* Function to get the work counters of the wrapped engine, for instrumentation
+* @param stats -> counters and fault list sizes over the representative faults (updated in place)
+* @return bool -> if the wrapped engine keeps counters
+*/
+bool CollapsedFaultSim::get_simulation_stats(SimulationStats& stats)
+{
+    return this->engine->get_simulation_stats(stats);
+}
+
+/*
+* Destructor for the class
+*/
+CollapsedFaultSim::~CollapsedFaultSim()
+{
+    delete this->engine;
+}
@@ -0,0 +1,83 @@
+#ifndef __COLLAPSEDFAULTSIM_H__
+#define __COLLAPSEDFAULTSIM_H__
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include "FaultSimEngine.h"
+#include "FaultCollapser.h"
+
+/*
+* Fault simulation on a collapsed fault list
+* The wrapped engine only grades the representative faults, the detected
+* faults and the fault count are reported over the complete fault list
+*/
+class CollapsedFaultSim : public FaultSimEngine
+{
+    // Engine grading the representative faults (owned)
+    FaultSimEngine* engine;
+
+    // Collapsed classes of the complete fault list
+    FaultCollapser collapser;
+
+    // Detected faults of the last test vector over the complete fault list
+    std::set<std::pair<int, int>> detectedFaults;
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inEngine -> engine created on the representative faults, deleted with this object
+    * @param inCollapser -> collapsed classes of the complete fault list
+    */
+    CollapsedFaultSim(FaultSimEngine* inEngine, const FaultCollapser& inCollapser);
+
+    /*
+    * Function to apply the test vector and grade the faults
+    * @param testVector -> test vector applied
+    * @return bool -> if test vector applied successfully
+    */
+    bool apply_test_vector(std::string testVector) override;
+
+    /*
+    * Function to apply a block of test vectors in order
+    * @param testVectors -> test vectors applied
+    * @param detectedPerVector -> faults detected by each vector (updated in place)
+    * @return bool -> if all test vectors applied successfully
+    */
+    bool apply_test_vectors(const std::vector<std::string>& testVectors,
+        std::vector<std::set<std::pair<int, int>>>& detectedPerVector) override;
+
+    /*
+    * Function to get the output vector of the good circuit
+    * @return string -> output vector for the last test vector
+    */
+    std::string get_output_vector_lin() override;
+
+    /*
+    * Function to get the faults detected by the last test vector
+    * @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+    */
+    std::set<std::pair<int, int>> get_list_detected_faults() override;
+
+    /*
+    * Function to get total faults of the complete fault list
+    * @return int -> total faults
+    */
+    int get_total_faults_count() override;
+
+    /*
+    * Function to get the work counters of the wrapped engine, for instrumentation
+    * @param stats -> counters and fault list sizes over the representative faults (updated in place)
+    * @return bool -> if the wrapped engine keeps counters
+    */
+    bool get_simulation_stats(SimulationStats& stats) override;
+
+    /*
+    * Destructor for the class
+    */
+    ~CollapsedFaultSim();
+};
+
+#endif
@@ -0,0 +1,436 @@
+#include <algorithm>
+#include <iostream>
+#include "ConcurrentFaultSim.h"
+
+/*
+* Constructor for the class
+* All faults of the topology are graded until set_active_faults is called
+* @param inTopology -> levelized circuit to simulate
+*/
+ConcurrentFaultSim::ConcurrentFaultSim(LevelizedCircuit* inTopology) :
+    topology(inTopology), partitionSize(0), dropDetectedFaults(false), detectionLimit(1), isInitialized(false),
+    gatesEvaluated(0), listOperations(0)
+{
+    int numNodes = this->topology->get_num_nodes();
+    this->goodValues.assign(numNodes, -1);
+    this->faultRecords.assign(numNodes, std::vector<int>());
+    this->localFaults.assign(numNodes, std::vector<int>());
+    this->levelEvents.assign(this->topology->maxLevel + 1, std::vector<int>());
+    this->gateScheduled.assign(this->topology->gates.size(), false);
+    this->detectionCounts.assign(this->topology->get_num_faults(), 0);
+
+    // Grade complete fault universe by default
+    std::vector<int> allFaults;
+    for (int i = 0; i < this->topology->get_num_faults(); ++i)
+    {
+        allFaults.push_back(i);
+    }
+    this->set_active_faults(allFaults);
+}
+
+/*
+* Function to restrict the engine to a subset of the fault universe
+* @param faultIndices -> indices into the topology fault list
+*/
+void ConcurrentFaultSim::set_active_faults(const std::vector<int>& faultIndices)
+{
+    this->faultActive.assign(this->topology->get_num_faults(), false);
+    for (std::vector<int>& nodeFaults : this->localFaults)
+    {
+        nodeFaults.clear();
+    }
+    for (int faultIndex : faultIndices)
+    {
+        this->faultActive[faultIndex] = true;
+    }
+    // fault indices are numbered by node => local lists come out sorted
+    this->partitionSize = 0;
+    for (int i = 0; i < this->topology->get_num_faults(); ++i)
+    {
+        if (this->faultActive[i])
+        {
+            this->localFaults[this->topology->faultNode[i]].push_back(i);
+            ++this->partitionSize;
+        }
+    }
+    // records of the old partition are stale => re-evaluate everything
+    this->isInitialized = false;
+}
+
+/*
+* Function to enable dropping of detected faults
+* When enabled, a fault is reported only by the first N vectors detecting it
+* @param inDropDetectedFaults -> drop faults once detected
+*/
+void ConcurrentFaultSim::set_fault_dropping(bool inDropDetectedFaults)
+{
+    this->dropDetectedFaults = inDropDetectedFaults;
+}
+
+/*
+* Function to add the fanout gates of a node to the event buckets
+* @param nodeIndex -> node whose value or records changed
+*/
+void ConcurrentFaultSim::schedule_fanout(int nodeIndex)
+{
+    for (int gateIndex : this->topology->fanoutGates[nodeIndex])
+    {
+        if (this->gateScheduled[gateIndex] == false)
+        {
+            this->gateScheduled[gateIndex] = true;
+            this->levelEvents[this->topology->gates[gateIndex].level].push_back(gateIndex);
+        }
+    }
+}
+
+/*
+* Function to compute the records of a primary input
+* @param nodeIndex -> index of the input node
+* @param inValue -> good value applied on the input
+* @return bool -> if the input value or records changed
+*/
+bool ConcurrentFaultSim::evaluate_input_records(int nodeIndex, int inValue)
+{
+    std::vector<int> newRecords;
+    this->listOperations += this->localFaults[nodeIndex].size();
+    for (int faultIndex : this->localFaults[nodeIndex])
+    {
+        // only the fault opposite to the good value is sensitized
+        if (this->faultActive[faultIndex] &&
+            this->topology->faultList[faultIndex].second != inValue)
+        {
+            newRecords.push_back(faultIndex);
+        }
+    }
+    bool isChanged = (this->goodValues[nodeIndex] != inValue ||
+        this->faultRecords[nodeIndex] != newRecords);
+    this->goodValues[nodeIndex] = inValue;
+    this->faultRecords[nodeIndex].swap(newRecords);
+    return isChanged;
+}
+
+/*
+* Function to evaluate good and bad machines of a gate
+* The records of both inputs and the local faults of the output are merged in
+* fault order and only the bad machines differing from the good output are kept
+* @param gateIndex -> index of the gate in the levelized circuit
+* @return bool -> if the output value or records changed
+*/
+bool ConcurrentFaultSim::evaluate_gate_records(int gateIndex)
+{
+    const LevelizedGate& currGate = this->topology->gates[gateIndex];
+    int input1Value = this->goodValues[currGate.input1];
+    int input2Value = (currGate.input2 == -1) ? 0 : this->goodValues[currGate.input2];
+    int outputValue = evaluate_gate(currGate.logic, input1Value, input2Value);
+    ++this->gatesEvaluated;
+
+    static const std::vector<int> noRecords;
+    const std::vector<int>& input1Records = this->faultRecords[currGate.input1];
+    const std::vector<int>& input2Records =
+        (currGate.input2 == -1) ? noRecords : this->faultRecords[currGate.input2];
+    const std::vector<int>& outputFaults = this->localFaults[currGate.output];
+
+    std::vector<int> newRecords;
+    unsigned int index1 = 0, index2 = 0, indexOut = 0;
+    while (index1 < input1Records.size() || index2 < input2Records.size() ||
+        indexOut < outputFaults.size())
+    {
+        // pick the smallest fault index among the three sorted lists
+        int faultIndex = this->topology->get_num_faults();
+        if (index1 < input1Records.size())
+        {
+            faultIndex = std::min(faultIndex, input1Records[index1]);
+        }
+        if (index2 < input2Records.size())
+        {
+            faultIndex = std::min(faultIndex, input2Records[index2]);
+        }
+        if (indexOut < outputFaults.size())
+        {
+            faultIndex = std::min(faultIndex, outputFaults[indexOut]);
+        }
+        bool onInput1 = (index1 < input1Records.size() && input1Records[index1] == faultIndex);
+        bool onInput2 = (index2 < input2Records.size() && input2Records[index2] == faultIndex);
+        bool onOutput = (indexOut < outputFaults.size() && outputFaults[indexOut] == faultIndex);
+        index1 += onInput1;
+        index2 += onInput2;
+        indexOut += onOutput;
+        ++this->listOperations;
+
+        // records of dropped faults are removed as they are re-evaluated
+        if (this->faultActive[faultIndex] == false)
+        {
+            continue;
+        }
+
+        int badValue;
+        if (onOutput)
+        {
+            // fault at the gate output overrides the gate function
+            badValue = this->topology->faultList[faultIndex].second;
+        }
+        else
+        {
+            // bad machine sees inverted values on the inputs holding a record
+            badValue = evaluate_gate(currGate.logic, input1Value ^ onInput1, input2Value ^ onInput2);
+        }
+        if (badValue != outputValue)
+        {
+            newRecords.push_back(faultIndex);
+        }
+    }
+
+    bool isChanged = (this->goodValues[currGate.output] != outputValue ||
+        this->faultRecords[currGate.output] != newRecords);
+    this->goodValues[currGate.output] = outputValue;
+    this->faultRecords[currGate.output].swap(newRecords);
+    return isChanged;
+}
+
+/*
+* Function to apply the test vector and grade the faults
+* @param testVector -> test vector applied
+* @return bool -> if test vector applied successfully
+*/
+bool ConcurrentFaultSim::apply_test_vector(std::string testVector)
+{
+    std::vector<int> inputValues;
+    if (this->topology->parse_test_vector(testVector, inputValues) == false)
+    {
+        return false;
+    }
+    this->apply_input_values(inputValues);
+    return true;
+}
+
+/*
+* Function to apply the test vector given as primary input values
+* @param inputValues -> value per primary input
+*/
+void ConcurrentFaultSim::apply_input_values(const std::vector<int>& inputValues)
+{
+    // Update the primary inputs and schedule the gates they feed
+    for (unsigned int i = 0; i < this->topology->inputNodes.size(); ++i)
+    {
+        int nodeIndex = this->topology->inputNodes[i];
+        if (this->evaluate_input_records(nodeIndex, inputValues[i]) || this->isInitialized == false)
+        {
+            this->schedule_fanout(nodeIndex);
+        }
+    }
+    if (this->isInitialized == false)
+    {
+        // first vector => every gate has to be evaluated once
+        for (unsigned int i = 0; i < this->topology->gates.size(); ++i)
+        {
+            if (this->gateScheduled[i] == false)
+            {
+                this->gateScheduled[i] = true;
+                this->levelEvents[this->topology->gates[i].level].push_back(i);
+            }
+        }
+        this->isInitialized = true;
+    }
+
+    // Process the events in level order so that each gate is evaluated once
+    for (unsigned int level = 0; level < this->levelEvents.size(); ++level)
+    {
+        for (unsigned int i = 0; i < this->levelEvents[level].size(); ++i)
+        {
+            int gateIndex = this->levelEvents[level][i];
+            this->gateScheduled[gateIndex] = false;
+            if (this->evaluate_gate_records(gateIndex))
+            {
+                this->schedule_fanout(this->topology->gates[gateIndex].output);
+            }
+        }
+        this->levelEvents[level].clear();
+    }
+
+    // Collect the records reaching the primary outputs
+    this->detectedFaultIndices.clear();
+    for (int nodeIndex : this->topology->outputNodes)
+    {
+        for (int faultIndex : this->faultRecords[nodeIndex])
+        {
+            if (this->faultActive[faultIndex])
+            {
+                this->detectedFaultIndices.push_back(faultIndex);
+            }
+        }
+    }
+    std::sort(this->detectedFaultIndices.begin(), this->detectedFaultIndices.end());
+    this->detectedFaultIndices.erase(std::unique(this->detectedFaultIndices.begin(),
+        this->detectedFaultIndices.end()), this->detectedFaultIndices.end());
+    for (int faultIndex : this->detectedFaultIndices)
+    {
+        if (this->detectionCounts[faultIndex] < this->detectionLimit)
+        {
+            ++this->detectionCounts[faultIndex];
+        }
+        if (this->dropDetectedFaults && this->detectionCounts[faultIndex] == this->detectionLimit)
+        {
+            this->faultActive[faultIndex] = false;
+        }
+    }
+}
+
+/*
+* Function to get the output vector of the good circuit
+* @return string -> output vector for the last test vector
+*/
+std::string ConcurrentFaultSim::get_output_vector_lin()
+{
+    std::string outputVector = "";
+    for (int nodeIndex : this->topology->outputNodes)
+    {
+        outputVector += std::to_string(this->goodValues[nodeIndex]);
+    }
+    return outputVector;
+}
+
+/*
+* Function to get the faults detected by the last test vector
+* @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+*/
+std::set<std::pair<int, int>> ConcurrentFaultSim::get_list_detected_faults()
+{
+    std::set<std::pair<int, int>> finalFaultList;
+    for (int faultIndex : this->detectedFaultIndices)
+    {
+        finalFaultList.insert(this->topology->faultList[faultIndex]);
+    }
+    return finalFaultList;
+}
+
+/*
+* Function to get the fault indices detected by the last test vector
+* @return vector of int -> indices into the topology fault list
+*/
+std::vector<int> ConcurrentFaultSim::get_detected_fault_indices()
+{
+    return this->detectedFaultIndices;
+}
+
+/*
+* Function to get the fault indices observed at one primary output by the last test vector
+* @param outputPosition -> position of the output in the output vector
+* @return vector of int -> sorted indices into the topology fault list
+*/
+std::vector<int> ConcurrentFaultSim::get_output_fault_indices(int outputPosition)
+{
+    std::vector<int> outputFaults;
+    for (int faultIndex : this->faultRecords[this->topology->outputNodes[outputPosition]])
+    {
+        // faults dropped by this vector are still reported
+        if (this->faultActive[faultIndex] ||
+            std::binary_search(this->detectedFaultIndices.begin(), this->detectedFaultIndices.end(), faultIndex))
+        {
+            outputFaults.push_back(faultIndex);
+        }
+    }
+    return outputFaults;
+}
+
+/*
+* Function to get total faults graded by the engine
+* @return int -> total faults in the engine's partition
+*/
+int ConcurrentFaultSim::get_total_faults_count()
+{
+    return this->partitionSize;
+}
+
+/*
+* Function to keep detected faults graded until N vectors detected them
+* @param inDetectionLimit -> detections counted per fault before it is dropped (1 to 255)
+* @return bool -> if the limit is supported
+*/
+bool ConcurrentFaultSim::set_detection_limit(int inDetectionLimit)
+{
+    if (inDetectionLimit < 1 || inDetectionLimit > 255)
+    {
+        return false;
+    }
+    this->detectionLimit = inDetectionLimit;
+    return true;
+}
+
+/*
+* Function to get the number of faults detected at least n times
+* @return vector of int -> entry n - 1 holds the faults detected n or more times
+*/
+std::vector<int> ConcurrentFaultSim::get_n_detect_counts()
+{
+    // histogram of the counters, accumulated from the top level down
+    std::vector<int> nDetectCounts(this->detectionLimit + 1, 0);
+    for (uint8_t detectionCount : this->detectionCounts)
+    {
+        ++nDetectCounts[detectionCount];
+    }
+    for (int n = this->detectionLimit - 1; n >= 1; --n)
+    {
+        nDetectCounts[n] += nDetectCounts[n + 1];
+    }
+    return std::vector<int>(nDetectCounts.begin() + 1, nDetectCounts.end());
+}
+
+/*
+* Function to get the detections counted per fault, for checkpointing
+* @param detectionCounts -> detections per fault in topology order, 0 outside the partition (updated in place)
+* @return bool -> if the engine keeps detection state
+*/
+bool ConcurrentFaultSim::get_detection_state(std::vector<uint8_t>& detectionCounts)
+{
+    detectionCounts = this->detectionCounts;
+    return true;
+}
+
+/*
+* Function to restore the detections per fault before the first vector is applied
+* Only the faults of the partition take their counts
+* @param detectionCounts -> detections per fault returned by get_detection_state
+* @return bool -> if the counts match the fault list
+*/
+bool ConcurrentFaultSim::set_detection_state(const std::vector<uint8_t>& detectionCounts)
+{
+    if (detectionCounts.size() != this->detectionCounts.size())
+    {
+        return false;
+    }
+    for (unsigned int i = 0; i < detectionCounts.size(); ++i)
+    {
+        if (this->faultActive[i] == false)
+        {
+            continue;
+        }
+        this->detectionCounts[i] = std::min<int>(detectionCounts[i], this->detectionLimit);
+        if (this->dropDetectedFaults && this->detectionCounts[i] == this->detectionLimit)
+        {
+            this->faultActive[i] = false;
+        }
+    }
+    return true;
+}
+
+/*
+* Function to get the work counters of the engine, for instrumentation
+* The record lists of the nodes are the fault lists of this engine
+* @param stats -> counters and fault list sizes (updated in place)
+* @return bool -> always true
+*/
+bool ConcurrentFaultSim::get_simulation_stats(SimulationStats& stats)
+{
+    stats.gatesEvaluated = this->gatesEvaluated;
+    stats.listOperations = this->listOperations;
+    stats.numLists = this->faultRecords.size();
+    stats.listEntries = 0;
+    stats.maxListLength = 0;
+    for (const std::vector<int>& records : this->faultRecords)
+    {
+        stats.listEntries += records.size();
+        stats.maxListLength = std::max<int>(stats.maxListLength, records.size());
+    }
+    stats.activeFaults = std::count(this->faultActive.begin(), this->faultActive.end(), true);
+    return true;
+}
@@ -0,0 +1,190 @@
+#ifndef __CONCURRENTFAULTSIM_H__
+#define __CONCURRENTFAULTSIM_H__
+
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdint>
+
+#include "FaultSimEngine.h"
+#include "LevelizedCircuit.h"
+
+/*
+* Concurrent fault simulation engine
+* Every node keeps the fault-effect records of the bad machines whose value
+* differs from the good machine (sorted fault indices, the bad value is the
+* inverse of the good value). State is carried from one test vector to the
+* next and only gates whose input good value or records changed are
+* re-evaluated, in level order.
+*/
+class ConcurrentFaultSim : public FaultSimEngine
+{
+    // Read-only topology shared with other engines
+    LevelizedCircuit* topology;
+
+    // Good machine value per node (-1 before the first vector)
+    std::vector<int> goodValues;
+
+    // Fault-effect records per node, sorted fault indices
+    std::vector<std::vector<int>> faultRecords;
+
+    // Faults located on each node, sorted fault indices
+    std::vector<std::vector<int>> localFaults;
+
+    // Whether the fault is graded by this engine (in partition and not dropped)
+    std::vector<bool> faultActive;
+
+    // Number of faults in this engine's partition
+    int partitionSize;
+
+    // Drop faults from the active set once detected
+    bool dropDetectedFaults;
+
+    // Detections counted per fault before it is dropped (N of N-detect)
+    int detectionLimit;
+
+    // Detections per fault, saturating at the detection limit
+    std::vector<uint8_t> detectionCounts;
+
+    // Gates scheduled for evaluation, bucketed by level
+    std::vector<std::vector<int>> levelEvents;
+
+    // Whether the gate is already in the event buckets
+    std::vector<bool> gateScheduled;
+
+    // Whether a test vector has been applied yet
+    bool isInitialized;
+
+    // Fault indices detected by the last test vector
+    std::vector<int> detectedFaultIndices;
+
+    // Gate evaluations since construction
+    long long gatesEvaluated;
+
+    // Fault records processed while merging record lists since construction
+    long long listOperations;
+
+    /*
+    * Function to add the fanout gates of a node to the event buckets
+    * @param nodeIndex -> node whose value or records changed
+    */
+    void schedule_fanout(int nodeIndex);
+
+    /*
+    * Function to evaluate good and bad machines of a gate
+    * @param gateIndex -> index of the gate in the levelized circuit
+    * @return bool -> if the output value or records changed
+    */
+    bool evaluate_gate_records(int gateIndex);
+
+    /*
+    * Function to compute the records of a primary input
+    * @param nodeIndex -> index of the input node
+    * @param inValue -> good value applied on the input
+    * @return bool -> if the input value or records changed
+    */
+    bool evaluate_input_records(int nodeIndex, int inValue);
+
+public:
+
+    /*
+    * Constructor for the class
+    * All faults of the topology are graded until set_active_faults is called
+    * @param inTopology -> levelized circuit to simulate
+    */
+    ConcurrentFaultSim(LevelizedCircuit* inTopology);
+
+    /*
+    * Function to restrict the engine to a subset of the fault universe
+    * @param faultIndices -> indices into the topology fault list
+    */
+    void set_active_faults(const std::vector<int>& faultIndices);
+
+    /*
+    * Function to enable dropping of detected faults
+    * When enabled, a fault is reported only by the first N vectors detecting it
+    * @param inDropDetectedFaults -> drop faults once detected
+    */
+    void set_fault_dropping(bool inDropDetectedFaults);
+
+    /*
+    * Function to apply the test vector and grade the faults
+    * @param testVector -> test vector applied
+    * @return bool -> if test vector applied successfully
+    */
+    bool apply_test_vector(std::string testVector) override;
+
+    /*
+    * Function to apply the test vector given as primary input values
+    * @param inputValues -> value per primary input
+    */
+    void apply_input_values(const std::vector<int>& inputValues);
+
+    /*
+    * Function to get the output vector of the good circuit
+    * @return string -> output vector for the last test vector
+    */
+    std::string get_output_vector_lin() override;
+
+    /*
+    * Function to get the faults detected by the last test vector
+    * @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+    */
+    std::set<std::pair<int, int>> get_list_detected_faults() override;
+
+    /*
+    * Function to get the fault indices detected by the last test vector
+    * @return vector of int -> indices into the topology fault list
+    */
+    std::vector<int> get_detected_fault_indices();
+
+    /*
+    * Function to get the fault indices observed at one primary output by the last test vector
+    * @param outputPosition -> position of the output in the output vector
+    * @return vector of int -> sorted indices into the topology fault list
+    */
+    std::vector<int> get_output_fault_indices(int outputPosition);
+
+    /*
+    * Function to get total faults graded by the engine
+    * @return int -> total faults in the engine's partition
+    */
+    int get_total_faults_count() override;
+
+    /*
+    * Function to keep detected faults graded until N vectors detected them
+    * @param inDetectionLimit -> detections counted per fault before it is dropped (1 to 255)
+    * @return bool -> if the limit is supported
+    */
+    bool set_detection_limit(int inDetectionLimit) override;
+
+    /*
+    * Function to get the number of faults detected at least n times
+    * @return vector of int -> entry n - 1 holds the faults detected n or more times
+    */
+    std::vector<int> get_n_detect_counts() override;
+
+    /*
+    * Function to get the detections counted per fault, for checkpointing
+    * @param detectionCounts -> detections per fault in topology order (updated in place)
+    * @return bool -> if the engine keeps detection state
+    */
+    bool get_detection_state(std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to restore the detections per fault before the first vector is applied
+    * @param detectionCounts -> detections per fault returned by get_detection_state
+    * @return bool -> if the counts match the fault list
+    */
+    bool set_detection_state(const std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to get the work counters of the engine, for instrumentation
+    * The record lists of the nodes are the fault lists of this engine
+    * @param stats -> counters and fault list sizes (updated in place)
+    * @return bool -> always true
+    */
+    bool get_simulation_stats(SimulationStats& stats) override;
+};
+
+#endif
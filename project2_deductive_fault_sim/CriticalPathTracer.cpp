@@ -0,0 +1,348 @@
+#include <algorithm>
+#include "CriticalPathTracer.h"
+
+/*
+* Function to find the sensitive inputs of a gate
+* An input is sensitive if complementing it alone complements the output,
+* i.e. the other input is not at the controlling value
+* @param currGate -> gate to check
+* @param values -> value per node
+* @param input1Sensitive -> if input1 is sensitive (updated in place)
+* @param input2Sensitive -> if input2 is sensitive (updated in place)
+*/
+static void get_sensitive_inputs(const LevelizedGate& currGate, const std::vector<int>& values,
+    bool& input1Sensitive, bool& input2Sensitive)
+{
+    int controllingValue = Gate::get_controlling_value(currGate.logic);
+    if (currGate.input2 == -1)
+    {
+        // inverter or buffer
+        input1Sensitive = true;
+        input2Sensitive = false;
+    }
+    else if (currGate.input1 == currGate.input2)
+    {
+        // both inputs flip together => acts as buffer/inverter, xor/xnor are constant
+        input1Sensitive = (controllingValue != -1);
+        input2Sensitive = false;
+    }
+    else if (controllingValue == -1)
+    {
+        // xor/xnor propagate any input change
+        input1Sensitive = true;
+        input2Sensitive = true;
+    }
+    else
+    {
+        input1Sensitive = (values[currGate.input2] != controllingValue);
+        input2Sensitive = (values[currGate.input1] != controllingValue);
+    }
+}
+
+/*
+* Constructor for the class
+* @param inTopology -> levelized circuit to simulate
+*/
+CriticalPathTracer::CriticalPathTracer(LevelizedCircuit* inTopology) :
+    topology(inTopology), dropDetectedFaults(false), gatesEvaluated(0)
+{
+    int numNodes = this->topology->get_num_nodes();
+    this->goodValues.assign(numNodes, -1);
+    this->stemValues.assign(numNodes, -1);
+    this->localFaults.assign(numNodes, std::vector<int>());
+    this->regionFaultsLeft.assign(numNodes, 0);
+    this->faultActive.assign(this->topology->get_num_faults(), true);
+    this->levelEvents.assign(this->topology->maxLevel + 1, std::vector<int>());
+    this->gateScheduled.assign(this->topology->gates.size(), false);
+
+    // Find the region of every node walking from the outputs towards the inputs
+    std::vector<int> nodesByLevel;
+    for (int i = 0; i < numNodes; ++i)
+    {
+        nodesByLevel.push_back(i);
+    }
+    std::stable_sort(nodesByLevel.begin(), nodesByLevel.end(),
+        [this](int node1, int node2) { return this->topology->nodeLevel[node1] > this->topology->nodeLevel[node2]; });
+    this->regionRoot.assign(numNodes, -1);
+    for (int nodeIndex : nodesByLevel)
+    {
+        if (this->is_region_root(nodeIndex))
+        {
+            this->regionRoot[nodeIndex] = nodeIndex;
+            this->regionRoots.push_back(nodeIndex);
+        }
+        else
+        {
+            int fanoutGate = this->topology->fanoutGates[nodeIndex].front();
+            this->regionRoot[nodeIndex] = this->regionRoot[this->topology->gates[fanoutGate].output];
+        }
+    }
+    std::reverse(this->regionRoots.begin(), this->regionRoots.end());
+
+    for (int i = 0; i < this->topology->get_num_faults(); ++i)
+    {
+        int nodeIndex = this->topology->faultNode[i];
+        this->localFaults[nodeIndex].push_back(i);
+        ++this->regionFaultsLeft[this->regionRoot[nodeIndex]];
+    }
+}
+
+/*
+* Function to enable dropping of detected faults
+* Regions without undetected faults are skipped
+* @param inDropDetectedFaults -> drop faults once detected
+*/
+void CriticalPathTracer::set_fault_dropping(bool inDropDetectedFaults)
+{
+    this->dropDetectedFaults = inDropDetectedFaults;
+}
+
+/*
+* Function to check if a node is the root of a fanout free region
+* @param nodeIndex -> node to check
+* @return bool -> if node is a primary output or does not have exactly one fanout
+*/
+bool CriticalPathTracer::is_region_root(int nodeIndex)
+{
+    return this->topology->isOutput[nodeIndex] ||
+        this->topology->fanoutGates[nodeIndex].size() != 1;
+}
+
+/*
+* Function to simulate the complemented stem over its fanout cone
+* @param nodeIndex -> stem node
+* @return bool -> if any primary output changes
+*/
+bool CriticalPathTracer::analyze_stem(int nodeIndex)
+{
+    std::vector<int> changedNodes(1, nodeIndex);
+    this->stemValues[nodeIndex] = !this->goodValues[nodeIndex];
+
+    bool reachesOutput = false;
+    std::vector<int> fanoutNodes(1, nodeIndex);
+    for (int level = this->topology->nodeLevel[nodeIndex]; level <= this->topology->maxLevel; ++level)
+    {
+        // schedule the fanout of the nodes changed on the previous level
+        for (int changedNode : fanoutNodes)
+        {
+            for (int gateIndex : this->topology->fanoutGates[changedNode])
+            {
+                if (this->gateScheduled[gateIndex] == false)
+                {
+                    this->gateScheduled[gateIndex] = true;
+                    this->levelEvents[this->topology->gates[gateIndex].level].push_back(gateIndex);
+                }
+            }
+        }
+        fanoutNodes.clear();
+        for (int gateIndex : this->levelEvents[level])
+        {
+            this->gateScheduled[gateIndex] = false;
+            if (reachesOutput)
+            {
+                continue;
+            }
+            ++this->gatesEvaluated;
+            const LevelizedGate& currGate = this->topology->gates[gateIndex];
+            int input2Value = (currGate.input2 == -1) ? 0 : this->stemValues[currGate.input2];
+            int outputValue = evaluate_gate(currGate.logic, this->stemValues[currGate.input1], input2Value);
+            if (outputValue != this->stemValues[currGate.output])
+            {
+                this->stemValues[currGate.output] = outputValue;
+                changedNodes.push_back(currGate.output);
+                fanoutNodes.push_back(currGate.output);
+                reachesOutput = this->topology->isOutput[currGate.output];
+            }
+        }
+        this->levelEvents[level].clear();
+    }
+
+    // Restore the good values for the next stem
+    for (int changedNode : changedNodes)
+    {
+        this->stemValues[changedNode] = this->goodValues[changedNode];
+    }
+    return reachesOutput;
+}
+
+/*
+* Function to mark the critical nodes of a region from its critical root
+* @param rootIndex -> critical root of the region
+*/
+void CriticalPathTracer::trace_region(int rootIndex)
+{
+    std::vector<int> nodeStack(1, rootIndex);
+    while (nodeStack.size() > 0)
+    {
+        int nodeIndex = nodeStack.back();
+        nodeStack.pop_back();
+
+        // critical node => the fault opposite to its value is detected
+        for (int faultIndex : this->localFaults[nodeIndex])
+        {
+            if (this->faultActive[faultIndex] &&
+                this->topology->faultList[faultIndex].second != this->goodValues[nodeIndex])
+            {
+                this->detectedFaultIndices.push_back(faultIndex);
+            }
+        }
+
+        int gateIndex = this->topology->driverGate[nodeIndex];
+        if (gateIndex == -1)
+        {
+            continue;
+        }
+        const LevelizedGate& currGate = this->topology->gates[gateIndex];
+        bool input1Sensitive, input2Sensitive;
+        get_sensitive_inputs(currGate, this->goodValues, input1Sensitive, input2Sensitive);
+        // inputs that are region roots are resolved by their own stem analysis
+        if (input1Sensitive && this->is_region_root(currGate.input1) == false)
+        {
+            nodeStack.push_back(currGate.input1);
+        }
+        if (input2Sensitive && this->is_region_root(currGate.input2) == false)
+        {
+            nodeStack.push_back(currGate.input2);
+        }
+    }
+}
+
+/*
+* Function to apply the test vector and grade the faults
+* @param testVector -> test vector applied
+* @return bool -> if test vector applied successfully
+*/
+bool CriticalPathTracer::apply_test_vector(std::string testVector)
+{
+    std::vector<int> inputValues;
+    if (this->topology->parse_test_vector(testVector, inputValues) == false)
+    {
+        return false;
+    }
+
+    // Good machine simulation in level order
+    for (unsigned int i = 0; i < this->topology->inputNodes.size(); ++i)
+    {
+        this->goodValues[this->topology->inputNodes[i]] = inputValues[i];
+    }
+    for (const LevelizedGate& currGate : this->topology->gates)
+    {
+        int input2Value = (currGate.input2 == -1) ? 0 : this->goodValues[currGate.input2];
+        this->goodValues[currGate.output] = evaluate_gate(currGate.logic,
+            this->goodValues[currGate.input1], input2Value);
+    }
+    this->gatesEvaluated += this->topology->gates.size();
+    this->stemValues = this->goodValues;
+
+    // Trace every region that still has faults to grade
+    this->detectedFaultIndices.clear();
+    for (int rootIndex : this->regionRoots)
+    {
+        if (this->regionFaultsLeft[rootIndex] == 0)
+        {
+            continue;
+        }
+        if (this->topology->isOutput[rootIndex] || this->analyze_stem(rootIndex))
+        {
+            this->trace_region(rootIndex);
+        }
+    }
+
+    if (this->dropDetectedFaults)
+    {
+        for (int faultIndex : this->detectedFaultIndices)
+        {
+            this->faultActive[faultIndex] = false;
+            --this->regionFaultsLeft[this->regionRoot[this->topology->faultNode[faultIndex]]];
+        }
+    }
+    return true;
+}
+
+/*
+* Function to get the output vector of the good circuit
+* @return string -> output vector for the last test vector
+*/
+std::string CriticalPathTracer::get_output_vector_lin()
+{
+    std::string outputVector = "";
+    for (int nodeIndex : this->topology->outputNodes)
+    {
+        outputVector += std::to_string(this->goodValues[nodeIndex]);
+    }
+    return outputVector;
+}
+
+/*
+* Function to get the faults detected by the last test vector
+* @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+*/
+std::set<std::pair<int, int>> CriticalPathTracer::get_list_detected_faults()
+{
+    std::set<std::pair<int, int>> finalFaultList;
+    for (int faultIndex : this->detectedFaultIndices)
+    {
+        finalFaultList.insert(this->topology->faultList[faultIndex]);
+    }
+    return finalFaultList;
+}
+
+/*
+* Function to get total faults graded by the engine
+* @return int -> total faults
+*/
+int CriticalPathTracer::get_total_faults_count()
+{
+    return this->topology->get_num_faults();
+}
+
+/*
+* Function to get the dropped faults, for checkpointing
+* @param detectionCounts -> 1 for a dropped fault, 0 otherwise, in topology order (updated in place)
+* @return bool -> if the engine keeps detection state
+*/
+bool CriticalPathTracer::get_detection_state(std::vector<uint8_t>& detectionCounts)
+{
+    detectionCounts.assign(this->faultActive.size(), 0);
+    for (unsigned int i = 0; i < this->faultActive.size(); ++i)
+    {
+        detectionCounts[i] = (this->faultActive[i] == false);
+    }
+    return true;
+}
+
+/*
+* Function to drop the faults detected before a resume, before the first vector is applied
+* @param detectionCounts -> detections per fault returned by get_detection_state
+* @return bool -> if the counts match the fault list
+*/
+bool CriticalPathTracer::set_detection_state(const std::vector<uint8_t>& detectionCounts)
+{
+    if (detectionCounts.size() != this->faultActive.size())
+    {
+        return false;
+    }
+    for (unsigned int i = 0; i < detectionCounts.size(); ++i)
+    {
+        if (this->dropDetectedFaults && detectionCounts[i] > 0 && this->faultActive[i])
+        {
+            this->faultActive[i] = false;
+            --this->regionFaultsLeft[this->regionRoot[this->topology->faultNode[i]]];
+        }
+    }
+    return true;
+}
+
+/*
+* Function to get the work counters of the engine, for instrumentation
+* Critical paths are traced without fault lists
+* @param stats -> counters (updated in place)
+* @return bool -> always true
+*/
+bool CriticalPathTracer::get_simulation_stats(SimulationStats& stats)
+{
+    stats = SimulationStats();
+    stats.gatesEvaluated = this->gatesEvaluated;
+    stats.activeFaults = std::count(this->faultActive.begin(), this->faultActive.end(), true);
+    return true;
+}
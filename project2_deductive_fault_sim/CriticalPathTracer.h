@@ -0,0 +1,144 @@
+#ifndef __CRITICALPATHTRACER_H__
+#define __CRITICALPATHTRACER_H__
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include "FaultSimEngine.h"
+#include "LevelizedCircuit.h"
+
+/*
+* Critical path tracing fault simulation engine
+* A node is critical when complementing its good value changes a primary
+* output, i.e. the fault opposite to its value is detected. After good
+* machine simulation the fanout free regions are traced backward from their
+* root through the sensitive gate inputs. Region roots that are fanout stems
+* are resolved by explicitly simulating the complemented stem over its fanout
+* cone. No fault lists are built.
+*/
+class CriticalPathTracer : public FaultSimEngine
+{
+    // Read-only topology shared with other engines
+    LevelizedCircuit* topology;
+
+    // Good machine value per node
+    std::vector<int> goodValues;
+
+    // Value per node with a stem complemented (equal to good outside stem analysis)
+    std::vector<int> stemValues;
+
+    // Node index to root node of its fanout free region
+    std::vector<int> regionRoot;
+
+    // Region roots in level order
+    std::vector<int> regionRoots;
+
+    // Faults located on each node
+    std::vector<std::vector<int>> localFaults;
+
+    // Node index of a root to number of undetected faults in its region
+    std::vector<int> regionFaultsLeft;
+
+    // Whether the fault is still graded (not dropped)
+    std::vector<bool> faultActive;
+
+    // Drop faults from the active set once detected
+    bool dropDetectedFaults;
+
+    // Gates scheduled for stem analysis, bucketed by level
+    std::vector<std::vector<int>> levelEvents;
+
+    // Whether the gate is already in the event buckets
+    std::vector<bool> gateScheduled;
+
+    // Fault indices detected by the last test vector
+    std::vector<int> detectedFaultIndices;
+
+    // Gate evaluations of the good circuit and of the stem analyses since construction
+    long long gatesEvaluated;
+
+    /*
+    * Function to check if a node is the root of a fanout free region
+    * @param nodeIndex -> node to check
+    * @return bool -> if node is a primary output or does not have exactly one fanout
+    */
+    bool is_region_root(int nodeIndex);
+
+    /*
+    * Function to simulate the complemented stem over its fanout cone
+    * @param nodeIndex -> stem node
+    * @return bool -> if any primary output changes
+    */
+    bool analyze_stem(int nodeIndex);
+
+    /*
+    * Function to mark the critical nodes of a region from its critical root
+    * @param rootIndex -> critical root of the region
+    */
+    void trace_region(int rootIndex);
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inTopology -> levelized circuit to simulate
+    */
+    CriticalPathTracer(LevelizedCircuit* inTopology);
+
+    /*
+    * Function to enable dropping of detected faults
+    * Regions without undetected faults are skipped
+    * @param inDropDetectedFaults -> drop faults once detected
+    */
+    void set_fault_dropping(bool inDropDetectedFaults);
+
+    /*
+    * Function to apply the test vector and grade the faults
+    * @param testVector -> test vector applied
+    * @return bool -> if test vector applied successfully
+    */
+    bool apply_test_vector(std::string testVector) override;
+
+    /*
+    * Function to get the output vector of the good circuit
+    * @return string -> output vector for the last test vector
+    */
+    std::string get_output_vector_lin() override;
+
+    /*
+    * Function to get the faults detected by the last test vector
+    * @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+    */
+    std::set<std::pair<int, int>> get_list_detected_faults() override;
+
+    /*
+    * Function to get total faults graded by the engine
+    * @return int -> total faults
+    */
+    int get_total_faults_count() override;
+
+    /*
+    * Function to get the dropped faults, for checkpointing
+    * @param detectionCounts -> 1 for a dropped fault, 0 otherwise, in topology order (updated in place)
+    * @return bool -> if the engine keeps detection state
+    */
+    bool get_detection_state(std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to drop the faults detected before a resume, before the first vector is applied
+    * @param detectionCounts -> detections per fault returned by get_detection_state
+    * @return bool -> if the counts match the fault list
+    */
+    bool set_detection_state(const std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to get the work counters of the engine, for instrumentation
+    * Critical paths are traced without fault lists
+    * @param stats -> counters (updated in place)
+    * @return bool -> always true
+    */
+    bool get_simulation_stats(SimulationStats& stats) override;
+};
+
+#endif
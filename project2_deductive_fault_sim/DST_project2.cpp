@@ -9,6 +9,30 @@ Description:
     d.	-l: To run the circuit with all faults activated (cannot be used with -a)
     e.	-p <path to fault list>: Path to input fault list (cannot be used with -a and -l)
     f.	-t <test vector to apply>: Test vector to apply (cannot be used -a)
+    g.	-e <engine>: Fault simulation engine, deductive (default), concurrent, cpt (critical path tracing) or ppsfp (64 patterns per pass)
+    h.	-j <threads>: Partition the faults across worker threads of the concurrent engine (0 => all cores)
+    i.	-c <eq|dom>: Collapse the faults (equivalence, or equivalence and dominance) before simulation (with dom the fault coverage is a lower bound)
+    j.	-s <path to test set>: File with one test vector per line, graded instead of -t
+    k.	-w <path to dictionary>: Write the binary fault dictionary of the test set (must be used with -s)
+    l.	-o: Store the detected faults per primary output in the dictionary (must be used with -w)
+    m.	-g <path to failing log>: Diagnose a failing device from its log (must be used with -r)
+    n.	-r <path to dictionary>: Fault dictionary used for diagnosis
+    o.	-k <candidates>: Number of diagnosis candidates to print (default 10)
+    p.	-m <source>: Pattern source for random pattern grading, random (default), lfsr or ca (cellular automaton)
+    q.	-n <vectors>: Maximum number of random patterns graded per netlist (default 101)
+    r.	-v <coverage>: Stop random pattern grading once the fault coverage % is reached
+    s.	-u <vectors>: Stop random pattern grading after this many vectors without a new detection
+    t.	-x <path to compacted test set>: Compact the test set by reverse order fault simulation (must be used with -s)
+    u.	-i <iterations>: Further compaction passes over random reorderings of the compacted set (default 0)
+    v.	-q <N>: N-detect grading, faults are dropped once detected by N vectors (concurrent and ppsfp engines, 1 to 255)
+    w.	-z <faults>: Grade a uniform random sample of the faults and estimate the coverage (must be used with -s or -m/-n)
+    x.	-y <margin %>: Pick the sample size for the given 95% confidence margin instead of -z
+    y.	-b <path to vector pairs>: Grade transition faults on a file of "<initial vector> <launch vector>" lines (-p fault type 0 = slow-to-rise, 1 = slow-to-fall)
+    z.	-h <path to bridging fault list>: Grade "<net> <net> <type>" bridging faults instead of stuck-at faults (type 0 = wired-AND, 1 = wired-OR, 2 = first net dominates, must be used with -s or -t)
+    A.	-C <path to checkpoint>: Checkpoint random pattern grading every few seconds (with -a, one checkpoint per netlist named <path>.<netlist file>)
+    B.	-R: Resume random pattern grading from the checkpoint given with -C (started afresh if the checkpoint does not exist)
+    C.	-P <processes>: Partition the faults across forked worker processes of the concurrent engine, results merged through shared memory (0 => all cores, cannot be used with -j)
+    D.	-S <path to stats file>: Write per vector instrumentation of random pattern grading or a test set run, as JSON if the path ends with .json, CSV otherwise (vectors are then graded one per engine call)
     Outputs:
     a.	For all netlists run for coverage stats:
         i.	test_data.csv in the run directory contains test vectors run and the fault coverage percentage for each circuit.
@@ -17,139 +41,1361 @@ Description:
         i.	Output vector is printed.
         ii.	List of detectable faults at the output are printed.
         iii.Fault coverage statistics of the run are printed
+    c.	For random pattern grading on a single netlist (-m or -n without -t and -s):
+        i.	Fault coverage after each test vector is printed.
+        ii.	With -R, the coverage up to the checkpoint is printed again before grading continues (also for -a).
+    d.	For run on a test set:
+        i.	Fault coverage after each test vector is printed.
+        ii.	The binary fault dictionary is written if requested.
+        iii.With -x, the size after each compaction pass is printed and the compacted set is written.
+        iv.	With -q, the coverage at each detection level up to N is printed (also for random pattern grading).
+        v.	With -z or -y, the estimated coverage and its 95% confidence interval are printed (also for random pattern grading).
+        vi.	With -b, the transition fault coverage after each vector pair is printed (pattern parallel engine).
+        vii.With -h, the bridging fault coverage after each test vector is printed.
+        viii.With -S, the wall time, gates evaluated, fault list operations, average and maximum fault list length and active faults of each vector are written (also for random pattern grading and -a).
+    e.	For diagnosis:
+        i.	Candidate faults ranked by match score are printed.
 
 */
 
 #include <iostream>
 #include <fstream>
-#include <random>
 #include <set>
+#include <sstream>
 #include <vector>
+#include <unordered_set>
+#include <random>
+#include <algorithm>
+#include <list>
+#include <cmath>
+#include <chrono>
 #include "Node.h"
 #include "Gate.h"
 #include "Circuit.h"
 #include "HelperFuncs.h"
+#include "LevelizedCircuit.h"
+#include "FaultSimEngine.h"
+#include "DeductiveFaultSim.h"
+#include "ConcurrentFaultSim.h"
+#include "ParallelFaultSim.h"
+#include "ProcessFaultSim.h"
+#include "CriticalPathTracer.h"
+#include "FaultCollapser.h"
+#include "CollapsedFaultSim.h"
+#include "PatternParallelFaultSim.h"
+#include "FaultDictionary.h"
+#include "FaultDiagnoser.h"
+#include "PatternSource.h"
+#include "RandomPatternSource.h"
+#include "LfsrPatternSource.h"
+#include "CellularAutomatonPatternSource.h"
+#include "BridgingFaultSim.h"
+#include "GradingCheckpoint.h"
+#include "SimulationStatsWriter.h"
+
+// Number of test vectors graded per block before the results are merged
+const int vectorBlockSize = 64;
+
+// Number of test vectors encoded per fault dictionary block
+const int dictionaryBlockSize = 256;
+
+// Seed of the pattern sources
+const uint64_t patternSeed = 1;
+
+// Duplicate patterns drawn in a row before a source is considered exhausted
+const int maxDuplicatePatterns = 1000;
+
+// Seed of the test set reorderings during compaction
+const unsigned int compactionSeed = 1;
+
+// Seed of the fault sampling
+const uint64_t samplingSeed = 1;
+
+// Normal quantile of the 95% confidence interval
+const double confidenceQuantile = 1.96;
+
+// Seconds between checkpoints of a pattern grading run
+const int checkpointInterval = 5;
+
+/*
+* Structure to hold the fault simulation options from the command line
+*/
+struct SimOptions
+{
+    // Fault simulation engine (deductive, concurrent, cpt or ppsfp)
+    std::string engineName;
+    // Worker threads for the concurrent engine
+    int numThreads;
+    // Worker processes for the concurrent engine
+    int numProcesses;
+    // Fault collapsing mode (empty => none, eq or dom)
+    std::string collapseMode;
+    // Fault dictionary to write (empty => none)
+    std::string dictionaryPath;
+    // Store the dictionary fault lists per primary output
+    bool dictionaryPerOutput;
+    // Pattern source for random pattern grading (random, lfsr or ca)
+    std::string patternSource;
+    // Maximum number of random patterns graded per netlist
+    int maxVectors;
+    // Fault coverage % to stop at (<= 0 => disabled)
+    float targetCoverage;
+    // Vectors without a new detection to stop at (0 => disabled)
+    int plateauVectors;
+    // Detections counted per fault before it is dropped (N of N-detect)
+    int detectionLimit;
+    // Number of faults the graded faults were sampled from (0 => no sampling)
+    long long sampledFrom;
+    // Checkpoint of random pattern grading (empty => none)
+    std::string checkpointPath;
+    // Continue random pattern grading from the checkpoint
+    bool resumeRun;
+    // Per vector instrumentation output (NULL => none)
+    SimulationStatsWriter* statsWriter;
+};
+
+
+/*
+* Function to check if command line option provided
+*/
+bool checkCommandLineOption(int argc, char** argv, std::string inputToCheck)
+{
+    return std::find(argv, argv + argc, inputToCheck) != (argv + argc);
+}
+
+/*
+* Function to get command line option from identifier
+*/
+std::string getCommandLineOption(int argc, char** argv, std::string inputToCheck)
+{
+    char** itr = std::find(argv, argv + argc, inputToCheck);
+    if (itr != argv + argc &&
+        // check if the actual input is also not empty
+        itr + 1 != argv + argc)
+    {
+        // return a string form of the iterator
+        ++itr;
+        std::string returnStr = *itr;
+        return returnStr;
+    }
+    return "";
+}
+
+/*
+* Function to create the fault simulation engine selected on the command line
+* @param engineName -> deductive, concurrent, cpt or ppsfp
+* @param netlistPath -> location of the netlist
+* @param activateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+* @param faultList -> faults to apply if not activated on all nodes
+* @param topology -> levelized circuit used by the index based engines
+* @param dropDetectedFaults -> engine may drop faults once detected (only new detections reported)
+* @param numThreads -> worker threads for the concurrent engine (1 => single threaded)
+* @param numProcesses -> worker processes for the concurrent engine (1 => single process)
+* @return FaultSimEngine* -> engine object, NULL if engine name unknown
+*/
+FaultSimEngine* create_engine(std::string engineName, std::string netlistPath,
+    bool activateFaultsOnAllNodes, std::vector<std::pair<int, int>> faultList,
+    LevelizedCircuit* topology, bool dropDetectedFaults, int numThreads, int numProcesses)
+{
+    if (engineName.compare("deductive") == 0)
+    {
+        return new DeductiveFaultSim(netlistPath, activateFaultsOnAllNodes, faultList);
+    }
+    else if (engineName.compare("concurrent") == 0 && numProcesses != 1)
+    {
+        return new ProcessFaultSim(topology, numProcesses, dropDetectedFaults);
+    }
+    else if (engineName.compare("concurrent") == 0 && numThreads != 1)
+    {
+        return new ParallelFaultSim(topology, numThreads, dropDetectedFaults);
+    }
+    else if (engineName.compare("concurrent") == 0)
+    {
+        ConcurrentFaultSim* concurrentSim = new ConcurrentFaultSim(topology);
+        concurrentSim->set_fault_dropping(dropDetectedFaults);
+        return concurrentSim;
+    }
+    else if (engineName.compare("cpt") == 0)
+    {
+        CriticalPathTracer* pathTracer = new CriticalPathTracer(topology);
+        pathTracer->set_fault_dropping(dropDetectedFaults);
+        return pathTracer;
+    }
+    else if (engineName.compare("ppsfp") == 0)
+    {
+        PatternParallelFaultSim* patternSim = new PatternParallelFaultSim(topology);
+        patternSim->set_fault_dropping(dropDetectedFaults);
+        return patternSim;
+    }
+    std::cerr << "Unknown fault simulation engine: " << engineName << "\n";
+    return NULL;
+}
+
+/*
+* Function to get the name of the engine selected on the command line for instrumentation records
+* @param options -> fault simulation options
+* @return string -> engine name with its thread or process count and collapsing mode
+*/
+std::string get_engine_label(SimOptions& options)
+{
+    std::string engineLabel = options.engineName;
+    if (options.numThreads != 1)
+    {
+        engineLabel += " -j " + std::to_string(options.numThreads);
+    }
+    if (options.numProcesses != 1)
+    {
+        engineLabel += " -P " + std::to_string(options.numProcesses);
+    }
+    if (options.collapseMode.empty() == false)
+    {
+        engineLabel += " -c " + options.collapseMode;
+    }
+    return engineLabel;
+}
+
+/*
+* Function to read the netlist and build its levelized view
+* @param netlistPath -> location of the netlist
+* @param activateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+* @param faultList -> faults to apply if not activated on all nodes
+* @param topology -> levelized circuit to build
+* @return bool -> if successfully read and levelized
+*/
+bool build_topology(std::string netlistPath, bool activateFaultsOnAllNodes,
+    std::vector<std::pair<int, int>> faultList, LevelizedCircuit& topology)
+{
+    Circuit testCkt;
+    if (testCkt.read_netlist(netlistPath, activateFaultsOnAllNodes) == false)
+    {
+        return false;
+    }
+    for (std::pair<int, int> fault : faultList)
+    {
+        testCkt.apply_fault(fault.first, fault.second);
+    }
+    return topology.build(testCkt);
+}
+
+/*
+* Function to set up the fault simulation engine for a netlist
+* With collapsing, the engine grades the representatives and reports over the complete fault list
+* @param options -> fault simulation options
+* @param netlistPath -> location of the netlist
+* @param activateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+* @param faultList -> faults to apply if not activated on all nodes
+* @param topology -> levelized circuit built for the index based engines (must outlive engine)
+* @param dropDetectedFaults -> engine may drop faults once detected (only new detections reported)
+* @return FaultSimEngine* -> engine object, NULL on failure
+*/
+FaultSimEngine* setup_engine(SimOptions& options, std::string netlistPath, bool activateFaultsOnAllNodes,
+    std::vector<std::pair<int, int>> faultList, LevelizedCircuit& topology, bool dropDetectedFaults)
+{
+    bool useTopology = (options.engineName.compare("deductive") != 0);
+    if (options.collapseMode.empty())
+    {
+        if (useTopology && build_topology(netlistPath, activateFaultsOnAllNodes, faultList, topology) == false)
+        {
+            return NULL;
+        }
+        FaultSimEngine* engine = create_engine(options.engineName, netlistPath, activateFaultsOnAllNodes,
+            faultList, &topology, dropDetectedFaults, options.numThreads, options.numProcesses);
+        if (engine != NULL && engine->set_detection_limit(options.detectionLimit) == false)
+        {
+            std::cerr << "N-detect grading is not supported by engine: " << options.engineName << "\n";
+            delete engine;
+            return NULL;
+        }
+        return engine;
+    }
+
+    // Collapse the complete fault list and simulate only the representatives
+    LevelizedCircuit fullTopology;
+    if (build_topology(netlistPath, activateFaultsOnAllNodes, faultList, fullTopology) == false)
+    {
+        return NULL;
+    }
+    FaultCollapser collapser(fullTopology, options.collapseMode.compare("dom") == 0);
+    std::vector<std::pair<int, int>> representativeFaults = collapser.get_representative_faults();
+    std::cout << "Fault collapsing: " << collapser.get_total_faults_count() << " faults, "
+        << collapser.get_num_classes() << " equivalence classes, "
+        << representativeFaults.size() << " faults simulated\n";
+    if (useTopology && build_topology(netlistPath, false, representativeFaults, topology) == false)
+    {
+        return NULL;
+    }
+    FaultSimEngine* engine = create_engine(options.engineName, netlistPath, false, representativeFaults,
+        &topology, dropDetectedFaults, options.numThreads, options.numProcesses);
+    if (engine == NULL)
+    {
+        return NULL;
+    }
+    if (options.detectionLimit != 1)
+    {
+        // detection counts of a representative do not carry over to dominating faults
+        std::cerr << "N-detect grading is not supported with fault collapsing\n";
+        delete engine;
+        return NULL;
+    }
+    return new CollapsedFaultSim(engine, collapser);
+}
+
+/*
+* Function to print the fault coverage at each N-detect level
+* @param nDetectCounts -> entry n - 1 holds the faults detected n or more times
+* @param totalFaults -> total faults graded
+* @param ofOutFile -> file to copy the table to (NULL => standard output only)
+*/
+void print_n_detect_coverage(const std::vector<int>& nDetectCounts, int totalFaults, std::ofstream* ofOutFile)
+{
+    if (nDetectCounts.size() <= 1 || totalFaults == 0)
+    {
+        return;
+    }
+    std::cout << "N-detect level \tFault Coverage %\n";
+    if (ofOutFile != NULL)
+    {
+        *ofOutFile << "N-detect level \tFault Coverage %\n";
+    }
+    for (unsigned int n = 0; n < nDetectCounts.size(); ++n)
+    {
+        std::cout << n + 1 << "\t" << nDetectCounts[n] * 100.0 / totalFaults << "\n";
+        if (ofOutFile != NULL)
+        {
+            *ofOutFile << n + 1 << "\t" << nDetectCounts[n] * 100.0 / totalFaults << "\n";
+        }
+    }
+}
+
+/*
+* Function to get the number of faults to sample for a confidence margin
+* Worst case proportion (50%), corrected for the finite fault population
+* @param marginPercent -> half width of the 95% confidence interval in %
+* @param populationSize -> number of faults sampled from
+* @return long long -> sample size
+*/
+long long get_sample_size(double marginPercent, long long populationSize)
+{
+    double margin = marginPercent / 100.0;
+    double infiniteSize = confidenceQuantile * confidenceQuantile * 0.25 / (margin * margin);
+    double sampleSize = infiniteSize / (1.0 + (infiniteSize - 1.0) / populationSize);
+    return std::min<long long>(populationSize, (long long)ceil(sampleSize));
+}
+
+/*
+* Function to draw a uniform random sample of faults without replacement
+* The universe is every s-a-0/s-a-1 fault of the nodes created for the netlist
+* (activateFaultsOnAllNodes) or the custom fault list
+* @param testCkt -> circuit read from netlist
+* @param activateFaultsOnAllNodes -> sample from the faults on all nodes
+* @param faultList -> faults to sample from if not activated on all nodes
+* @param sampleSize -> number of faults to draw
+* @return vector of pairs -> sampled faults in universe order
+*/
+std::vector<std::pair<int, int>> sample_faults(Circuit& testCkt, bool activateFaultsOnAllNodes,
+    const std::vector<std::pair<int, int>>& faultList, long long sampleSize)
+{
+    std::vector<int> nodeNames;
+    if (activateFaultsOnAllNodes)
+    {
+        std::list<int> nodeList = testCkt.get_node_list();
+        nodeNames.assign(nodeList.begin(), nodeList.end());
+    }
+    long long populationSize = activateFaultsOnAllNodes ? 2LL * nodeNames.size() : faultList.size();
+
+    // Floyd's algorithm => sampleSize draws whatever the population size
+    std::mt19937_64 generator(samplingSeed);
+    std::unordered_set<long long> sampledIndices;
+    for (long long j = populationSize - sampleSize; j < populationSize; ++j)
+    {
+        long long faultIndex = std::uniform_int_distribution<long long>(0, j)(generator);
+        if (sampledIndices.insert(faultIndex).second == false)
+        {
+            sampledIndices.insert(j);
+        }
+    }
+    std::vector<long long> sortedIndices(sampledIndices.begin(), sampledIndices.end());
+    std::sort(sortedIndices.begin(), sortedIndices.end());
+
+    std::vector<std::pair<int, int>> sampledFaults;
+    for (long long faultIndex : sortedIndices)
+    {
+        if (activateFaultsOnAllNodes)
+        {
+            sampledFaults.push_back(std::make_pair(nodeNames[faultIndex / 2], (int)(faultIndex % 2)));
+        }
+        else
+        {
+            sampledFaults.push_back(faultList[faultIndex]);
+        }
+    }
+    return sampledFaults;
+}
+
+/*
+* Function to print the coverage estimated from a fault sample
+* Wilson score interval, the finite population correction enlarges the
+* effective sample size (no uncertainty left once every fault is sampled)
+* @param detectedCount -> sampled faults detected
+* @param sampleSize -> number of sampled faults
+* @param populationSize -> number of faults sampled from
+* @param ofOutFile -> file to copy the estimate to (NULL => standard output only)
+*/
+void print_sampled_coverage(int detectedCount, int sampleSize, long long populationSize, std::ofstream* ofOutFile)
+{
+    if (sampleSize == 0)
+    {
+        return;
+    }
+    double proportion = detectedCount * 1.0 / sampleSize;
+    double lowerBound = proportion;
+    double upperBound = proportion;
+    if (sampleSize < populationSize)
+    {
+        double effectiveSize = sampleSize * (populationSize - 1.0) / (populationSize - sampleSize);
+        double zSquared = confidenceQuantile * confidenceQuantile;
+        double center = (proportion + zSquared / (2.0 * effectiveSize)) / (1.0 + zSquared / effectiveSize);
+        double halfWidth = confidenceQuantile / (1.0 + zSquared / effectiveSize) *
+            sqrt(proportion * (1.0 - proportion) / effectiveSize + zSquared / (4.0 * effectiveSize * effectiveSize));
+        lowerBound = std::max(0.0, center - halfWidth);
+        upperBound = std::min(1.0, center + halfWidth);
+    }
+
+    std::ostringstream estimate;
+    estimate << "Estimated fault coverage: " << proportion * 100.0 << "% (95% confidence interval "
+        << lowerBound * 100.0 << "% - " << upperBound * 100.0 << "%, " << sampleSize << " of "
+        << populationSize << " faults sampled)\n";
+    std::cout << estimate.str();
+    if (ofOutFile != NULL)
+    {
+        *ofOutFile << estimate.str();
+    }
+}
+
+/*
+* Function to create the pattern source selected on the command line
+* @param sourceName -> random, lfsr or ca
+* @param width -> number of bits per pattern
+* @return PatternSource* -> pattern source object, NULL if source name unknown
+*/
+PatternSource* create_pattern_source(std::string sourceName, int width)
+{
+    if (sourceName.compare("random") == 0)
+    {
+        return new RandomPatternSource(width, patternSeed);
+    }
+    else if (sourceName.compare("lfsr") == 0)
+    {
+        return new LfsrPatternSource(width, patternSeed);
+    }
+    else if (sourceName.compare("ca") == 0)
+    {
+        return new CellularAutomatonPatternSource(width, patternSeed);
+    }
+    std::cerr << "Unknown pattern source: " << sourceName << "\n";
+    return NULL;
+}
+
+/*
+* Function to save the state of a pattern grading run
+* @param checkpointPath -> location of the checkpoint
+* @param checkpoint -> run state with the counters and coverage curve already set (updated in place)
+* @param engine -> engine grading the run
+* @param patternSource -> pattern source of the run
+* @param detectedFaults -> faults detected so far
+* @return bool -> if saved successfully
+*/
+bool save_grading_checkpoint(std::string checkpointPath, GradingCheckpoint& checkpoint, FaultSimEngine* engine,
+    PatternSource* patternSource, const std::set<std::pair<int, int>>& detectedFaults)
+{
+    checkpoint.totalFaults = engine->get_total_faults_count();
+    checkpoint.sourceState = patternSource->get_state();
+    checkpoint.detectedFaults.assign(detectedFaults.begin(), detectedFaults.end());
+    if (engine->get_detection_state(checkpoint.detectionCounts) == false)
+    {
+        // engine keeps no state => resumed engine re-reports the detected faults
+        checkpoint.detectionCounts.clear();
+    }
+    return checkpoint.save(checkpointPath);
+}
+
+/*
+* Function to restore the state of a pattern grading run
+* The pattern source is restored from its saved state, the patterns to skip
+* are rebuilt by replaying a new source from the seed up to the same state
+* @param checkpointPath -> location of the checkpoint
+* @param checkpoint -> run state with the run parameters set, the saved state is read into it (updated in place)
+* @param engine -> engine grading the run, before the first vector
+* @param patternSource -> pattern source of the run, before the first pattern
+* @param patternsSoFar -> patterns drawn before the checkpoint (updated in place)
+* @return bool -> if the checkpoint matches the run and was restored
+*/
+bool resume_grading_checkpoint(std::string checkpointPath, GradingCheckpoint& checkpoint, FaultSimEngine* engine,
+    PatternSource* patternSource, std::unordered_set<std::vector<uint64_t>, PatternWordsHash>& patternsSoFar)
+{
+    GradingCheckpoint savedCheckpoint;
+    if (savedCheckpoint.load(checkpointPath) == false)
+    {
+        return false;
+    }
+    if (savedCheckpoint.netlistPath != checkpoint.netlistPath ||
+        savedCheckpoint.patternSource != checkpoint.patternSource ||
+        savedCheckpoint.patternWidth != checkpoint.patternWidth ||
+        // engines counting their faults on the first vector report none before
+        (checkpoint.totalFaults != 0 && savedCheckpoint.totalFaults != checkpoint.totalFaults) ||
+        savedCheckpoint.detectionLimit != checkpoint.detectionLimit)
+    {
+        std::cerr << "Checkpoint " << checkpointPath << " was saved for another netlist or options\n";
+        return false;
+    }
+
+    PatternSource* replaySource = create_pattern_source(checkpoint.patternSource, checkpoint.patternWidth);
+    std::vector<uint64_t> patternWords;
+    for (uint64_t i = 0; i < savedCheckpoint.patternsDrawn; ++i)
+    {
+        replaySource->next_pattern(patternWords);
+        patternsSoFar.insert(patternWords);
+    }
+    bool isReplayed = (replaySource->get_state() == savedCheckpoint.sourceState);
+    delete replaySource;
+    if (isReplayed == false || patternSource->set_state(savedCheckpoint.sourceState) == false)
+    {
+        std::cerr << "Pattern source does not reach the state of checkpoint " << checkpointPath << "\n";
+        return false;
+    }
+    if (savedCheckpoint.detectionCounts.size() > 0 &&
+        engine->set_detection_state(savedCheckpoint.detectionCounts) == false)
+    {
+        std::cerr << "Engine state of checkpoint " << checkpointPath << " does not match the engine\n";
+        return false;
+    }
+    checkpoint = savedCheckpoint;
+    return true;
+}
+
+/*
+* Function to grade unique patterns of a pattern source until a stop condition
+* Stops on the maximum vector count, the target coverage, a coverage plateau
+* or when the source runs out of new patterns
+* With a checkpoint path, the run state is saved every checkpointInterval
+* seconds (between blocks) and when the run stops
+* @param netlistPath -> location of the netlist
+* @param activateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+* @param faultList -> faults to apply if not activated on all nodes
+* @param options -> fault simulation and pattern options
+* @param ofOutFile -> file to copy the coverage curve to (NULL => standard output only)
+* @return bool -> if graded successfully
+*/
+bool grade_random_patterns(std::string netlistPath, bool activateFaultsOnAllNodes,
+    std::vector<std::pair<int, int>> faultList, SimOptions& options, std::ofstream* ofOutFile)
+{
+    // pattern width is the number of primary inputs
+    Circuit testCkt;
+    if (testCkt.read_netlist(netlistPath, false) == false)
+    {
+        return false;
+    }
+    int width = testCkt.get_input_nodes().size();
+    PatternSource* patternSource = create_pattern_source(options.patternSource, width);
+    if (patternSource == NULL)
+    {
+        return false;
+    }
+
+    // Engine keeps its state across the test vectors of this netlist
+    LevelizedCircuit topology;
+    FaultSimEngine* engine = setup_engine(options, netlistPath, activateFaultsOnAllNodes,
+        faultList, topology, true);
+    if (engine == NULL)
+    {
+        delete patternSource;
+        return false;
+    }
+
+    // set of faults found so far in this check
+    std::set<std::pair<int, int>> detectableFaultsSoFar;
+
+    // patterns generated so far, to skip duplicates
+    std::unordered_set<std::vector<uint64_t>, PatternWordsHash> patternsSoFar;
+
+    std::string stopReason = "maximum vector count reached";
+    int vectorsRun = 0;
+    int vectorsSinceDetection = 0;
+    bool isStopped = false;
+    std::vector<uint64_t> patternWords;
+
+    // Run state saved to the checkpoint, the coverage curve is kept in it
+    GradingCheckpoint checkpoint;
+    checkpoint.netlistPath = netlistPath;
+    checkpoint.patternSource = options.patternSource;
+    checkpoint.patternWidth = width;
+    checkpoint.totalFaults = engine->get_total_faults_count();
+    checkpoint.detectionLimit = options.detectionLimit;
+    if (options.resumeRun && std::ifstream(options.checkpointPath).good())
+    {
+        if (resume_grading_checkpoint(options.checkpointPath, checkpoint, engine, patternSource, patternsSoFar) == false)
+        {
+            delete engine;
+            delete patternSource;
+            return false;
+        }
+        detectableFaultsSoFar.insert(checkpoint.detectedFaults.begin(), checkpoint.detectedFaults.end());
+        vectorsRun = checkpoint.vectorsRun;
+        vectorsSinceDetection = checkpoint.vectorsSinceDetection;
+        isStopped = checkpoint.isFinished;
+        if (isStopped)
+        {
+            stopReason = checkpoint.stopReason;
+        }
+
+        // Print the coverage of the vectors run before the checkpoint
+        for (int j = 0; j < vectorsRun; ++j)
+        {
+            float coverageValue = checkpoint.get_detected_count(j) * 100.0 / checkpoint.totalFaults;
+            std::cout << j << "\t" << coverageValue << "\n";
+            if (ofOutFile != NULL)
+            {
+                *ofOutFile << j << "\t" << coverageValue << "\n";
+            }
+        }
+    }
+    std::chrono::steady_clock::time_point lastCheckpoint = std::chrono::steady_clock::now();
+
+    // Instrumented runs grade one vector per engine call to time each vector
+    int blockSize = vectorBlockSize;
+    if (options.statsWriter != NULL)
+    {
+        blockSize = 1;
+        options.statsWriter->begin_run(netlistPath, get_engine_label(options), engine);
+    }
+
+    while (isStopped == false && vectorsRun < options.maxVectors)
+    {
+        // Draw the next block of unique patterns
+        std::vector<std::string> blockVectors;
+        int duplicatesInRow = 0;
+        while ((int)blockVectors.size() < blockSize &&
+            vectorsRun + (int)blockVectors.size() < options.maxVectors)
+        {
+            if (width < 64 && patternsSoFar.size() == (1ULL << width))
+            {
+                break;
+            }
+            patternSource->next_pattern(patternWords);
+            ++checkpoint.patternsDrawn;
+            if (patternsSoFar.insert(patternWords).second == false)
+            {
+                if (++duplicatesInRow == maxDuplicatePatterns)
+                {
+                    break;
+                }
+                continue;
+            }
+            duplicatesInRow = 0;
+            blockVectors.push_back(pattern_to_string(patternWords, width));
+        }
+        if (blockVectors.empty())
+        {
+            stopReason = "pattern source exhausted";
+            break;
+        }
+
+        std::vector<std::set<std::pair<int, int>>> faultsDetectedPerVector;
+        std::chrono::steady_clock::time_point blockStart = std::chrono::steady_clock::now();
+        if (engine->apply_test_vectors(blockVectors, faultsDetectedPerVector) == false)
+        {
+            delete engine;
+            delete patternSource;
+            return false;
+        }
+        double blockSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - blockStart).count();
+        int totalCircuitFaults = engine->get_total_faults_count();
+        for (unsigned int k = 0; k < blockVectors.size() && isStopped == false; ++k)
+        {
+            // Copy these faults in the main set, so as to skip the overlapping faults
+            size_t detectedBefore = detectableFaultsSoFar.size();
+            detectableFaultsSoFar.insert(faultsDetectedPerVector[k].begin(), faultsDetectedPerVector[k].end());
+            vectorsSinceDetection = (detectableFaultsSoFar.size() > detectedBefore) ? 0 : vectorsSinceDetection + 1;
+            if (vectorsSinceDetection == 0)
+            {
+                checkpoint.coverageCurve.push_back(std::make_pair(vectorsRun, detectableFaultsSoFar.size()));
+            }
+
+            // Print the coverage of current number of tests
+            float coverageValue = detectableFaultsSoFar.size() * 100.0 / totalCircuitFaults;
+            std::cout << vectorsRun << "\t" << coverageValue << "\n";
+            if (ofOutFile != NULL)
+            {
+                *ofOutFile << vectorsRun << "\t" << coverageValue << "\n";
+            }
+            if (options.statsWriter != NULL)
+            {
+                options.statsWriter->write_record(vectorsRun, blockSeconds, detectableFaultsSoFar.size(),
+                    totalCircuitFaults, engine);
+            }
+            ++vectorsRun;
+
+            if (options.targetCoverage > 0 && coverageValue >= options.targetCoverage)
+            {
+                stopReason = "target coverage reached";
+                isStopped = true;
+            }
+            else if (options.plateauVectors > 0 && vectorsSinceDetection >= options.plateauVectors)
+            {
+                stopReason = "coverage plateau";
+                isStopped = true;
+            }
+        }
+
+        // Save the state between blocks once the interval has passed
+        if (options.checkpointPath.empty() == false && isStopped == false &&
+            std::chrono::steady_clock::now() - lastCheckpoint >= std::chrono::seconds(checkpointInterval))
+        {
+            checkpoint.vectorsRun = vectorsRun;
+            checkpoint.vectorsSinceDetection = vectorsSinceDetection;
+            if (save_grading_checkpoint(options.checkpointPath, checkpoint, engine, patternSource,
+                detectableFaultsSoFar) == false)
+            {
+                delete engine;
+                delete patternSource;
+                return false;
+            }
+            lastCheckpoint = std::chrono::steady_clock::now();
+        }
+    }
+    if (options.checkpointPath.empty() == false)
+    {
+        checkpoint.vectorsRun = vectorsRun;
+        checkpoint.vectorsSinceDetection = vectorsSinceDetection;
+        checkpoint.isFinished = true;
+        checkpoint.stopReason = stopReason;
+        if (save_grading_checkpoint(options.checkpointPath, checkpoint, engine, patternSource,
+            detectableFaultsSoFar) == false)
+        {
+            delete engine;
+            delete patternSource;
+            return false;
+        }
+    }
+    std::cout << "Stopped after " << vectorsRun << " vectors: " << stopReason << "\n";
+    if (ofOutFile != NULL)
+    {
+        *ofOutFile << "Stopped after " << vectorsRun << " vectors: " << stopReason << "\n";
+    }
+    print_n_detect_coverage(engine->get_n_detect_counts(), engine->get_total_faults_count(), ofOutFile);
+    if (options.sampledFrom > 0)
+    {
+        print_sampled_coverage(detectableFaultsSoFar.size(), engine->get_total_faults_count(),
+            options.sampledFrom, ofOutFile);
+    }
+    delete engine;
+    delete patternSource;
+    return true;
+}
+
+/*
+* Function to print stats for all known netlist files in csv for plotting
+* NOTE: This applies all faults to circuit
+* @param parentPath -> directory with the known netlists
+* @param options -> fault simulation and pattern options
+*/
+void run_all(std::string parentPath, SimOptions& options)
+{
+    std::string outputFileName = "test_data.csv";
+    std::ofstream ofOutFile;
+    ofOutFile.open(outputFileName, std::ios::trunc);
+    std::string netlistNames[] = {"/s27.txt", "/s298f_2.txt", "/s344f_2.txt", "/s349f_2.txt"};
+    for (int i = 0; i < 4; ++i)
+    {
+        std::string netlistPath = parentPath + netlistNames[i];
+        std::cout << "Running on netlist: " << netlistPath << "\n";
+        ofOutFile << "Running on netlist: " << netlistPath << "\n";
+        std::cout << "Test vectors run \tFault Coverage %\n";
+        ofOutFile << "Test vectors run \tFault Coverage %\n";
+        bool activateFaultsOnAllNodes = true;
 
+        // one checkpoint per netlist
+        SimOptions netlistOptions = options;
+        if (options.checkpointPath.empty() == false)
+        {
+            netlistOptions.checkpointPath = options.checkpointPath + "." + netlistNames[i].substr(1);
+        }
+        if (grade_random_patterns(netlistPath, activateFaultsOnAllNodes,
+            std::vector<std::pair<int, int>>(), netlistOptions, &ofOutFile) == false)
+        {
+            std::cout << "Developer Error #1";
+            return;
+        }
+        std::cout << "\n\n";
+        ofOutFile << "\n\n";
+    }
+    std::cout << "Check file: " << outputFileName << " for result output.\n";
+    ofOutFile.close();
+}
+
+/*
+* Function to read a test set, one test vector per line
+* Empty lines and lines starting with # are skipped
+* @param testSetPath -> location of the test set
+* @param testVectors -> test vectors read (updated in place)
+* @return bool -> if read successfully
+*/
+bool read_test_set(std::string testSetPath, std::vector<std::string>& testVectors)
+{
+    std::ifstream infile(testSetPath);
+    if (infile.is_open() == false)
+    {
+        std::cerr << "Unable to open test set: " << testSetPath << "\n";
+        return false;
+    }
+    std::string currLine;
+    while (std::getline(infile, currLine))
+    {
+        // strip carriage return and trailing spaces
+        while (currLine.size() > 0 && isspace(currLine.back()))
+        {
+            currLine.pop_back();
+        }
+        if (currLine.empty() || currLine[0] == '#')
+        {
+            continue;
+        }
+        testVectors.push_back(currLine);
+    }
+    return true;
+}
+
+/*
+* Function to read vector pairs, one initialization and one launch vector per line
+* Empty lines and lines starting with # are skipped
+* @param vectorPairsPath -> location of the vector pairs
+* @param vectorPairs -> pair of entry => first = initialization vector, second = launch vector (updated in place)
+* @return bool -> if read successfully
+*/
+bool read_vector_pairs(std::string vectorPairsPath, std::vector<std::pair<std::string, std::string>>& vectorPairs)
+{
+    std::ifstream infile(vectorPairsPath);
+    if (infile.is_open() == false)
+    {
+        std::cerr << "Unable to open vector pairs: " << vectorPairsPath << "\n";
+        return false;
+    }
+    std::string currLine;
+    while (std::getline(infile, currLine))
+    {
+        std::istringstream lineStream(currLine);
+        std::string initialVector, launchVector;
+        if (currLine.empty() || currLine[0] == '#' || !(lineStream >> initialVector))
+        {
+            continue;
+        }
+        if (!(lineStream >> launchVector))
+        {
+            std::cerr << "Missing launch vector in line: " << currLine << "\n";
+            return false;
+        }
+        vectorPairs.push_back(std::make_pair(initialVector, launchVector));
+    }
+    return true;
+}
+
+/*
+* Function to grade transition faults with vector pairs on a single netlist
+* A slow-to-rise (slow-to-fall) fault is detected by a pair whose first vector
+* sets the node to 0 (1) and whose second vector detects the node stuck at 0 (1)
+* @param netlistPath -> location of the netlist
+* @param activateFaultsOnAllNodes -> activate the rising and falling faults on all nodes
+* @param faultList -> faults to apply if not activated on all nodes (0 = slow-to-rise, 1 = slow-to-fall)
+* @param vectorPairs -> pair of entry => first = initialization vector, second = launch vector
+* @param options -> fault simulation options
+* @return bool -> if graded successfully
+*/
+bool run_vector_pairs(std::string netlistPath, bool activateFaultsOnAllNodes,
+    std::vector<std::pair<int, int>> faultList, const std::vector<std::pair<std::string, std::string>>& vectorPairs,
+    SimOptions& options)
+{
+    LevelizedCircuit topology;
+    if (build_topology(netlistPath, activateFaultsOnAllNodes, faultList, topology) == false)
+    {
+        return false;
+    }
+    PatternParallelFaultSim engine(&topology);
+    engine.set_fault_dropping(true);
+    engine.set_detection_limit(options.detectionLimit);
+
+    std::set<std::pair<int, int>> detectedFaults;
+    int totalFaults = engine.get_total_faults_count();
+    std::cout << "Vector pairs run \tTransition Fault Coverage %\n";
+    for (unsigned int j = 0; j < vectorPairs.size(); j += vectorBlockSize)
+    {
+        std::vector<std::pair<std::string, std::string>> blockPairs(vectorPairs.begin() + j,
+            vectorPairs.begin() + std::min<size_t>(j + vectorBlockSize, vectorPairs.size()));
+        std::vector<std::set<std::pair<int, int>>> faultsDetectedPerPair;
+        if (engine.apply_vector_pairs(blockPairs, faultsDetectedPerPair) == false)
+        {
+            std::cerr << "Unable to apply vector pair block starting at " << j << "\n";
+            return false;
+        }
+        for (unsigned int k = 0; k < blockPairs.size(); ++k)
+        {
+            detectedFaults.insert(faultsDetectedPerPair[k].begin(), faultsDetectedPerPair[k].end());
+            std::cout << j + k << "\t" << detectedFaults.size() * 100.0 / totalFaults << "\n";
+        }
+    }
+
+    std::cout << "\n";
+    std::cout << "Coverage Statistics:\n";
+    std::cout << "Vector pairs applied: " << vectorPairs.size() << "\n";
+    std::cout << "Total transition faults in circuit:" << totalFaults << "\n";
+    std::cout << "Total transition faults detected: " << detectedFaults.size() << "\n";
+    if (totalFaults > 0)
+    {
+        float coverageValue = detectedFaults.size() * 100.0 / totalFaults;
+        std::cout << "Coverage percentage:" << coverageValue << "%\n";
+    }
+    print_n_detect_coverage(engine.get_n_detect_counts(), totalFaults, NULL);
+    if (options.sampledFrom > 0)
+    {
+        print_sampled_coverage(detectedFaults.size(), totalFaults, options.sampledFrom, NULL);
+    }
+    return true;
+}
+
+/*
+* Function to grade bridging faults on a single netlist
+* The fault list holds one bridge per line: node name, node name, bridge type
+* @param netlistPath -> location of the netlist
+* @param bridgingFaultPath -> location of the bridging fault list
+* @param testVectors -> test vectors to grade
+* @return bool -> if graded successfully
+*/
+bool run_bridging_faults(std::string netlistPath, std::string bridgingFaultPath,
+    const std::vector<std::string>& testVectors)
+{
+    LevelizedCircuit topology;
+    if (build_topology(netlistPath, false, std::vector<std::pair<int, int>>(), topology) == false)
+    {
+        return false;
+    }
+    BridgingFaultSim engine(&topology);
+    engine.set_fault_dropping(true);
+
+    std::ifstream infile(bridgingFaultPath);
+    if (infile.is_open() == false)
+    {
+        std::cerr << "Unable to open bridging fault list: " << bridgingFaultPath << "\n";
+        return false;
+    }
+    int node1Name, node2Name, faultType;
+    while (infile >> node1Name >> node2Name >> faultType)
+    {
+        if (engine.add_fault(node1Name, node2Name, faultType) == false)
+        {
+            return false;
+        }
+    }
+
+    int detectedCount = 0;
+    int totalFaults = engine.get_total_faults_count();
+    std::cout << "Test vectors run \tBridging Fault Coverage %\n";
+    for (unsigned int j = 0; j < testVectors.size(); j += vectorBlockSize)
+    {
+        std::vector<std::string> blockVectors(testVectors.begin() + j,
+            testVectors.begin() + std::min<size_t>(j + vectorBlockSize, testVectors.size()));
+        std::vector<std::vector<int>> faultsDetectedPerVector;
+        if (engine.apply_test_vectors(blockVectors, faultsDetectedPerVector) == false)
+        {
+            std::cerr << "Unable to apply test vector block starting at " << j << "\n";
+            return false;
+        }
+        // faults are dropped => each fault is reported by one vector only
+        for (unsigned int k = 0; k < blockVectors.size(); ++k)
+        {
+            detectedCount += faultsDetectedPerVector[k].size();
+            std::cout << j + k << "\t" << detectedCount * 100.0 / totalFaults << "\n";
+        }
+    }
+
+    std::cout << "\n";
+    std::cout << "Coverage Statistics:\n";
+    std::cout << "Test vectors applied: " << testVectors.size() << "\n";
+    std::cout << "Total bridging faults in circuit:" << totalFaults << "\n";
+    std::cout << "Total bridging faults detected: " << detectedCount << "\n";
+    if (totalFaults > 0)
+    {
+        float coverageValue = detectedCount * 100.0 / totalFaults;
+        std::cout << "Coverage percentage:" << coverageValue << "%\n";
+    }
+    return true;
+}
+
+/*
+* Function to grade a test set and write its fault dictionary
+* Faults are not dropped so every detection of every vector is recorded
+* @param topology -> levelized circuit with the fault list of the dictionary
+* @param testVectors -> test vectors to grade
+* @param options -> fault simulation options
+* @param detectedFaults -> faults detected by the test set (updated in place)
+* @return bool -> if graded and written successfully
+*/
+bool write_fault_dictionary(LevelizedCircuit& topology, const std::vector<std::string>& testVectors,
+    SimOptions& options, std::set<std::pair<int, int>>& detectedFaults)
+{
+    std::vector<int> outputNames;
+    for (int nodeIndex : topology.outputNodes)
+    {
+        outputNames.push_back(topology.nodeNames[nodeIndex]);
+    }
+    FaultDictionaryWriter dictionaryWriter;
+    if (dictionaryWriter.open(options.dictionaryPath, topology.faultList, outputNames,
+        options.dictionaryPerOutput, dictionaryBlockSize) == false)
+    {
+        return false;
+    }
+
+    // index based engine => detections come out as fault ids of the dictionary
+    ConcurrentFaultSim engine(&topology);
+    std::vector<bool> isDetected(topology.get_num_faults(), false);
+    int numDetected = 0;
+    for (unsigned int j = 0; j < testVectors.size(); ++j)
+    {
+        if (engine.apply_test_vector(testVectors[j]) == false)
+        {
+            std::cerr << "Unable to apply test vector " << j << ": " << testVectors[j] << "\n";
+            return false;
+        }
+        std::vector<std::vector<int>> vectorFaults;
+        if (options.dictionaryPerOutput)
+        {
+            for (unsigned int k = 0; k < topology.outputNodes.size(); ++k)
+            {
+                vectorFaults.push_back(engine.get_output_fault_indices(k));
+            }
+        }
+        else
+        {
+            vectorFaults.push_back(engine.get_detected_fault_indices());
+        }
+        if (dictionaryWriter.add_vector(vectorFaults) == false)
+        {
+            return false;
+        }
+
+        for (int faultIndex : engine.get_detected_fault_indices())
+        {
+            if (isDetected[faultIndex] == false)
+            {
+                isDetected[faultIndex] = true;
+                ++numDetected;
+                detectedFaults.insert(topology.faultList[faultIndex]);
+            }
+        }
+        std::cout << j << "\t" << numDetected * 100.0 / topology.get_num_faults() << "\n";
+    }
+    return dictionaryWriter.close();
+}
+
+/*
+* Function to find the vectors detecting new faults when simulated in order
+* @param netlistPath -> location of the netlist
+* @param activateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+* @param faultList -> faults to apply if not activated on all nodes
+* @param testVectors -> test vectors in simulation order
+* @param options -> fault simulation options
+* @param essentialVectors -> whether each vector detects a new fault (updated in place)
+* @param detectedCount -> number of faults detected by the test set (updated in place)
+* @return bool -> if graded successfully
+*/
+bool find_essential_vectors(std::string netlistPath, bool activateFaultsOnAllNodes,
+    std::vector<std::pair<int, int>> faultList, const std::vector<std::string>& testVectors,
+    SimOptions& options, std::vector<bool>& essentialVectors, int& detectedCount)
+{
+    LevelizedCircuit topology;
+    FaultSimEngine* engine = setup_engine(options, netlistPath, activateFaultsOnAllNodes,
+        faultList, topology, true);
+    if (engine == NULL)
+    {
+        return false;
+    }
+    std::set<std::pair<int, int>> detectedFaults;
+    essentialVectors.assign(testVectors.size(), false);
+    for (unsigned int j = 0; j < testVectors.size(); j += vectorBlockSize)
+    {
+        std::vector<std::string> blockVectors(testVectors.begin() + j,
+            testVectors.begin() + std::min<size_t>(j + vectorBlockSize, testVectors.size()));
+        std::vector<std::set<std::pair<int, int>>> faultsDetectedPerVector;
+        if (engine->apply_test_vectors(blockVectors, faultsDetectedPerVector) == false)
+        {
+            delete engine;
+            return false;
+        }
+        for (unsigned int k = 0; k < blockVectors.size(); ++k)
+        {
+            // fault dropping => only the first vector detecting a fault reports it
+            size_t detectedBefore = detectedFaults.size();
+            detectedFaults.insert(faultsDetectedPerVector[k].begin(), faultsDetectedPerVector[k].end());
+            essentialVectors[j + k] = (detectedFaults.size() > detectedBefore);
+            // N-detect => the first N vectors detecting a fault report it
+            if (options.detectionLimit > 1 && faultsDetectedPerVector[k].empty() == false)
+            {
+                essentialVectors[j + k] = true;
+            }
+        }
+    }
+    detectedCount = detectedFaults.size();
+    delete engine;
+    return true;
+}
+
+/*
+* Function to compact a test set by reverse order fault simulation
+* Vectors detecting no fault that is not already detected by the vectors
+* simulated before them are removed. The first pass runs in reverse order, the
+* following passes over random reorderings of the remaining vectors.
+* @param netlistPath -> location of the netlist
+* @param activateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+* @param faultList -> faults to apply if not activated on all nodes
+* @param testVectors -> test vectors to compact (updated in place, original order kept)
+* @param options -> fault simulation options
+* @param numIterations -> number of passes over random reorderings
+* @return bool -> if compacted successfully
+*/
+bool compact_test_set(std::string netlistPath, bool activateFaultsOnAllNodes,
+    std::vector<std::pair<int, int>> faultList, std::vector<std::string>& testVectors,
+    SimOptions& options, int numIterations)
+{
+    // positions into the original set, so that the kept vectors stay in order
+    std::vector<int> keptVectors;
+    for (int j = testVectors.size() - 1; j >= 0; --j)
+    {
+        keptVectors.push_back(j);
+    }
+    std::mt19937 generator(compactionSeed);
+    for (int pass = 0; pass <= numIterations; ++pass)
+    {
+        if (pass > 0)
+        {
+            std::shuffle(keptVectors.begin(), keptVectors.end(), generator);
+        }
+        std::vector<std::string> passVectors;
+        for (int j : keptVectors)
+        {
+            passVectors.push_back(testVectors[j]);
+        }
+        std::vector<bool> essentialVectors;
+        int detectedCount = 0;
+        if (find_essential_vectors(netlistPath, activateFaultsOnAllNodes, faultList, passVectors,
+            options, essentialVectors, detectedCount) == false)
+        {
+            return false;
+        }
+        std::vector<int> passKept;
+        for (unsigned int j = 0; j < keptVectors.size(); ++j)
+        {
+            if (essentialVectors[j])
+            {
+                passKept.push_back(keptVectors[j]);
+            }
+        }
+        std::cout << "Compaction pass " << pass << ": " << keptVectors.size() << " -> "
+            << passKept.size() << " vectors, " << detectedCount << " faults detected\n";
+        keptVectors.swap(passKept);
+    }
 
-/*
-* Function to check if command line option provided
-*/
-bool checkCommandLineOption(int argc, char** argv, std::string inputToCheck)
-{
-    return std::find(argv, argv + argc, inputToCheck) != (argv + argc);
+    std::sort(keptVectors.begin(), keptVectors.end());
+    std::vector<std::string> compactedVectors;
+    for (int j : keptVectors)
+    {
+        compactedVectors.push_back(testVectors[j]);
+    }
+    testVectors.swap(compactedVectors);
+    return true;
 }
 
 /*
-* Function to get command line option from identifier
+* Function to write a test set, one test vector per line
+* @param testSetPath -> location of the test set
+* @param testVectors -> test vectors to write
+* @return bool -> if written successfully
 */
-std::string getCommandLineOption(int argc, char** argv, std::string inputToCheck)
+bool write_test_set(std::string testSetPath, const std::vector<std::string>& testVectors)
 {
-    char** itr = std::find(argv, argv + argc, inputToCheck);
-    if (itr != argv + argc &&
-        // check if the actual input is also not empty
-        itr + 1 != argv + argc)
+    std::ofstream outfile(testSetPath, std::ios::trunc);
+    if (outfile.is_open() == false)
     {
-        // return a string form of the iterator
-        ++itr;
-        std::string returnStr = *itr;
-        return returnStr;
+        std::cerr << "Unable to create test set: " << testSetPath << "\n";
+        return false;
     }
-    return "";
+    for (const std::string& testVector : testVectors)
+    {
+        outfile << testVector << "\n";
+    }
+    return outfile.good();
 }
 
 /*
-* Function to print stats for all known netlist files in csv for plotting
-* NOTE: This applies all faults to circuit
+* Function to grade a test set on a single netlist
+* @param netlistPath -> location of the netlist
+* @param activateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+* @param faultList -> faults to apply if not activated on all nodes
+* @param testVectors -> test vectors to grade
+* @param options -> fault simulation options
+* @return bool -> if graded successfully
 */
-void run_all(std::string parentPath)
+bool run_test_set(std::string netlistPath, bool activateFaultsOnAllNodes,
+    std::vector<std::pair<int, int>> faultList, const std::vector<std::string>& testVectors, SimOptions& options)
 {
-    std::string outputFileName = "test_data.csv";
-    std::ofstream ofOutFile;
-    ofOutFile.open(outputFileName, std::ios::trunc);
-    std::string netlistNames[] = {"/s27.txt", "/s298f_2.txt", "/s344f_2.txt", "/s349f_2.txt"};
-    float inputSize[] = {7 , 17, 24, 24};
-    for (int i = 0; i < 4; ++i)
+    std::set<std::pair<int, int>> detectedFaults;
+    std::vector<int> nDetectCounts;
+    int totalFaults = 0;
+    std::cout << "Test vectors run \tFault Coverage %\n";
+    if (options.dictionaryPath.empty() == false)
     {
-        std::string netlistPath = parentPath + netlistNames[i];
-        std::cout << "Running on netlist: " << netlistPath << "\n";
-        ofOutFile << "Running on netlist: " << netlistPath << "\n";
-        std::cout << "Test vectors run \tFault Coverage %\n";
-        ofOutFile << "Test vectors run \tFault Coverage %\n";
-        bool activateFaultsOnAllNodes = true;
-
-        int inputRangeMax = pow(2, inputSize[i]) - 1;
-
-        // init the random number generator
-        std::default_random_engine generator;
-        std::uniform_int_distribution<int> distribution(0, inputRangeMax);
-
-        // set of faults found so far in this check
-        std::set<std::pair<int, int>> detectableFaultsSoFar;
-
-        // vector to track if test run already
-        std::vector<int> testsRunSoFar;
-
-        // Total faults in circuit
-        int totalCircuitFaults = 0;
-
-        // j denotes the run number
-        for (int j = 0; j <= 100; ++j)
+        LevelizedCircuit topology;
+        if (build_topology(netlistPath, activateFaultsOnAllNodes, faultList, topology) == false ||
+            write_fault_dictionary(topology, testVectors, options, detectedFaults) == false)
+        {
+            return false;
+        }
+        totalFaults = topology.get_num_faults();
+        std::cout << "Fault dictionary written to: " << options.dictionaryPath << "\n";
+    }
+    else
+    {
+        LevelizedCircuit topology;
+        FaultSimEngine* engine = setup_engine(options, netlistPath, activateFaultsOnAllNodes,
+            faultList, topology, true);
+        if (engine == NULL)
+        {
+            return false;
+        }
+        // Instrumented runs grade one vector per engine call to time each vector
+        unsigned int blockSize = vectorBlockSize;
+        if (options.statsWriter != NULL)
         {
-            int testNumber = -1;
-            do
+            blockSize = 1;
+            options.statsWriter->begin_run(netlistPath, get_engine_label(options), engine);
+        }
+        for (unsigned int j = 0; j < testVectors.size(); j += blockSize)
+        {
+            std::vector<std::string> blockVectors(testVectors.begin() + j,
+                testVectors.begin() + std::min<size_t>(j + blockSize, testVectors.size()));
+            std::vector<std::set<std::pair<int, int>>> faultsDetectedPerVector;
+            std::chrono::steady_clock::time_point blockStart = std::chrono::steady_clock::now();
+            if (engine->apply_test_vectors(blockVectors, faultsDetectedPerVector) == false)
             {
-                testNumber = distribution(generator);
-            } while (std::find(testsRunSoFar.begin(), testsRunSoFar.end(), testNumber) != testsRunSoFar.end());
-
-            // insert number in tests run so far to track in next test run
-            testsRunSoFar.push_back(testNumber);
-
-            // generate the test vector to apply
-            std::string testVector = "";
-            for (int index = 0; index < inputSize[i]; ++index)
+                std::cerr << "Unable to apply test vector block starting at " << j << "\n";
+                delete engine;
+                return false;
+            }
+            double blockSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - blockStart).count();
+            totalFaults = engine->get_total_faults_count();
+            for (unsigned int k = 0; k < blockVectors.size(); ++k)
             {
-                if ((testNumber & 1) == 0)
-                {
-                    testVector = "0" + testVector;
-                }
-                else
+                detectedFaults.insert(faultsDetectedPerVector[k].begin(), faultsDetectedPerVector[k].end());
+                std::cout << j + k << "\t" << detectedFaults.size() * 100.0 / totalFaults << "\n";
+                if (options.statsWriter != NULL)
                 {
-                    testVector = "1" + testVector;
+                    options.statsWriter->write_record(j + k, blockSeconds, detectedFaults.size(), totalFaults, engine);
                 }
-                testNumber = testNumber >> 1;
-            }
-            Circuit testCkt;
-            if (testCkt.read_netlist(netlistPath, activateFaultsOnAllNodes) == false)
-            {
-                // unable to read netlist
-                std::cout << "Developer Error #1";
-                return;
-            }
-
-            if (testCkt.apply_test_vector(testVector) == false)
-            {
-                // unable to read netlist
-                std::cout << "Developer Error #2";
-                return;
             }
+        }
+        nDetectCounts = engine->get_n_detect_counts();
+        delete engine;
+    }
 
-            std::set<std::pair<int, int>> faultsDetectedInCurretIter = testCkt.get_list_detected_faults();
+    std::cout << "\n";
+    std::cout << "Coverage Statistics:\n";
+    std::cout << "Test vectors applied: " << testVectors.size() << "\n";
+    std::cout << "Total faults in circuit:" << totalFaults << "\n";
+    std::cout << "Total faults detected: " << detectedFaults.size() << "\n";
+    if (totalFaults > 0)
+    {
+        float coverageValue = detectedFaults.size() * 100.0 / totalFaults;
+        std::cout << "Coverage percentage:" << coverageValue << "%\n";
+    }
+    print_n_detect_coverage(nDetectCounts, totalFaults, NULL);
+    if (options.sampledFrom > 0)
+    {
+        print_sampled_coverage(detectedFaults.size(), totalFaults, options.sampledFrom, NULL);
+    }
+    return true;
+}
 
-            totalCircuitFaults = testCkt.get_total_faults_count();
+/*
+* Function to read a failing log, one failing vector per line
+* A line holds the vector index followed by the names of the failing outputs
+* @param failLogPath -> location of the failing log
+* @param failures -> failing vectors read (updated in place)
+* @return bool -> if read successfully
+*/
+bool read_failing_log(std::string failLogPath, std::vector<FailingObservation>& failures)
+{
+    std::ifstream infile(failLogPath);
+    if (infile.is_open() == false)
+    {
+        std::cerr << "Unable to open failing log: " << failLogPath << "\n";
+        return false;
+    }
+    std::string currLine;
+    while (std::getline(infile, currLine))
+    {
+        std::istringstream lineStream(currLine);
+        FailingObservation failure;
+        if (currLine.empty() || currLine[0] == '#' || !(lineStream >> failure.vectorIndex))
+        {
+            continue;
+        }
+        int outputName;
+        while (lineStream >> outputName)
+        {
+            failure.outputNames.push_back(outputName);
+        }
+        failures.push_back(failure);
+    }
+    return true;
+}
 
-            // Copy these faults in the main set, so as to skip the overlapping faults
-            detectableFaultsSoFar.insert(faultsDetectedInCurretIter.begin(), faultsDetectedInCurretIter.end());
+/*
+* Function to diagnose a failing device with a fault dictionary
+* @param dictionaryPath -> location of the fault dictionary
+* @param failLogPath -> location of the failing log
+* @param maxCandidates -> number of candidates to print
+* @return bool -> if diagnosed successfully
+*/
+bool run_diagnosis(std::string dictionaryPath, std::string failLogPath, int maxCandidates)
+{
+    FaultDictionaryReader dictionary;
+    std::vector<FailingObservation> failures;
+    if (dictionary.open(dictionaryPath) == false ||
+        read_failing_log(failLogPath, failures) == false)
+    {
+        return false;
+    }
 
-            // Print the coverage of current number of tests
-            //std::cout << "Tests run: " << j << "\nCoverage: " << detectableFaultsSoFar.size() * 100.0 / totalCircuitFaults << "\n\n";
-            std::cout << j << "\t" << detectableFaultsSoFar.size() * 100.0 / totalCircuitFaults << "\n";
-            ofOutFile << j << "\t" << detectableFaultsSoFar.size() * 100.0 / totalCircuitFaults << "\n";
-        }
-        std::cout << "\n\n";
-        ofOutFile << "\n\n";
+    FaultDiagnoser diagnoser(&dictionary);
+    std::vector<DiagnosisCandidate> candidates;
+    if (diagnoser.diagnose(failures, maxCandidates, candidates) == false)
+    {
+        return false;
     }
-    std::cout << "Check file: " << outputFileName << " for result output.\n";
-    ofOutFile.close();
+    // a vector repeated in the log is counted once, as in the diagnosis
+    std::set<int> failingVectors;
+    for (const FailingObservation& failure : failures)
+    {
+        failingVectors.insert(failure.vectorIndex);
+    }
+    std::cout << "Failing vectors: " << failingVectors.size() << " of " << dictionary.get_num_vectors() << "\n";
+    std::cout << "Faults explaining all failures: " << diagnoser.get_num_consistent_faults() << "\n";
+    std::cout << "Rank\tFault\t\tScore\tTFSF\tTFSP\tTPSF\n";
+    for (unsigned int i = 0; i < candidates.size(); ++i)
+    {
+        std::pair<int, int> fault = dictionary.faultList[candidates[i].faultId];
+        std::cout << i + 1 << "\t" << fault.first << " stuck at " << fault.second << "\t"
+            << candidates[i].matchScore << "\t" << candidates[i].failMatch << "\t"
+            << candidates[i].failMiss << "\t" << candidates[i].passMiss << "\n";
+    }
+    return true;
 }
 
 /*
@@ -164,22 +1410,230 @@ void printUsage()
     std::cerr << "\t-l\t->To run the circuit with all faults activated (cannot be used with -a)\n";
     std::cerr << "\t-p <path to fault list> ->Path to input fault list (cannot be used with -a and -l)\n";
     std::cerr << "\t-t <test vector to apply> ->Test vector to apply (cannot be used -a)\n";
+    std::cerr << "\t-e <engine> ->Fault simulation engine: deductive (default), concurrent, cpt (critical path tracing) or ppsfp (64 patterns per pass)\n";
+    std::cerr << "\t-j <threads> ->Run the concurrent engine with faults partitioned across threads (0 => all cores)\n";
+    std::cerr << "\t-P <processes> ->Run the concurrent engine with faults partitioned across forked processes (0 => all cores)\n";
+    std::cerr << "\t-c <eq|dom> ->Simulate only representatives of equivalent (eq) or also dominant (dom) faults, dom coverage is a lower bound\n";
+    std::cerr << "\t-s <path to test set> ->File with one test vector per line, graded instead of -t\n";
+    std::cerr << "\t-w <path to dictionary> ->Write the binary fault dictionary of the test set (must be used with -s)\n";
+    std::cerr << "\t-o\t->Store detected faults per primary output in the dictionary (must be used with -w)\n";
+    std::cerr << "\t-g <path to failing log> ->Rank candidate faults of a failing log (must be used with -r)\n";
+    std::cerr << "\t-r <path to dictionary> ->Fault dictionary used for diagnosis\n";
+    std::cerr << "\t-k <candidates> ->Number of diagnosis candidates to print (default 10)\n";
+    std::cerr << "\t-m <source> ->Pattern source for random pattern grading: random (default), lfsr or ca (cellular automaton)\n";
+    std::cerr << "\t-n <vectors> ->Maximum number of random patterns graded per netlist (default 101)\n";
+    std::cerr << "\t-v <coverage> ->Stop random pattern grading once the fault coverage % is reached\n";
+    std::cerr << "\t-u <vectors> ->Stop random pattern grading after this many vectors without a new detection\n";
+    std::cerr << "\t-x <path to compacted test set> ->Compact the test set by reverse order fault simulation (must be used with -s)\n";
+    std::cerr << "\t-i <iterations> ->Further compaction passes over random reorderings (default 0)\n";
+    std::cerr << "\t-q <N> ->N-detect grading, drop faults once detected by N vectors (concurrent and ppsfp engines)\n";
+    std::cerr << "\t-z <faults> ->Grade a uniform random sample of the faults and estimate the coverage (with -s or -m/-n)\n";
+    std::cerr << "\t-y <margin %> ->Pick the sample size for the given 95% confidence margin instead of -z\n";
+    std::cerr << "\t-h <path to bridging fault list> ->Grade \"<net> <net> <type>\" bridging faults (0 = wired-AND, 1 = wired-OR, 2 = first net dominates) with -s or -t\n";
+    std::cerr << "\t-C <path to checkpoint> ->Checkpoint random pattern grading every few seconds (with -a, one file per netlist)\n";
+    std::cerr << "\t-R\t->Resume random pattern grading from the checkpoint given with -C\n";
+    std::cerr << "\t-S <path to stats file> ->Write per vector timing and engine counters of random pattern grading or a test set (.json => JSON, CSV otherwise)\n";
+    std::cerr << "\t-b <path to vector pairs> ->Grade transition faults on \"<initial vector> <launch vector>\" lines (fault type 0 = slow-to-rise, 1 = slow-to-fall)\n";
     std::cerr << "Example Usage:\n";
     std::cerr << "\t To run all tests for coverage stats: <exe> -a -d <path_to_netlist_dir>\n";
     std::cerr << "\t To run single netlist with all faults: <exe> -f <path_to_netlist> -t <test_vector> -l\n";
     std::cerr << "\t To run single netlist with custom faults: <exe> -f <path_to_netlist> -t <test_vector> -p <path_to_fault_list>\n";
+    std::cerr << "\t To write the fault dictionary of a test set: <exe> -f <path_to_netlist> -l -s <path_to_test_set> -w <path_to_dictionary>\n";
+    std::cerr << "\t To diagnose a failing device: <exe> -r <path_to_dictionary> -g <path_to_failing_log>\n";
+    std::cerr << "\t To compact a test set: <exe> -f <path_to_netlist> -l -s <path_to_test_set> -x <path_to_compacted_set>\n";
+    std::cerr << "\t To estimate coverage from a fault sample: <exe> -f <path_to_netlist> -l -s <path_to_test_set> -y 1\n";
+    std::cerr << "\t To grade transition faults with vector pairs: <exe> -f <path_to_netlist> -l -b <path_to_vector_pairs>\n";
+    std::cerr << "\t To grade bridging faults with a test set: <exe> -f <path_to_netlist> -h <path_to_bridging_fault_list> -s <path_to_test_set>\n";
+    std::cerr << "\t To resume an interrupted random pattern grading: <exe> -f <path_to_netlist> -l -n <vectors> -C <path_to_checkpoint> -R\n";
+    std::cerr << "\t To compare engines per vector: <exe> -f <path_to_netlist> -l -n <vectors> -e concurrent -S <path_to_stats.csv>\n";
+    std::cerr << "\t To grade LFSR patterns on a single netlist: <exe> -f <path_to_netlist> -l -m lfsr -n <vectors> -v <coverage>\n";
 }
 
 int main(int argc, char* argv[])
 {
+    SimOptions options;
+
+    // Fault simulation engine to use
+    options.engineName = "deductive";
+    if (checkCommandLineOption(argc, argv, "-e"))
+    {
+        options.engineName = getCommandLineOption(argc, argv, "-e");
+    }
+
+    // Compaction needs batched simulation => pattern parallel engine unless selected
+    if (checkCommandLineOption(argc, argv, "-x") && checkCommandLineOption(argc, argv, "-e") == false)
+    {
+        options.engineName = "ppsfp";
+    }
+
+    // Number of threads for fault partitioned simulation
+    options.numThreads = 1;
+    if (checkCommandLineOption(argc, argv, "-j"))
+    {
+        options.numThreads = str_to_int(getCommandLineOption(argc, argv, "-j"));
+        // only the concurrent engine can be partitioned
+        if (checkCommandLineOption(argc, argv, "-e") == false)
+        {
+            options.engineName = "concurrent";
+        }
+        if (options.numThreads < 0 || options.engineName.compare("concurrent") != 0)
+        {
+            printUsage();
+            return -1;
+        }
+    }
+
+    // Number of processes for fault partitioned simulation
+    options.numProcesses = 1;
+    if (checkCommandLineOption(argc, argv, "-P"))
+    {
+        options.numProcesses = str_to_int(getCommandLineOption(argc, argv, "-P"));
+        // only the concurrent engine can be partitioned, either across threads or processes
+        if (checkCommandLineOption(argc, argv, "-e") == false)
+        {
+            options.engineName = "concurrent";
+        }
+        if (options.numProcesses < 0 || options.engineName.compare("concurrent") != 0 ||
+            checkCommandLineOption(argc, argv, "-j"))
+        {
+            printUsage();
+            return -1;
+        }
+    }
+
+    // Fault collapsing mode
+    if (checkCommandLineOption(argc, argv, "-c"))
+    {
+        options.collapseMode = getCommandLineOption(argc, argv, "-c");
+        if (options.collapseMode.compare("eq") != 0 && options.collapseMode.compare("dom") != 0)
+        {
+            printUsage();
+            return -1;
+        }
+    }
+
+    // Fault dictionary output
+    options.dictionaryPerOutput = checkCommandLineOption(argc, argv, "-o");
+    if (checkCommandLineOption(argc, argv, "-w"))
+    {
+        options.dictionaryPath = getCommandLineOption(argc, argv, "-w");
+        // dictionary is written over the complete fault list of a test set
+        if (checkCommandLineOption(argc, argv, "-s") == false ||
+            checkCommandLineOption(argc, argv, "-c"))
+        {
+            printUsage();
+            return -1;
+        }
+    }
+    else if (options.dictionaryPerOutput)
+    {
+        printUsage();
+        return -1;
+    }
+
+    // Random pattern generation and stop conditions
+    options.patternSource = "random";
+    if (checkCommandLineOption(argc, argv, "-m"))
+    {
+        options.patternSource = getCommandLineOption(argc, argv, "-m");
+    }
+    options.maxVectors = 101;
+    if (checkCommandLineOption(argc, argv, "-n"))
+    {
+        options.maxVectors = str_to_int(getCommandLineOption(argc, argv, "-n"));
+    }
+    options.targetCoverage = 0;
+    if (checkCommandLineOption(argc, argv, "-v"))
+    {
+        options.targetCoverage = std::stof(getCommandLineOption(argc, argv, "-v"));
+    }
+    options.plateauVectors = 0;
+    if (checkCommandLineOption(argc, argv, "-u"))
+    {
+        options.plateauVectors = str_to_int(getCommandLineOption(argc, argv, "-u"));
+    }
+    options.detectionLimit = 1;
+    options.sampledFrom = 0;
+
+    // Checkpointing of random pattern grading
+    options.checkpointPath = getCommandLineOption(argc, argv, "-C");
+    options.resumeRun = checkCommandLineOption(argc, argv, "-R");
+    if ((options.resumeRun && options.checkpointPath.empty()) ||
+        (checkCommandLineOption(argc, argv, "-C") && options.checkpointPath.empty()) ||
+        (options.checkpointPath.empty() == false &&
+        (checkCommandLineOption(argc, argv, "-t") || checkCommandLineOption(argc, argv, "-s") ||
+        checkCommandLineOption(argc, argv, "-b") || checkCommandLineOption(argc, argv, "-h") ||
+        checkCommandLineOption(argc, argv, "-g"))))
+    {
+        // only random pattern grading is checkpointed
+        printUsage();
+        return -1;
+    }
+
+    // Per vector instrumentation of random pattern grading and test set runs (closed on exit)
+    SimulationStatsWriter statsWriter;
+    options.statsWriter = NULL;
+    if (checkCommandLineOption(argc, argv, "-S"))
+    {
+        std::string statsPath = getCommandLineOption(argc, argv, "-S");
+        if (statsPath.empty() || checkCommandLineOption(argc, argv, "-t") ||
+            checkCommandLineOption(argc, argv, "-b") || checkCommandLineOption(argc, argv, "-h") ||
+            checkCommandLineOption(argc, argv, "-g") || checkCommandLineOption(argc, argv, "-w"))
+        {
+            printUsage();
+            return -1;
+        }
+        if (statsWriter.open(statsPath) == false)
+        {
+            return -1;
+        }
+        options.statsWriter = &statsWriter;
+    }
+
+    if (checkCommandLineOption(argc, argv, "-q"))
+    {
+        options.detectionLimit = str_to_int(getCommandLineOption(argc, argv, "-q"));
+    }
+    if (options.maxVectors < 0 || options.plateauVectors < 0 ||
+        options.detectionLimit < 1 || options.detectionLimit > 255)
+    {
+        printUsage();
+        return -1;
+    }
+
+    // if diagnosis selected, only the dictionary and the log are needed
+    if (checkCommandLineOption(argc, argv, "-g"))
+    {
+        if (checkCommandLineOption(argc, argv, "-r") == false ||
+            checkCommandLineOption(argc, argv, "-a") ||
+            checkCommandLineOption(argc, argv, "-f"))
+        {
+            printUsage();
+            return -1;
+        }
+        int maxCandidates = 10;
+        if (checkCommandLineOption(argc, argv, "-k"))
+        {
+            maxCandidates = str_to_int(getCommandLineOption(argc, argv, "-k"));
+        }
+        if (run_diagnosis(getCommandLineOption(argc, argv, "-r"),
+            getCommandLineOption(argc, argv, "-g"), maxCandidates) == false)
+        {
+            std::cerr << "Unable to diagnose. Check dictionary and failing log. Exiting\n";
+            return -1;
+        }
+    }
     // if run all selected for coverage analysis
-    if (checkCommandLineOption(argc, argv, "-a"))
+    else if (checkCommandLineOption(argc, argv, "-a"))
     {
         // then it cannot take file specific inputs
         if (checkCommandLineOption(argc, argv, "-f") ||
             checkCommandLineOption(argc, argv, "-l") ||
             checkCommandLineOption(argc, argv, "-p") ||
-            checkCommandLineOption(argc, argv, "-t"))
+            checkCommandLineOption(argc, argv, "-t") ||
+            checkCommandLineOption(argc, argv, "-b") ||
+            checkCommandLineOption(argc, argv, "-h") ||
+            checkCommandLineOption(argc, argv, "-s"))
         {
             printUsage();
             return -1;
@@ -193,21 +1647,57 @@ int main(int argc, char* argv[])
         }
 
         // if all inputs are correct
-        run_all(getCommandLineOption(argc, argv, "-d"));
+        run_all(getCommandLineOption(argc, argv, "-d"), options);
     }
     else
     {
         // => run on specific netlist
+        // random pattern grading if neither input vector nor test set given
+        bool randomPatterns = (checkCommandLineOption(argc, argv, "-m") ||
+            checkCommandLineOption(argc, argv, "-n"));
+        int numPatternInputs = checkCommandLineOption(argc, argv, "-t") +
+            checkCommandLineOption(argc, argv, "-s") + checkCommandLineOption(argc, argv, "-b");
         if (checkCommandLineOption(argc, argv, "-f") == false ||
-            checkCommandLineOption(argc, argv, "-t") == false)
+            numPatternInputs > 1 || (numPatternInputs == 0 && randomPatterns == false))
         {
-            // no input netlist path provided or input vector
+            // no input netlist path provided or not exactly one of input vector, test set and pattern source
             printUsage();
             return -1;
         }
         std::string netlistPath = getCommandLineOption(argc, argv, "-f");
         std::string testVector = getCommandLineOption(argc, argv, "-t");
 
+        // Grade bridging faults if a bridging fault list provided
+        if (checkCommandLineOption(argc, argv, "-h"))
+        {
+            // bridges replace the stuck-at fault list and its options
+            if (numPatternInputs == 0 || checkCommandLineOption(argc, argv, "-b") ||
+                checkCommandLineOption(argc, argv, "-l") || checkCommandLineOption(argc, argv, "-p") ||
+                checkCommandLineOption(argc, argv, "-z") || checkCommandLineOption(argc, argv, "-y") ||
+                checkCommandLineOption(argc, argv, "-x") || options.dictionaryPath.empty() == false ||
+                options.collapseMode.empty() == false || options.detectionLimit != 1)
+            {
+                printUsage();
+                return -1;
+            }
+            std::vector<std::string> testVectors(1, testVector);
+            if (checkCommandLineOption(argc, argv, "-s"))
+            {
+                testVectors.clear();
+                if (read_test_set(getCommandLineOption(argc, argv, "-s"), testVectors) == false)
+                {
+                    std::cerr << "Unable to read test set. Exiting\n";
+                    return -1;
+                }
+            }
+            if (run_bridging_faults(netlistPath, getCommandLineOption(argc, argv, "-h"), testVectors) == false)
+            {
+                std::cerr << "Unable to grade bridging faults. Check netlist, fault list and test vectors. Exiting\n";
+                return -1;
+            }
+            return 0;
+        }
+
         bool activateFaultsOnAllNodes = false;
         std::string faultListPath = "";
 
@@ -243,29 +1733,162 @@ int main(int argc, char* argv[])
         }
 
         // Apply fault list if custom fault list provided
+        std::vector<std::pair<int, int>> faultList;
         if (activateFaultsOnAllNodes == false)
         {
             std::ifstream infile(faultListPath);
             int nodeName, faultType;
             while (infile >> nodeName >> faultType)
             {
-                testCkt.apply_fault(nodeName, faultType);
+                faultList.push_back(std::make_pair(nodeName, faultType));
+            }
+        }
+
+        // Replace the faults by a uniform sample of them
+        if (checkCommandLineOption(argc, argv, "-z") || checkCommandLineOption(argc, argv, "-y"))
+        {
+            if (checkCommandLineOption(argc, argv, "-t") ||
+                (checkCommandLineOption(argc, argv, "-z") && checkCommandLineOption(argc, argv, "-y")) ||
+                options.dictionaryPath.empty() == false || options.collapseMode.empty() == false)
+            {
+                printUsage();
+                return -1;
+            }
+            long long populationSize = activateFaultsOnAllNodes ?
+                2LL * testCkt.get_node_list().size() : faultList.size();
+            long long sampleSize = 0;
+            if (checkCommandLineOption(argc, argv, "-z"))
+            {
+                sampleSize = std::stoll(getCommandLineOption(argc, argv, "-z"));
+            }
+            else
+            {
+                double marginPercent = std::stod(getCommandLineOption(argc, argv, "-y"));
+                if (marginPercent <= 0)
+                {
+                    printUsage();
+                    return -1;
+                }
+                sampleSize = get_sample_size(marginPercent, populationSize);
+            }
+            if (sampleSize <= 0)
+            {
+                printUsage();
+                return -1;
+            }
+            sampleSize = std::min(sampleSize, populationSize);
+            faultList = sample_faults(testCkt, activateFaultsOnAllNodes, faultList, sampleSize);
+            // sampled faults are injected one by one through apply_fault
+            activateFaultsOnAllNodes = false;
+            options.sampledFrom = populationSize;
+            std::cout << "Fault sampling: " << sampleSize << " of " << populationSize << " faults\n";
+        }
+
+        // Grade patterns of the pattern source
+        if (numPatternInputs == 0)
+        {
+            std::cout << "Test vectors run \tFault Coverage %\n";
+            if (grade_random_patterns(netlistPath, activateFaultsOnAllNodes, faultList, options, NULL) == false)
+            {
+                std::cerr << "Unable to grade random patterns. Check netlist and pattern source. Exiting\n";
+                return -1;
+            }
+            return 0;
+        }
+
+        // Grade transition faults if vector pairs provided
+        if (checkCommandLineOption(argc, argv, "-b"))
+        {
+            // pairs are only graded by the pattern parallel engine over the complete fault list
+            if (options.dictionaryPath.empty() == false || options.collapseMode.empty() == false ||
+                checkCommandLineOption(argc, argv, "-x"))
+            {
+                printUsage();
+                return -1;
+            }
+            std::vector<std::pair<std::string, std::string>> vectorPairs;
+            if (read_vector_pairs(getCommandLineOption(argc, argv, "-b"), vectorPairs) == false)
+            {
+                std::cerr << "Unable to read vector pairs. Exiting\n";
+                return -1;
+            }
+            if (run_vector_pairs(netlistPath, activateFaultsOnAllNodes, faultList, vectorPairs, options) == false)
+            {
+                std::cerr << "Unable to grade vector pairs. Check netlist and vector pairs. Exiting\n";
+                return -1;
+            }
+            return 0;
+        }
+
+        // Grade the test set if provided
+        if (checkCommandLineOption(argc, argv, "-s"))
+        {
+            std::vector<std::string> testVectors;
+            if (read_test_set(getCommandLineOption(argc, argv, "-s"), testVectors) == false)
+            {
+                std::cerr << "Unable to read test set. Exiting\n";
+                return -1;
+            }
+
+            // Compact the test set first if requested
+            if (checkCommandLineOption(argc, argv, "-x"))
+            {
+                int numIterations = 0;
+                if (checkCommandLineOption(argc, argv, "-i"))
+                {
+                    numIterations = str_to_int(getCommandLineOption(argc, argv, "-i"));
+                }
+                std::string compactedPath = getCommandLineOption(argc, argv, "-x");
+                if (compact_test_set(netlistPath, activateFaultsOnAllNodes, faultList, testVectors,
+                    options, numIterations) == false ||
+                    write_test_set(compactedPath, testVectors) == false)
+                {
+                    std::cerr << "Unable to compact test set. Check netlist and test set. Exiting\n";
+                    return -1;
+                }
+                std::cout << "Compacted test set written to: " << compactedPath << "\n";
+            }
+
+            if (run_test_set(netlistPath, activateFaultsOnAllNodes, faultList, testVectors, options) == false)
+            {
+                std::cerr << "Unable to grade test set. Check netlist and test set. Exiting\n";
+                return -1;
             }
+            return 0;
+        }
+
+        LevelizedCircuit topology;
+        FaultSimEngine* engine = setup_engine(options, netlistPath, activateFaultsOnAllNodes,
+            faultList, topology, false);
+        if (engine == NULL)
+        {
+            std::cerr << "Unable to set up fault simulation. Check netlist and engine. Exiting\n";
+            return -1;
         }
 
         // Apply the test vector
-        if (testCkt.apply_test_vector(testVector) == false)
+        if (engine->apply_test_vector(testVector) == false)
         {
             // unable to apply test vectors
             std::cerr << "Unable to apply test vector. Checking inputs. Exiting\n";
+            delete engine;
             return -1;
         }
-        std::cout << "Output Vector is " << testCkt.get_output_vector_lin() << "\n";
+        std::set<std::pair<int, int>> detectedFaults = engine->get_list_detected_faults();
+        std::cout << "Output Vector is " << engine->get_output_vector_lin() << "\n";
         std::cout << "Faults detected:\n";
-        testCkt.print_detectable_faults();
+        for (std::pair<int, int> fault : detectedFaults)
+        {
+            std::cout << fault.first << " stuck at " << fault.second << "\n";
+        }
         std::cout << "\n";
         std::cout << "Coverage Statistics:\n";
-        testCkt.print_fault_converage();
+        std::cout << "Total nodes in circuit:" << testCkt.get_node_list().size() << "\n";
+        std::cout << "Total faults in circuit:" << engine->get_total_faults_count() << "\n";
+        std::cout << "Total faults detected: " << detectedFaults.size() << "\n";
+        float coverageValue = detectedFaults.size() * 100.0 / engine->get_total_faults_count();
+        std::cout << "Coverage percentage:" << coverageValue << "%\n";
+        delete engine;
     }
     return 0;
 }
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <algorithm>
+#include "DeductiveFaultSim.h"
+#include "Circuit.h"
+
+/*
+* Constructor for the class
+* @param inNetlistPath -> location of the netlist
+* @param inActivateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+* @param inFaultList -> faults to apply if not activated on all nodes
+*/
+DeductiveFaultSim::DeductiveFaultSim(std::string inNetlistPath, bool inActivateFaultsOnAllNodes,
+    std::vector<std::pair<int, int>> inFaultList) :
+    netlistPath(inNetlistPath), activateFaultsOnAllNodes(inActivateFaultsOnAllNodes),
+    faultList(inFaultList), totalFaults(0), simulationStats() {}
+
+/*
+* Function to apply the test vector and grade the faults
+* @param testVector -> test vector applied
+* @return bool -> if test vector applied successfully
+*/
+bool DeductiveFaultSim::apply_test_vector(std::string testVector)
+{
+    // Node values can only be set once => new circuit per test vector
+    Circuit testCkt;
+    if (testCkt.read_netlist(this->netlistPath, this->activateFaultsOnAllNodes) == false)
+    {
+        return false;
+    }
+    for (std::pair<int, int> fault : this->faultList)
+    {
+        testCkt.apply_fault(fault.first, fault.second);
+    }
+    if (testCkt.apply_test_vector(testVector) == false)
+    {
+        return false;
+    }
+    this->outputVector = testCkt.get_output_vector_lin();
+    this->detectedFaults = testCkt.get_list_detected_faults();
+    this->totalFaults = testCkt.get_total_faults_count();
+
+    // Every gate is evaluated once and merges the lists of its inputs
+    for (Gate* currGate : testCkt.get_gate_list())
+    {
+        ++this->simulationStats.gatesEvaluated;
+        this->simulationStats.listOperations += currGate->get_input1()->get_deductive_fault_list_size();
+        if (currGate->is_single_input() == false)
+        {
+            this->simulationStats.listOperations += currGate->get_input2()->get_deductive_fault_list_size();
+        }
+    }
+    this->simulationStats.numLists = 0;
+    this->simulationStats.listEntries = 0;
+    this->simulationStats.maxListLength = 0;
+    for (int nodeName : testCkt.get_node_list())
+    {
+        int listLength = testCkt.get_node_from_name(nodeName)->get_deductive_fault_list_size();
+        ++this->simulationStats.numLists;
+        this->simulationStats.listEntries += listLength;
+        this->simulationStats.maxListLength = std::max(this->simulationStats.maxListLength, listLength);
+    }
+    // no fault dropping => every fault is graded again by the next run
+    this->simulationStats.activeFaults = this->totalFaults;
+    return true;
+}
+
+/*
+* Function to get the output vector of the good circuit
+* @return string -> output vector for the last test vector
+*/
+std::string DeductiveFaultSim::get_output_vector_lin()
+{
+    return this->outputVector;
+}
+
+/*
+* Function to get the faults detected by the last test vector
+* @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+*/
+std::set<std::pair<int, int>> DeductiveFaultSim::get_list_detected_faults()
+{
+    return this->detectedFaults;
+}
+
+/*
+* Function to get total faults graded by the engine
+* @return int -> total faults
+*/
+int DeductiveFaultSim::get_total_faults_count()
+{
+    return this->totalFaults;
+}
+
+/*
+* Function to get the work counters of the engine, for instrumentation
+* @param stats -> counters and fault list sizes of the last run (updated in place)
+* @return bool -> always true
+*/
+bool DeductiveFaultSim::get_simulation_stats(SimulationStats& stats)
+{
+    stats = this->simulationStats;
+    return true;
+}
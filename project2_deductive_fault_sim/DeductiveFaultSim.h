@@ -0,0 +1,82 @@
+#ifndef __DEDUCTIVEFAULTSIM_H__
+#define __DEDUCTIVEFAULTSIM_H__
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include "FaultSimEngine.h"
+
+/*
+* Deductive fault simulation engine
+* Wraps the Circuit flow: the netlist is read again for every test vector and
+* the fault lists are rebuilt from scratch by Circuit::apply_test_vector
+*/
+class DeductiveFaultSim : public FaultSimEngine
+{
+    // Path of the netlist to simulate
+    std::string netlistPath;
+
+    // Activate the s-a-0 and s-a-1 faults on all nodes
+    bool activateFaultsOnAllNodes;
+
+    // Faults applied through Circuit::apply_fault when not all nodes are faulty
+    std::vector<std::pair<int, int>> faultList;
+
+    // Output vector of the last run
+    std::string outputVector;
+
+    // Faults detected in the last run
+    std::set<std::pair<int, int>> detectedFaults;
+
+    // Total faults in the circuit
+    int totalFaults;
+
+    // Work counters since construction and fault list sizes of the last run
+    SimulationStats simulationStats;
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inNetlistPath -> location of the netlist
+    * @param inActivateFaultsOnAllNodes -> activate the s-a-0 and s-a-1 faults on all nodes
+    * @param inFaultList -> faults to apply if not activated on all nodes
+    */
+    DeductiveFaultSim(std::string inNetlistPath, bool inActivateFaultsOnAllNodes,
+        std::vector<std::pair<int, int>> inFaultList);
+
+    /*
+    * Function to apply the test vector and grade the faults
+    * @param testVector -> test vector applied
+    * @return bool -> if test vector applied successfully
+    */
+    bool apply_test_vector(std::string testVector) override;
+
+    /*
+    * Function to get the output vector of the good circuit
+    * @return string -> output vector for the last test vector
+    */
+    std::string get_output_vector_lin() override;
+
+    /*
+    * Function to get the faults detected by the last test vector
+    * @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+    */
+    std::set<std::pair<int, int>> get_list_detected_faults() override;
+
+    /*
+    * Function to get total faults graded by the engine
+    * @return int -> total faults
+    */
+    int get_total_faults_count() override;
+
+    /*
+    * Function to get the work counters of the engine, for instrumentation
+    * @param stats -> counters and fault list sizes of the last run (updated in place)
+    * @return bool -> always true
+    */
+    bool get_simulation_stats(SimulationStats& stats) override;
+};
+
+#endif
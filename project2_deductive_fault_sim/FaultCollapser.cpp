@@ -0,0 +1,245 @@
+#include "FaultCollapser.h"
+
+/*
+* Constructor for the class
+* Builds the equivalence classes and, optionally, prunes dominating classes
+* @param topology -> levelized circuit with the complete fault universe
+* @param useDominance -> also drop classes dominated by a gate input fault
+*/
+FaultCollapser::FaultCollapser(LevelizedCircuit& topology, bool useDominance)
+{
+    this->faultList = topology.faultList;
+    int numFaults = this->faultList.size();
+    for (int i = 0; i < numFaults; ++i)
+    {
+        this->parentFault.push_back(i);
+    }
+
+    // Node index and stuck value to fault index (-1 if fault not in list)
+    std::vector<int> faultOnNode(2 * topology.get_num_nodes(), -1);
+    for (int i = 0; i < numFaults; ++i)
+    {
+        faultOnNode[2 * topology.faultNode[i] + this->faultList[i].second] = i;
+    }
+
+    // Gate input faults can only be collapsed into the output of the single gate they feed
+    std::vector<std::pair<int, int>> dominanceEdges;
+    for (const LevelizedGate& currGate : topology.gates)
+    {
+        if (currGate.input1 == currGate.input2)
+        {
+            continue;
+        }
+        int inputs[] = { currGate.input1, currGate.input2 };
+        for (int input : inputs)
+        {
+            if (input == -1 ||
+                topology.fanoutGates[input].size() != 1 ||
+                topology.isOutput[input])
+            {
+                continue;
+            }
+            int inputSA0 = faultOnNode[2 * input];
+            int inputSA1 = faultOnNode[2 * input + 1];
+            int outputSA0 = faultOnNode[2 * currGate.output];
+            int outputSA1 = faultOnNode[2 * currGate.output + 1];
+            switch (currGate.logic)
+            {
+            case(and_l):
+                this->merge_faults(inputSA0, outputSA0);
+                dominanceEdges.push_back(std::make_pair(outputSA1, inputSA1));
+                break;
+            case(nand_l):
+                this->merge_faults(inputSA0, outputSA1);
+                dominanceEdges.push_back(std::make_pair(outputSA0, inputSA1));
+                break;
+            case(or_l):
+                this->merge_faults(inputSA1, outputSA1);
+                dominanceEdges.push_back(std::make_pair(outputSA0, inputSA0));
+                break;
+            case(nor_l):
+                this->merge_faults(inputSA1, outputSA0);
+                dominanceEdges.push_back(std::make_pair(outputSA1, inputSA0));
+                break;
+            case(not_l):
+                this->merge_faults(inputSA0, outputSA1);
+                this->merge_faults(inputSA1, outputSA0);
+                break;
+            case(buf_l):
+                this->merge_faults(inputSA0, outputSA0);
+                this->merge_faults(inputSA1, outputSA1);
+                break;
+            default:
+                // no structural equivalence through xor/xnor
+                break;
+            }
+        }
+    }
+
+    // Number the classes in order of their smallest fault index
+    std::vector<int> rootClass(numFaults, -1);
+    this->faultClass.assign(numFaults, -1);
+    for (int i = 0; i < numFaults; ++i)
+    {
+        int rootFault = this->find_root(i);
+        if (rootClass[rootFault] == -1)
+        {
+            rootClass[rootFault] = this->classMembers.size();
+            this->classMembers.push_back(std::vector<int>());
+        }
+        this->faultClass[i] = rootClass[rootFault];
+        this->classMembers[rootClass[rootFault]].push_back(i);
+    }
+    this->classDropped.assign(this->classMembers.size(), false);
+    this->dominatedClasses.assign(this->classMembers.size(), std::vector<int>());
+
+    if (useDominance)
+    {
+        // dominance follows fanout free chains towards the inputs => no cycles
+        for (std::pair<int, int> edge : dominanceEdges)
+        {
+            if (edge.first == -1 || edge.second == -1)
+            {
+                continue;
+            }
+            int dominatingClass = this->faultClass[edge.first];
+            int dominatedClass = this->faultClass[edge.second];
+            if (dominatingClass != dominatedClass)
+            {
+                this->classDropped[dominatingClass] = true;
+                this->dominatedClasses[dominatingClass].push_back(dominatedClass);
+            }
+        }
+    }
+}
+
+/*
+* Function to find the union-find root of a fault
+* @param faultIndex -> index of fault
+* @return int -> root fault index
+*/
+int FaultCollapser::find_root(int faultIndex)
+{
+    while (this->parentFault[faultIndex] != faultIndex)
+    {
+        // path halving
+        this->parentFault[faultIndex] = this->parentFault[this->parentFault[faultIndex]];
+        faultIndex = this->parentFault[faultIndex];
+    }
+    return faultIndex;
+}
+
+/*
+* Function to merge the equivalence classes of two faults
+* @param faultIndex1 -> index of first fault (-1 if not in fault list)
+* @param faultIndex2 -> index of second fault (-1 if not in fault list)
+*/
+void FaultCollapser::merge_faults(int faultIndex1, int faultIndex2)
+{
+    if (faultIndex1 == -1 || faultIndex2 == -1)
+    {
+        return;
+    }
+    int root1 = this->find_root(faultIndex1);
+    int root2 = this->find_root(faultIndex2);
+    // keep the smaller index as root => representative is the first fault of the class
+    if (root1 < root2)
+    {
+        this->parentFault[root2] = root1;
+    }
+    else if (root2 < root1)
+    {
+        this->parentFault[root1] = root2;
+    }
+}
+
+/*
+* Function to get the faults to simulate, one per kept class
+* @return vector of pairs -> representative faults
+*/
+std::vector<std::pair<int, int>> FaultCollapser::get_representative_faults()
+{
+    std::vector<std::pair<int, int>> representativeFaults;
+    for (unsigned int i = 0; i < this->classMembers.size(); ++i)
+    {
+        if (this->classDropped[i] == false)
+        {
+            representativeFaults.push_back(this->faultList[this->classMembers[i].front()]);
+        }
+    }
+    return representativeFaults;
+}
+
+/*
+* Function to expand detected representatives to the complete fault list
+* Dropped classes count as detected when a class they dominate is detected,
+* otherwise they count as undetected even if a vector detects them
+* @param detectedFaults -> detected representative faults
+* @return set of pairs -> detected faults of the complete fault list
+*/
+std::set<std::pair<int, int>> FaultCollapser::expand_detected_faults(const std::set<std::pair<int, int>>& detectedFaults)
+{
+    std::vector<bool> classDetected(this->classMembers.size(), false);
+    for (unsigned int i = 0; i < this->classMembers.size(); ++i)
+    {
+        if (this->classDropped[i] == false &&
+            detectedFaults.count(this->faultList[this->classMembers[i].front()]) > 0)
+        {
+            classDetected[i] = true;
+        }
+    }
+
+    // Infer the dropped classes until nothing changes (chains are short)
+    bool isChanged = true;
+    while (isChanged)
+    {
+        isChanged = false;
+        for (unsigned int i = 0; i < this->classMembers.size(); ++i)
+        {
+            if (classDetected[i])
+            {
+                continue;
+            }
+            for (int dominatedClass : this->dominatedClasses[i])
+            {
+                if (classDetected[dominatedClass])
+                {
+                    classDetected[i] = true;
+                    isChanged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::set<std::pair<int, int>> expandedFaults;
+    for (unsigned int i = 0; i < this->classMembers.size(); ++i)
+    {
+        if (classDetected[i])
+        {
+            for (int faultIndex : this->classMembers[i])
+            {
+                expandedFaults.insert(this->faultList[faultIndex]);
+            }
+        }
+    }
+    return expandedFaults;
+}
+
+/*
+* Function to get number of faults in the complete fault list
+* @return int -> total faults
+*/
+int FaultCollapser::get_total_faults_count()
+{
+    return this->faultList.size();
+}
+
+/*
+* Function to get number of equivalence classes
+* @return int -> number of classes
+*/
+int FaultCollapser::get_num_classes()
+{
+    return this->classMembers.size();
+}
@@ -0,0 +1,95 @@
+#ifndef __FAULTCOLLAPSER_H__
+#define __FAULTCOLLAPSER_H__
+
+#include <vector>
+#include <set>
+#include <utility>
+
+#include "LevelizedCircuit.h"
+
+/*
+* Class for structural fault collapsing
+* Faults are modelled on nodes, so a gate input fault is only equivalent to
+* (or dominated by) a gate output fault when the input node feeds that single
+* gate and is not a primary output.
+* Equivalence: AND/NAND input s-a-0, OR/NOR input s-a-1 and both INV/BUF input
+* faults are merged with the matching output fault.
+* Dominance: AND/NAND output s-a-1/s-a-0 and OR/NOR output s-a-0/s-a-1 are
+* detected by any test for the fanout free input s-a-1/s-a-0 => dropped.
+* A dropped class is never simulated, it only counts as detected through a
+* class it dominates, so the fault coverage with dominance is a lower bound
+* (a vector detecting only the dominant fault is missed).
+*/
+class FaultCollapser
+{
+    // Complete fault list, pair of entry => first = node name, second = fault type
+    std::vector<std::pair<int, int>> faultList;
+
+    // Union-find parent per fault index
+    std::vector<int> parentFault;
+
+    // Fault index to class index
+    std::vector<int> faultClass;
+
+    // Class index to fault indices in the class
+    std::vector<std::vector<int>> classMembers;
+
+    // Class index to whether the class is dropped by dominance
+    std::vector<bool> classDropped;
+
+    // Class index to classes whose detection implies detection of this class
+    std::vector<std::vector<int>> dominatedClasses;
+
+    /*
+    * Function to find the union-find root of a fault
+    * @param faultIndex -> index of fault
+    * @return int -> root fault index
+    */
+    int find_root(int faultIndex);
+
+    /*
+    * Function to merge the equivalence classes of two faults
+    * @param faultIndex1 -> index of first fault (-1 if not in fault list)
+    * @param faultIndex2 -> index of second fault (-1 if not in fault list)
+    */
+    void merge_faults(int faultIndex1, int faultIndex2);
+
+public:
+
+    /*
+    * Constructor for the class
+    * Builds the equivalence classes and, optionally, prunes dominating classes
+    * @param topology -> levelized circuit with the complete fault universe
+    * @param useDominance -> also drop classes dominated by a gate input fault
+    */
+    FaultCollapser(LevelizedCircuit& topology, bool useDominance);
+
+    /*
+    * Function to get the faults to simulate, one per kept class
+    * @return vector of pairs -> representative faults
+    */
+    std::vector<std::pair<int, int>> get_representative_faults();
+
+    /*
+    * Function to expand detected representatives to the complete fault list
+    * Dropped classes count as detected when a class they dominate is detected,
+    * otherwise they count as undetected even if a vector detects them
+    * @param detectedFaults -> detected representative faults
+    * @return set of pairs -> detected faults of the complete fault list
+    */
+    std::set<std::pair<int, int>> expand_detected_faults(const std::set<std::pair<int, int>>& detectedFaults);
+
+    /*
+    * Function to get number of faults in the complete fault list
+    * @return int -> total faults
+    */
+    int get_total_faults_count();
+
+    /*
+    * Function to get number of equivalence classes
+    * @return int -> number of classes
+    */
+    int get_num_classes();
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include "FaultDiagnoser.h"
+
+/*
+* Constructor for the class
+* @param inDictionary -> opened dictionary to query
+*/
+FaultDiagnoser::FaultDiagnoser(FaultDictionaryReader* inDictionary) :
+    dictionary(inDictionary), numConsistentFaults(0)
+{
+    for (unsigned int i = 0; i < this->dictionary->outputNames.size(); ++i)
+    {
+        this->outputPositions.push_back(std::make_pair(this->dictionary->outputNames[i], i));
+    }
+    std::sort(this->outputPositions.begin(), this->outputPositions.end());
+}
+
+/*
+* Function to get the position of an output in the dictionary lists
+* @param outputName -> name of the output node
+* @return int -> position, -1 if not an output of the dictionary
+*/
+int FaultDiagnoser::get_output_position(int outputName)
+{
+    std::vector<std::pair<int, int>>::iterator itr = std::lower_bound(this->outputPositions.begin(),
+        this->outputPositions.end(), std::make_pair(outputName, -1));
+    if (itr == this->outputPositions.end() || itr->first != outputName)
+    {
+        return -1;
+    }
+    return itr->second;
+}
+
+/*
+* Function to rank the candidate faults of a failing log
+* @param failures -> failing vectors and outputs of the device, a repeated observation counts once
+* @param maxCandidates -> number of best candidates to return
+* @param candidates -> candidates by decreasing match score (updated in place)
+* @return bool -> if the log matches the dictionary
+*/
+bool FaultDiagnoser::diagnose(const std::vector<FailingObservation>& failures, int maxCandidates,
+    std::vector<DiagnosisCandidate>& candidates)
+{
+    int numFaults = this->dictionary->faultList.size();
+    int numWords = (numFaults + 63) / 64;
+    bool perOutput = this->dictionary->is_per_output();
+
+    // Distinct failing observations, pair of vector index and list position
+    // a repeated log line would count the same failure twice and push passMiss below 0
+    std::set<std::pair<int, int>> observations;
+    for (const FailingObservation& failure : failures)
+    {
+        std::vector<int> listPositions;
+        if (perOutput)
+        {
+            for (int outputName : failure.outputNames)
+            {
+                int outputPosition = this->get_output_position(outputName);
+                if (outputPosition == -1)
+                {
+                    std::cerr << "Output " << outputName << " is not a primary output of the dictionary\n";
+                    return false;
+                }
+                listPositions.push_back(outputPosition);
+            }
+            if (listPositions.empty())
+            {
+                std::cerr << "Failing outputs missing for vector " << failure.vectorIndex << "\n";
+                return false;
+            }
+        }
+        else
+        {
+            listPositions.push_back(0);
+        }
+        for (int listPosition : listPositions)
+        {
+            observations.insert(std::make_pair(failure.vectorIndex, listPosition));
+        }
+    }
+
+    std::vector<int> failMatches(numFaults, 0);
+    std::vector<int> touchedFaults;
+    std::vector<uint64_t> consistentFaults(numWords, ~(uint64_t)0);
+    std::vector<uint64_t> observationFaults(numWords, 0);
+    int numObservedFails = 0;
+    std::vector<std::vector<int>> vectorLists;
+    int readVectorIndex = -1;
+    // vector order => each dictionary block is decoded once
+    for (const std::pair<int, int>& observation : observations)
+    {
+        if (observation.first != readVectorIndex)
+        {
+            if (this->dictionary->read_vector(observation.first, vectorLists) == false)
+            {
+                return false;
+            }
+            readVectorIndex = observation.first;
+        }
+
+        const std::vector<int>& faultIds = vectorLists[observation.second];
+        ++numObservedFails;
+        for (int faultId : faultIds)
+        {
+            if (failMatches[faultId]++ == 0)
+            {
+                touchedFaults.push_back(faultId);
+            }
+            observationFaults[faultId / 64] |= (uint64_t)1 << (faultId % 64);
+        }
+        // only faults failing every observation stay consistent
+        for (int i = 0; i < numWords; ++i)
+        {
+            consistentFaults[i] &= observationFaults[i];
+        }
+        for (int faultId : faultIds)
+        {
+            observationFaults[faultId / 64] = 0;
+        }
+    }
+
+    this->numConsistentFaults = 0;
+    if (numObservedFails > 0)
+    {
+        // bits past the last fault are never set by an observation
+        for (uint64_t word : consistentFaults)
+        {
+            this->numConsistentFaults += __builtin_popcountll(word);
+        }
+    }
+
+    // Score the faults failing at least one observation
+    candidates.clear();
+    for (int faultId : touchedFaults)
+    {
+        DiagnosisCandidate candidate;
+        candidate.faultId = faultId;
+        candidate.failMatch = failMatches[faultId];
+        candidate.failMiss = numObservedFails - candidate.failMatch;
+        candidate.passMiss = this->dictionary->detectionCounts[faultId] - candidate.failMatch;
+        candidate.matchScore = candidate.failMatch * 1.0f /
+            (candidate.failMatch + candidate.failMiss + candidate.passMiss);
+        candidates.push_back(candidate);
+    }
+    int numReturned = std::min<int>(std::max(maxCandidates, 0), candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + numReturned, candidates.end(),
+        [](const DiagnosisCandidate& cand1, const DiagnosisCandidate& cand2)
+        {
+            if (cand1.matchScore != cand2.matchScore)
+            {
+                return cand1.matchScore > cand2.matchScore;
+            }
+            if (cand1.failMatch != cand2.failMatch)
+            {
+                return cand1.failMatch > cand2.failMatch;
+            }
+            return cand1.faultId < cand2.faultId;
+        });
+    candidates.resize(numReturned);
+    return true;
+}
+
+/*
+* Function to get number of faults explaining every failure of the last query
+* @return int -> number of consistent faults
+*/
+int FaultDiagnoser::get_num_consistent_faults()
+{
+    return this->numConsistentFaults;
+}
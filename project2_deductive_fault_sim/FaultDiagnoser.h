@@ -0,0 +1,91 @@
+#ifndef __FAULTDIAGNOSER_H__
+#define __FAULTDIAGNOSER_H__
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "FaultDictionary.h"
+
+/*
+* Failing vector observed on the tester
+*/
+struct FailingObservation
+{
+    // Index of the vector in the dictionary
+    int vectorIndex;
+    // Names of the failing primary outputs (ignored for dictionaries without per output lists)
+    std::vector<int> outputNames;
+};
+
+/*
+* Candidate fault ranked by the diagnosis
+*/
+struct DiagnosisCandidate
+{
+    // Fault id in the dictionary
+    int faultId;
+    // Observations failing on the tester and in simulation
+    int failMatch;
+    // Observations failing on the tester but passing in simulation
+    int failMiss;
+    // Observations passing on the tester but failing in simulation
+    int passMiss;
+    // failMatch / (failMatch + failMiss + passMiss)
+    float matchScore;
+};
+
+/*
+* Class for dictionary based diagnosis of single stuck-at faults
+* The dictionary is the inverted index from an observation (vector, or
+* vector and output) to the faults failing it, so only the lists of the
+* failing observations are read. Fault signature sizes stored in the
+* dictionary index give the mismatches on passing observations without
+* reading them. Faults explaining every failure are found by intersecting
+* the fault bitmaps of the failing observations.
+*/
+class FaultDiagnoser
+{
+    // Dictionary to query
+    FaultDictionaryReader* dictionary;
+
+    // Output name to position in the dictionary output lists
+    std::vector<std::pair<int, int>> outputPositions;
+
+    // Number of faults explaining every failing observation of the last query
+    int numConsistentFaults;
+
+    /*
+    * Function to get the position of an output in the dictionary lists
+    * @param outputName -> name of the output node
+    * @return int -> position, -1 if not an output of the dictionary
+    */
+    int get_output_position(int outputName);
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inDictionary -> opened dictionary to query
+    */
+    FaultDiagnoser(FaultDictionaryReader* inDictionary);
+
+    /*
+    * Function to rank the candidate faults of a failing log
+    * @param failures -> failing vectors and outputs of the device, a repeated observation counts once
+    * @param maxCandidates -> number of best candidates to return
+    * @param candidates -> candidates by decreasing match score (updated in place)
+    * @return bool -> if the log matches the dictionary
+    */
+    bool diagnose(const std::vector<FailingObservation>& failures, int maxCandidates,
+        std::vector<DiagnosisCandidate>& candidates);
+
+    /*
+    * Function to get number of faults explaining every failure of the last query
+    * @return int -> number of consistent faults
+    */
+    int get_num_consistent_faults();
+};
+
+#endif
@@ -0,0 +1,507 @@
+#include <iostream>
+#include <cstring>
+#include "FaultDictionary.h"
+
+/*
+* Function to append an unsigned integer as little endian bytes
+* @param buffer -> byte buffer (updated in place)
+* @param value -> value to append
+* @param numBytes -> number of bytes to write
+*/
+static void put_fixed(std::vector<uint8_t>& buffer, uint64_t value, int numBytes)
+{
+    for (int i = 0; i < numBytes; ++i)
+    {
+        buffer.push_back((uint8_t)(value >> (8 * i)));
+    }
+}
+
+/*
+* Function to read a little endian unsigned integer
+* @param buffer -> byte buffer
+* @param position -> read position (updated in place)
+* @param numBytes -> number of bytes to read
+* @return uint64_t -> value read
+*/
+static uint64_t get_fixed(const std::vector<uint8_t>& buffer, size_t& position, int numBytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < numBytes; ++i)
+    {
+        value |= (uint64_t)buffer[position++] << (8 * i);
+    }
+    return value;
+}
+
+/*
+* Function to append an unsigned integer as a varint (7 bits per byte)
+* @param buffer -> byte buffer (updated in place)
+* @param value -> value to append
+*/
+static void put_varint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((uint8_t)value);
+}
+
+/*
+* Function to read a varint
+* @param buffer -> byte buffer
+* @param position -> read position (updated in place)
+* @param value -> value read (updated in place)
+* @return bool -> if the varint is complete
+*/
+static bool get_varint(const std::vector<uint8_t>& buffer, size_t& position, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && position < buffer.size(); shift += 7)
+    {
+        uint8_t currByte = buffer[position++];
+        value |= (uint64_t)(currByte & 0x7f) << shift;
+        if ((currByte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+* Function to get the number of bytes of a varint
+* @param value -> value to encode
+* @return int -> encoded size
+*/
+static int varint_size(uint64_t value)
+{
+    int numBytes = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        ++numBytes;
+    }
+    return numBytes;
+}
+
+/*
+* Constructor for the class
+*/
+FaultDictionaryWriter::FaultDictionaryWriter() :
+    numFaults(0), listsPerVector(1), vectorsPerBlock(1), numVectors(0), vectorsInBlock(0), fileOffset(0)
+{
+}
+
+/*
+* Function to create the dictionary file and write the header
+* @param filePath -> location of the dictionary
+* @param faultList -> fault table, pair of entry => first = node name, second = fault type
+* @param outputNames -> primary output node names
+* @param perOutput -> store one fault list per output instead of one per vector
+* @param inVectorsPerBlock -> vectors encoded per block
+* @return bool -> if created successfully
+*/
+bool FaultDictionaryWriter::open(std::string filePath, const std::vector<std::pair<int, int>>& faultList,
+    const std::vector<int>& outputNames, bool perOutput, int inVectorsPerBlock)
+{
+    if (inVectorsPerBlock < 1)
+    {
+        std::cerr << "Fault dictionary needs at least one vector per block\n";
+        return false;
+    }
+    this->outFileStream.open(filePath, std::ios::binary | std::ios::trunc);
+    if (this->outFileStream.is_open() == false)
+    {
+        std::cerr << "Unable to create fault dictionary: " << filePath << "\n";
+        return false;
+    }
+    this->numFaults = faultList.size();
+    this->listsPerVector = perOutput ? outputNames.size() : 1;
+    this->vectorsPerBlock = inVectorsPerBlock;
+    this->numVectors = 0;
+    this->vectorsInBlock = 0;
+    this->blockBuffer.clear();
+    this->blockIndex.clear();
+    this->detectionCounts.assign(this->numFaults, 0);
+
+    std::vector<uint8_t> header(faultDictionaryMagic, faultDictionaryMagic + 8);
+    put_fixed(header, faultDictionaryVersion, 4);
+    put_fixed(header, perOutput ? faultDictionaryPerOutput : 0, 4);
+    put_fixed(header, this->numFaults, 4);
+    put_fixed(header, outputNames.size(), 4);
+    put_fixed(header, this->vectorsPerBlock, 4);
+    for (std::pair<int, int> fault : faultList)
+    {
+        put_fixed(header, (uint32_t)fault.first, 4);
+        put_fixed(header, (uint32_t)fault.second, 4);
+    }
+    for (int outputName : outputNames)
+    {
+        put_fixed(header, (uint32_t)outputName, 4);
+    }
+    this->outFileStream.write((const char*)header.data(), header.size());
+    this->fileOffset = header.size();
+    return this->outFileStream.good();
+}
+
+/*
+* Function to encode one sorted fault id list into the block buffer
+* Gaps between ids are varint coded unless a bitmap over all faults is smaller
+* @param faultIds -> sorted unique fault ids
+*/
+void FaultDictionaryWriter::encode_list(const std::vector<int>& faultIds)
+{
+    size_t listBytes = 0;
+    int previousId = -1;
+    for (int faultId : faultIds)
+    {
+        listBytes += varint_size(faultId - previousId - 1);
+        previousId = faultId;
+    }
+    size_t bitmapBytes = (this->numFaults + 7) / 8;
+
+    if (bitmapBytes < listBytes)
+    {
+        put_varint(this->blockBuffer, ((uint64_t)faultIds.size() << 1) | 1);
+        size_t bitmapStart = this->blockBuffer.size();
+        this->blockBuffer.resize(bitmapStart + bitmapBytes, 0);
+        for (int faultId : faultIds)
+        {
+            this->blockBuffer[bitmapStart + faultId / 8] |= (uint8_t)(1 << (faultId % 8));
+        }
+        return;
+    }
+
+    put_varint(this->blockBuffer, (uint64_t)faultIds.size() << 1);
+    previousId = -1;
+    for (int faultId : faultIds)
+    {
+        put_varint(this->blockBuffer, faultId - previousId - 1);
+        previousId = faultId;
+    }
+}
+
+/*
+* Function to write the current block and add it to the index
+* @return bool -> if written successfully
+*/
+bool FaultDictionaryWriter::flush_block()
+{
+    if (this->vectorsInBlock == 0)
+    {
+        return true;
+    }
+    FaultDictionaryBlock currBlock;
+    currBlock.fileOffset = this->fileOffset;
+    currBlock.byteLength = this->blockBuffer.size();
+    currBlock.firstVector = this->numVectors - this->vectorsInBlock;
+    this->blockIndex.push_back(currBlock);
+
+    this->outFileStream.write((const char*)this->blockBuffer.data(), this->blockBuffer.size());
+    this->fileOffset += this->blockBuffer.size();
+    this->blockBuffer.clear();
+    this->vectorsInBlock = 0;
+    return this->outFileStream.good();
+}
+
+/*
+* Function to add the faults detected by the next vector
+* @param detectedFaults -> one sorted fault id list per output (or a single list)
+* @return bool -> if added successfully
+*/
+bool FaultDictionaryWriter::add_vector(const std::vector<std::vector<int>>& detectedFaults)
+{
+    if (this->outFileStream.is_open() == false || detectedFaults.size() != this->listsPerVector)
+    {
+        std::cerr << "Fault dictionary expects " << this->listsPerVector << " fault lists per vector\n";
+        return false;
+    }
+    for (const std::vector<int>& faultIds : detectedFaults)
+    {
+        this->encode_list(faultIds);
+        for (int faultId : faultIds)
+        {
+            ++this->detectionCounts[faultId];
+        }
+    }
+    ++this->numVectors;
+    ++this->vectorsInBlock;
+    if (this->vectorsInBlock == this->vectorsPerBlock)
+    {
+        return this->flush_block();
+    }
+    return true;
+}
+
+/*
+* Function to write the last block and the index
+* @return bool -> if written successfully
+*/
+bool FaultDictionaryWriter::close()
+{
+    if (this->outFileStream.is_open() == false)
+    {
+        return true;
+    }
+    bool isWritten = this->flush_block();
+
+    std::vector<uint8_t> indexBuffer;
+    put_fixed(indexBuffer, this->numVectors, 8);
+    put_fixed(indexBuffer, this->blockIndex.size(), 4);
+    for (const FaultDictionaryBlock& currBlock : this->blockIndex)
+    {
+        put_fixed(indexBuffer, currBlock.fileOffset, 8);
+        put_fixed(indexBuffer, currBlock.byteLength, 4);
+        put_fixed(indexBuffer, currBlock.firstVector, 4);
+    }
+    for (uint32_t detectionCount : this->detectionCounts)
+    {
+        put_fixed(indexBuffer, detectionCount, 4);
+    }
+    put_fixed(indexBuffer, this->fileOffset, 8);
+    indexBuffer.insert(indexBuffer.end(), faultDictionaryIndexMagic, faultDictionaryIndexMagic + 8);
+    this->outFileStream.write((const char*)indexBuffer.data(), indexBuffer.size());
+
+    isWritten = isWritten && this->outFileStream.good();
+    this->outFileStream.close();
+    return isWritten;
+}
+
+/*
+* Destructor for the class
+*/
+FaultDictionaryWriter::~FaultDictionaryWriter()
+{
+    this->close();
+}
+
+/*
+* Constructor for the class
+*/
+FaultDictionaryReader::FaultDictionaryReader() :
+    perOutput(false), vectorsPerBlock(1), numVectors(0), cachedBlock(-1)
+{
+}
+
+/*
+* Function to open the dictionary and read the header and index
+* @param filePath -> location of the dictionary
+* @return bool -> if opened successfully
+*/
+bool FaultDictionaryReader::open(std::string filePath)
+{
+    this->inFileStream.open(filePath, std::ios::binary);
+    if (this->inFileStream.is_open() == false)
+    {
+        std::cerr << "Unable to open fault dictionary: " << filePath << "\n";
+        return false;
+    }
+
+    // Fixed part of the header
+    std::vector<uint8_t> header(28);
+    this->inFileStream.read((char*)header.data(), header.size());
+    if (this->inFileStream.good() == false ||
+        std::memcmp(header.data(), faultDictionaryMagic, 8) != 0)
+    {
+        std::cerr << "Not a fault dictionary: " << filePath << "\n";
+        return false;
+    }
+    size_t position = 8;
+    uint32_t version = get_fixed(header, position, 4);
+    uint32_t flags = get_fixed(header, position, 4);
+    uint32_t numFaults = get_fixed(header, position, 4);
+    uint32_t numOutputs = get_fixed(header, position, 4);
+    this->vectorsPerBlock = get_fixed(header, position, 4);
+    if (version != faultDictionaryVersion || this->vectorsPerBlock == 0)
+    {
+        std::cerr << "Unsupported fault dictionary version: " << version << "\n";
+        return false;
+    }
+    this->perOutput = (flags & faultDictionaryPerOutput) != 0;
+
+    // Fault table and output names
+    std::vector<uint8_t> tables(8 * (size_t)numFaults + 4 * (size_t)numOutputs);
+    this->inFileStream.read((char*)tables.data(), tables.size());
+    if (this->inFileStream.good() == false)
+    {
+        std::cerr << "Truncated fault dictionary header\n";
+        return false;
+    }
+    position = 0;
+    this->faultList.clear();
+    for (uint32_t i = 0; i < numFaults; ++i)
+    {
+        int nodeName = (int)get_fixed(tables, position, 4);
+        int faultType = (int)get_fixed(tables, position, 4);
+        this->faultList.push_back(std::make_pair(nodeName, faultType));
+    }
+    this->outputNames.clear();
+    for (uint32_t i = 0; i < numOutputs; ++i)
+    {
+        this->outputNames.push_back((int)get_fixed(tables, position, 4));
+    }
+
+    // Trailer at the end of file points to the index
+    std::vector<uint8_t> trailer(16);
+    this->inFileStream.seekg(-16, std::ios::end);
+    this->inFileStream.read((char*)trailer.data(), trailer.size());
+    if (this->inFileStream.good() == false ||
+        std::memcmp(trailer.data() + 8, faultDictionaryIndexMagic, 8) != 0)
+    {
+        std::cerr << "Fault dictionary index missing (file not closed?)\n";
+        return false;
+    }
+    position = 0;
+    uint64_t indexOffset = get_fixed(trailer, position, 8);
+
+    std::vector<uint8_t> indexHeader(12);
+    this->inFileStream.seekg(indexOffset);
+    this->inFileStream.read((char*)indexHeader.data(), indexHeader.size());
+    position = 0;
+    this->numVectors = get_fixed(indexHeader, position, 8);
+    uint32_t numBlocks = get_fixed(indexHeader, position, 4);
+    std::vector<uint8_t> indexEntries(16 * (size_t)numBlocks + 4 * this->faultList.size());
+    this->inFileStream.read((char*)indexEntries.data(), indexEntries.size());
+    if (this->inFileStream.good() == false)
+    {
+        std::cerr << "Truncated fault dictionary index\n";
+        return false;
+    }
+    position = 0;
+    this->blockIndex.clear();
+    for (uint32_t i = 0; i < numBlocks; ++i)
+    {
+        FaultDictionaryBlock currBlock;
+        currBlock.fileOffset = get_fixed(indexEntries, position, 8);
+        currBlock.byteLength = get_fixed(indexEntries, position, 4);
+        currBlock.firstVector = get_fixed(indexEntries, position, 4);
+        this->blockIndex.push_back(currBlock);
+    }
+    this->detectionCounts.clear();
+    for (size_t i = 0; i < this->faultList.size(); ++i)
+    {
+        this->detectionCounts.push_back(get_fixed(indexEntries, position, 4));
+    }
+    this->cachedBlock = -1;
+    return true;
+}
+
+/*
+* Function to read and decode a block into the cache
+* @param blockNumber -> index of the block
+* @return bool -> if decoded successfully
+*/
+bool FaultDictionaryReader::load_block(int blockNumber)
+{
+    if (this->cachedBlock == blockNumber)
+    {
+        return true;
+    }
+    const FaultDictionaryBlock& currBlock = this->blockIndex[blockNumber];
+    std::vector<uint8_t> blockBuffer(currBlock.byteLength);
+    this->inFileStream.seekg(currBlock.fileOffset);
+    this->inFileStream.read((char*)blockBuffer.data(), blockBuffer.size());
+    if (this->inFileStream.good() == false)
+    {
+        std::cerr << "Unable to read fault dictionary block " << blockNumber << "\n";
+        return false;
+    }
+
+    uint64_t lastVector = (blockNumber + 1 < (int)this->blockIndex.size()) ?
+        this->blockIndex[blockNumber + 1].firstVector : this->numVectors;
+    size_t vectorsInBlock = lastVector - currBlock.firstVector;
+    size_t listsPerVector = this->perOutput ? this->outputNames.size() : 1;
+    size_t bitmapBytes = (this->faultList.size() + 7) / 8;
+
+    this->cachedBlock = -1;
+    this->cachedVectors.assign(vectorsInBlock, std::vector<std::vector<int>>(listsPerVector));
+    size_t position = 0;
+    for (size_t i = 0; i < vectorsInBlock; ++i)
+    {
+        for (size_t j = 0; j < listsPerVector; ++j)
+        {
+            std::vector<int>& faultIds = this->cachedVectors[i][j];
+            uint64_t listHeader;
+            if (get_varint(blockBuffer, position, listHeader) == false)
+            {
+                std::cerr << "Corrupt fault dictionary block " << blockNumber << "\n";
+                return false;
+            }
+            if (listHeader & 1)
+            {
+                if (position + bitmapBytes > blockBuffer.size())
+                {
+                    std::cerr << "Corrupt fault dictionary block " << blockNumber << "\n";
+                    return false;
+                }
+                for (size_t faultId = 0; faultId < this->faultList.size(); ++faultId)
+                {
+                    if (blockBuffer[position + faultId / 8] & (1 << (faultId % 8)))
+                    {
+                        faultIds.push_back(faultId);
+                    }
+                }
+                position += bitmapBytes;
+                continue;
+            }
+            uint64_t numIds = listHeader >> 1;
+            int previousId = -1;
+            for (uint64_t k = 0; k < numIds; ++k)
+            {
+                uint64_t gap;
+                if (get_varint(blockBuffer, position, gap) == false)
+                {
+                    std::cerr << "Corrupt fault dictionary block " << blockNumber << "\n";
+                    return false;
+                }
+                previousId += gap + 1;
+                faultIds.push_back(previousId);
+            }
+        }
+    }
+    this->cachedBlock = blockNumber;
+    return true;
+}
+
+/*
+* Function to get number of vectors
+* @return int -> number of vectors
+*/
+int FaultDictionaryReader::get_num_vectors()
+{
+    return this->numVectors;
+}
+
+/*
+* Function to check if the lists are stored per output
+* @return bool -> if stored per output
+*/
+bool FaultDictionaryReader::is_per_output()
+{
+    return this->perOutput;
+}
+
+/*
+* Function to read the faults detected by a vector
+* @param vectorIndex -> index of the vector
+* @param detectedFaults -> one sorted fault id list per output or a single list (updated in place)
+* @return bool -> if read successfully
+*/
+bool FaultDictionaryReader::read_vector(int vectorIndex, std::vector<std::vector<int>>& detectedFaults)
+{
+    if (vectorIndex < 0 || (uint64_t)vectorIndex >= this->numVectors)
+    {
+        std::cerr << "Vector " << vectorIndex << " not in fault dictionary\n";
+        return false;
+    }
+    // blocks hold vectorsPerBlock vectors except possibly the last one
+    int blockNumber = vectorIndex / this->vectorsPerBlock;
+    if (this->load_block(blockNumber) == false)
+    {
+        return false;
+    }
+    detectedFaults = this->cachedVectors[vectorIndex - this->blockIndex[blockNumber].firstVector];
+    return true;
+}
@@ -0,0 +1,219 @@
+#ifndef __FAULTDICTIONARY_H__
+#define __FAULTDICTIONARY_H__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <utility>
+
+/*
+* Binary fault dictionary
+* Holds, per test vector, the ids of the detected faults (optionally per
+* primary output). Fault ids index the fault table stored in the header.
+*
+* File layout (little endian):
+*   header  -> magic, version, flags, number of faults/outputs, vectors per
+*              block, fault table (node name, stuck at value), output names
+*   blocks  -> vectors encoded back to back, one list per vector (or one per
+*              output). A list is varint(count << 1 | isBitmap) followed by
+*              either the varint coded gaps between sorted ids or a bitmap
+*              over all faults, whichever is smaller
+*   index   -> number of vectors, number of blocks, per block the file
+*              offset, byte length and first vector, then per fault the
+*              number of lists holding it (its signature size)
+*   trailer -> file offset of index, index magic
+*/
+
+// Magic at the start of the dictionary
+const char faultDictionaryMagic[8] = { 'F', 'D', 'I', 'C', 'T', '0', '0', '1' };
+
+// Magic at the end of the dictionary
+const char faultDictionaryIndexMagic[8] = { 'F', 'D', 'I', 'D', 'X', '0', '0', '1' };
+
+// Format version written in the header
+const uint32_t faultDictionaryVersion = 2;
+
+// Header flag for per output fault lists
+const uint32_t faultDictionaryPerOutput = 1;
+
+/*
+* Index entry of an encoded block
+*/
+struct FaultDictionaryBlock
+{
+    // Offset of the block from the start of file
+    uint64_t fileOffset;
+    // Number of bytes in the block
+    uint32_t byteLength;
+    // Index of the first vector in the block
+    uint32_t firstVector;
+};
+
+/*
+* Class to stream a fault dictionary to file
+* Vectors are encoded into an in-memory block and written with a single
+* write once the block is full, the index is written on close
+*/
+class FaultDictionaryWriter
+{
+    // Output file stream
+    std::ofstream outFileStream;
+
+    // Number of faults in the fault table
+    uint32_t numFaults;
+
+    // Number of lists per vector (outputs, or 1)
+    uint32_t listsPerVector;
+
+    // Vectors encoded per block
+    uint32_t vectorsPerBlock;
+
+    // Vectors added so far
+    uint32_t numVectors;
+
+    // Vectors in the current block
+    uint32_t vectorsInBlock;
+
+    // Encoded bytes of the current block
+    std::vector<uint8_t> blockBuffer;
+
+    // Index of the blocks written so far
+    std::vector<FaultDictionaryBlock> blockIndex;
+
+    // Number of lists holding each fault so far
+    std::vector<uint32_t> detectionCounts;
+
+    // File offset where the next block starts
+    uint64_t fileOffset;
+
+    /*
+    * Function to encode one sorted fault id list into the block buffer
+    * @param faultIds -> sorted unique fault ids
+    */
+    void encode_list(const std::vector<int>& faultIds);
+
+    /*
+    * Function to write the current block and add it to the index
+    * @return bool -> if written successfully
+    */
+    bool flush_block();
+
+public:
+
+    /*
+    * Constructor for the class
+    */
+    FaultDictionaryWriter();
+
+    /*
+    * Function to create the dictionary file and write the header
+    * @param filePath -> location of the dictionary
+    * @param faultList -> fault table, pair of entry => first = node name, second = fault type
+    * @param outputNames -> primary output node names
+    * @param perOutput -> store one fault list per output instead of one per vector
+    * @param inVectorsPerBlock -> vectors encoded per block
+    * @return bool -> if created successfully
+    */
+    bool open(std::string filePath, const std::vector<std::pair<int, int>>& faultList,
+        const std::vector<int>& outputNames, bool perOutput, int inVectorsPerBlock);
+
+    /*
+    * Function to add the faults detected by the next vector
+    * @param detectedFaults -> one sorted fault id list per output (or a single list)
+    * @return bool -> if added successfully
+    */
+    bool add_vector(const std::vector<std::vector<int>>& detectedFaults);
+
+    /*
+    * Function to write the last block and the index
+    * @return bool -> if written successfully
+    */
+    bool close();
+
+    /*
+    * Destructor for the class
+    */
+    ~FaultDictionaryWriter();
+};
+
+/*
+* Class to read a fault dictionary with random access to vectors
+* The last decoded block is cached so that sequential reads decode each
+* block once
+*/
+class FaultDictionaryReader
+{
+    // Input file stream
+    std::ifstream inFileStream;
+
+    // Whether the lists are stored per output
+    bool perOutput;
+
+    // Vectors encoded per block
+    uint32_t vectorsPerBlock;
+
+    // Number of vectors in the dictionary
+    uint64_t numVectors;
+
+    // Index of the blocks
+    std::vector<FaultDictionaryBlock> blockIndex;
+
+    // Block currently decoded (-1 if none)
+    int cachedBlock;
+
+    // Decoded lists of the cached block, per vector per output
+    std::vector<std::vector<std::vector<int>>> cachedVectors;
+
+    /*
+    * Function to read and decode a block into the cache
+    * @param blockNumber -> index of the block
+    * @return bool -> if decoded successfully
+    */
+    bool load_block(int blockNumber);
+
+public:
+
+    // Fault table, pair of entry => first = node name, second = fault type
+    std::vector<std::pair<int, int>> faultList;
+
+    // Primary output node names
+    std::vector<int> outputNames;
+
+    // Number of lists holding each fault (failing vectors or vector/output pairs)
+    std::vector<uint32_t> detectionCounts;
+
+    /*
+    * Constructor for the class
+    */
+    FaultDictionaryReader();
+
+    /*
+    * Function to open the dictionary and read the header and index
+    * @param filePath -> location of the dictionary
+    * @return bool -> if opened successfully
+    */
+    bool open(std::string filePath);
+
+    /*
+    * Function to get number of vectors
+    * @return int -> number of vectors
+    */
+    int get_num_vectors();
+
+    /*
+    * Function to check if the lists are stored per output
+    * @return bool -> if stored per output
+    */
+    bool is_per_output();
+
+    /*
+    * Function to read the faults detected by a vector
+    * @param vectorIndex -> index of the vector
+    * @param detectedFaults -> one sorted fault id list per output or a single list (updated in place)
+    * @return bool -> if read successfully
+    */
+    bool read_vector(int vectorIndex, std::vector<std::vector<int>>& detectedFaults);
+};
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef __FAULTSIMENGINE_H__
+#define __FAULTSIMENGINE_H__
+
+#include <string>
+#include <set>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+/*
+* Work counters of a fault simulation engine
+* Counters accumulate over the life of the engine, the fault list sizes
+* describe the state after the last test vector
+*/
+struct SimulationStats
+{
+    // Gate evaluations of the good and faulty machines
+    long long gatesEvaluated;
+    // Fault list set operations, counted per list entry processed
+    long long listOperations;
+    // Number of fault lists held by the engine (0 => engine keeps no lists)
+    int numLists;
+    // Total entries of the fault lists
+    long long listEntries;
+    // Entries of the longest fault list
+    int maxListLength;
+    // Faults still graded (not dropped)
+    int activeFaults;
+};
+
+/*
+* Interface for the fault simulation engines
+* An engine is given one test vector at a time and reports the faults
+* detected at the primary outputs by that vector
+* Fault pair => first = node name, second = fault type
+*/
+class FaultSimEngine
+{
+public:
+
+    /*
+    * Function to apply the test vector and grade the faults
+    * @param testVector -> test vector applied
+    * @return bool -> if test vector applied successfully
+    */
+    virtual bool apply_test_vector(std::string testVector) = 0;
+
+    /*
+    * Function to apply a block of test vectors in order
+    * Engines able to grade a block at once override this
+    * @param testVectors -> test vectors applied
+    * @param detectedPerVector -> faults detected by each vector (updated in place)
+    * @return bool -> if all test vectors applied successfully
+    */
+    virtual bool apply_test_vectors(const std::vector<std::string>& testVectors,
+        std::vector<std::set<std::pair<int, int>>>& detectedPerVector)
+    {
+        detectedPerVector.clear();
+        for (const std::string& testVector : testVectors)
+        {
+            if (this->apply_test_vector(testVector) == false)
+            {
+                return false;
+            }
+            detectedPerVector.push_back(this->get_list_detected_faults());
+        }
+        return true;
+    }
+
+    /*
+    * Function to get the output vector of the good circuit
+    * @return string -> output vector for the last test vector
+    */
+    virtual std::string get_output_vector_lin() = 0;
+
+    /*
+    * Function to get the faults detected by the last test vector
+    * @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+    */
+    virtual std::set<std::pair<int, int>> get_list_detected_faults() = 0;
+
+    /*
+    * Function to get total faults graded by the engine
+    * @return int -> total faults
+    */
+    virtual int get_total_faults_count() = 0;
+
+    /*
+    * Function to keep detected faults graded until N vectors detected them
+    * Engines counting detections override this, others only accept N = 1
+    * @param detectionLimit -> detections counted per fault before it is dropped
+    * @return bool -> if the engine supports the limit
+    */
+    virtual bool set_detection_limit(int detectionLimit)
+    {
+        return detectionLimit == 1;
+    }
+
+    /*
+    * Function to get the number of faults detected at least n times
+    * @return vector of int -> entry n - 1 holds the faults detected n or more times (empty if not counted)
+    */
+    virtual std::vector<int> get_n_detect_counts()
+    {
+        return std::vector<int>();
+    }
+
+    /*
+    * Function to get the detections counted per fault, for checkpointing
+    * Engines dropping faults override this, so that a resumed run skips the dropped faults
+    * @param detectionCounts -> detections per fault in engine order (updated in place)
+    * @return bool -> if the engine keeps detection state
+    */
+    virtual bool get_detection_state(std::vector<uint8_t>& detectionCounts)
+    {
+        return false;
+    }
+
+    /*
+    * Function to restore the detections per fault before the first vector is applied
+    * @param detectionCounts -> detections per fault returned by get_detection_state
+    * @return bool -> if the engine keeps detection state and the counts match its faults
+    */
+    virtual bool set_detection_state(const std::vector<uint8_t>& detectionCounts)
+    {
+        return false;
+    }
+
+    /*
+    * Function to get the work counters of the engine, for instrumentation
+    * @param stats -> counters and fault list sizes (updated in place)
+    * @return bool -> if the engine keeps counters
+    */
+    virtual bool get_simulation_stats(SimulationStats& stats)
+    {
+        return false;
+    }
+
+    /*
+    * Destructor for the class
+    */
+    virtual ~FaultSimEngine() {}
+};
+
+#endif
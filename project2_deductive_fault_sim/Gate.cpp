@@ -413,7 +413,17 @@ int Gate::get_inversion_parity()
 */
 int Gate::get_controlling_value()
 {
-    switch (this->get_gate_logic())
+    return Gate::get_controlling_value(this->get_gate_logic());
+}
+
+/*
+* Function to get the controlling value of a gate logic
+* @param inLogic -> logic of the gate
+* @return int -> controlling value of gate inputs (-1 if none)
+*/
+int Gate::get_controlling_value(gateLogic inLogic)
+{
+    switch (inLogic)
     {
     case(and_l): case(nand_l):
         return 0;
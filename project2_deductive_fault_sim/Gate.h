@@ -152,6 +152,13 @@ public:
     */
     int get_controlling_value();
 
+    /*
+    * Function to get the controlling value of a gate logic
+    * @param inLogic -> logic of the gate
+    * @return int -> controlling value of gate inputs (-1 if none)
+    */
+    static int get_controlling_value(gateLogic inLogic);
+
     /*
     * Function to check if input1 is at controlling value
     * @return bool -> input1 is at controlling value
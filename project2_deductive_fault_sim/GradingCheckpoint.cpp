@@ -0,0 +1,232 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "GradingCheckpoint.h"
+
+/*
+* Function to append a little endian unsigned integer
+* @param buffer -> byte buffer (updated in place)
+* @param value -> value to append
+* @param numBytes -> number of bytes to write
+*/
+static void put_fixed(std::vector<uint8_t>& buffer, uint64_t value, int numBytes)
+{
+    for (int i = 0; i < numBytes; ++i)
+    {
+        buffer.push_back((uint8_t)(value >> (8 * i)));
+    }
+}
+
+/*
+* Function to append a string preceded by its length
+* @param buffer -> byte buffer (updated in place)
+* @param value -> string to append
+*/
+static void put_string(std::vector<uint8_t>& buffer, const std::string& value)
+{
+    put_fixed(buffer, value.size(), 4);
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+/*
+* Function to read a little endian unsigned integer
+* @param buffer -> byte buffer
+* @param position -> read position (updated in place)
+* @param numBytes -> number of bytes to read
+* @param value -> value read (updated in place)
+* @return bool -> if the buffer holds the bytes
+*/
+static bool get_fixed(const std::vector<uint8_t>& buffer, size_t& position, int numBytes, uint64_t& value)
+{
+    if (position + numBytes > buffer.size())
+    {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < numBytes; ++i)
+    {
+        value |= (uint64_t)buffer[position++] << (8 * i);
+    }
+    return true;
+}
+
+/*
+* Function to read a string preceded by its length
+* @param buffer -> byte buffer
+* @param position -> read position (updated in place)
+* @param value -> string read (updated in place)
+* @return bool -> if the buffer holds the string
+*/
+static bool get_string(const std::vector<uint8_t>& buffer, size_t& position, std::string& value)
+{
+    uint64_t length;
+    if (get_fixed(buffer, position, 4, length) == false || position + length > buffer.size())
+    {
+        return false;
+    }
+    value.assign(buffer.begin() + position, buffer.begin() + position + length);
+    position += length;
+    return true;
+}
+
+/*
+* Constructor for the class
+*/
+GradingCheckpoint::GradingCheckpoint() :
+    patternWidth(0), totalFaults(0), detectionLimit(1), patternsDrawn(0), vectorsRun(0),
+    vectorsSinceDetection(0), isFinished(false)
+{
+}
+
+/*
+* Function to get the faults detected after a vector from the coverage curve
+* @param vectorIndex -> index of the vector
+* @return uint32_t -> number of faults detected by the vectors up to vectorIndex
+*/
+uint32_t GradingCheckpoint::get_detected_count(uint32_t vectorIndex)
+{
+    // last curve point at or before the vector
+    std::vector<std::pair<uint32_t, uint32_t>>::iterator itr = std::upper_bound(this->coverageCurve.begin(),
+        this->coverageCurve.end(), std::make_pair(vectorIndex, UINT32_MAX));
+    return (itr == this->coverageCurve.begin()) ? 0 : (itr - 1)->second;
+}
+
+/*
+* Function to write the checkpoint
+* The file is written aside and renamed so an interrupted write keeps the previous checkpoint
+* @param filePath -> location of the checkpoint
+* @return bool -> if written successfully
+*/
+bool GradingCheckpoint::save(std::string filePath)
+{
+    std::vector<uint8_t> buffer(gradingCheckpointMagic, gradingCheckpointMagic + sizeof(gradingCheckpointMagic));
+    put_string(buffer, this->netlistPath);
+    put_string(buffer, this->patternSource);
+    put_fixed(buffer, this->patternWidth, 4);
+    put_fixed(buffer, this->totalFaults, 4);
+    put_fixed(buffer, this->detectionLimit, 4);
+    put_fixed(buffer, this->patternsDrawn, 8);
+    put_fixed(buffer, this->vectorsRun, 4);
+    put_fixed(buffer, this->vectorsSinceDetection, 4);
+    put_fixed(buffer, this->isFinished, 1);
+    put_string(buffer, this->stopReason);
+    put_fixed(buffer, this->sourceState.size(), 4);
+    for (uint64_t stateWord : this->sourceState)
+    {
+        put_fixed(buffer, stateWord, 8);
+    }
+    put_fixed(buffer, this->coverageCurve.size(), 4);
+    for (std::pair<uint32_t, uint32_t> curvePoint : this->coverageCurve)
+    {
+        put_fixed(buffer, curvePoint.first, 4);
+        put_fixed(buffer, curvePoint.second, 4);
+    }
+    put_fixed(buffer, this->detectedFaults.size(), 4);
+    for (std::pair<int, int> fault : this->detectedFaults)
+    {
+        put_fixed(buffer, (uint32_t)fault.first, 4);
+        put_fixed(buffer, (uint32_t)fault.second, 4);
+    }
+    put_fixed(buffer, this->detectionCounts.size(), 4);
+    buffer.insert(buffer.end(), this->detectionCounts.begin(), this->detectionCounts.end());
+
+    std::string tempPath = filePath + ".tmp";
+    std::ofstream outFileStream(tempPath, std::ios::binary | std::ios::trunc);
+    outFileStream.write((const char*)buffer.data(), buffer.size());
+    outFileStream.close();
+    if (outFileStream.fail() || std::rename(tempPath.c_str(), filePath.c_str()) != 0)
+    {
+        std::cerr << "Unable to write checkpoint: " << filePath << "\n";
+        return false;
+    }
+    return true;
+}
+
+/*
+* Function to read the checkpoint
+* @param filePath -> location of the checkpoint
+* @return bool -> if read successfully
+*/
+bool GradingCheckpoint::load(std::string filePath)
+{
+    std::ifstream inFileStream(filePath, std::ios::binary);
+    if (inFileStream.is_open() == false)
+    {
+        std::cerr << "Unable to open checkpoint: " << filePath << "\n";
+        return false;
+    }
+    std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(inFileStream)), std::istreambuf_iterator<char>());
+    if (buffer.size() < sizeof(gradingCheckpointMagic) ||
+        memcmp(buffer.data(), gradingCheckpointMagic, sizeof(gradingCheckpointMagic)) != 0)
+    {
+        std::cerr << "Not a checkpoint: " << filePath << "\n";
+        return false;
+    }
+
+    size_t position = sizeof(gradingCheckpointMagic);
+    // Fields are only copied once read, a truncated checkpoint leaves them untouched
+    uint64_t patternWidthValue = 0, totalFaultsValue = 0, detectionLimitValue = 0;
+    uint64_t vectorsRunValue = 0, vectorsSinceDetectionValue = 0, isFinishedValue = 0;
+    uint64_t value = 0, listSize = 0, firstValue = 0, secondValue = 0;
+    bool isRead = get_string(buffer, position, this->netlistPath) &&
+        get_string(buffer, position, this->patternSource);
+    isRead = isRead && get_fixed(buffer, position, 4, patternWidthValue);
+    isRead = isRead && get_fixed(buffer, position, 4, totalFaultsValue);
+    isRead = isRead && get_fixed(buffer, position, 4, detectionLimitValue);
+    isRead = isRead && get_fixed(buffer, position, 8, this->patternsDrawn);
+    isRead = isRead && get_fixed(buffer, position, 4, vectorsRunValue);
+    isRead = isRead && get_fixed(buffer, position, 4, vectorsSinceDetectionValue);
+    isRead = isRead && get_fixed(buffer, position, 1, isFinishedValue);
+    isRead = isRead && get_string(buffer, position, this->stopReason);
+    if (isRead)
+    {
+        this->patternWidth = patternWidthValue;
+        this->totalFaults = totalFaultsValue;
+        this->detectionLimit = detectionLimitValue;
+        this->vectorsRun = vectorsRunValue;
+        this->vectorsSinceDetection = vectorsSinceDetectionValue;
+        this->isFinished = (isFinishedValue != 0);
+    }
+
+    this->sourceState.clear();
+    isRead = isRead && get_fixed(buffer, position, 4, listSize);
+    for (uint64_t i = 0; isRead && i < listSize; ++i)
+    {
+        isRead = get_fixed(buffer, position, 8, value);
+        if (isRead)
+        {
+            this->sourceState.push_back(value);
+        }
+    }
+    this->coverageCurve.clear();
+    isRead = isRead && get_fixed(buffer, position, 4, listSize);
+    for (uint64_t i = 0; isRead && i < listSize; ++i)
+    {
+        isRead = get_fixed(buffer, position, 4, firstValue) && get_fixed(buffer, position, 4, secondValue);
+        if (isRead)
+        {
+            this->coverageCurve.push_back(std::make_pair((uint32_t)firstValue, (uint32_t)secondValue));
+        }
+    }
+    this->detectedFaults.clear();
+    isRead = isRead && get_fixed(buffer, position, 4, listSize);
+    for (uint64_t i = 0; isRead && i < listSize; ++i)
+    {
+        isRead = get_fixed(buffer, position, 4, firstValue) && get_fixed(buffer, position, 4, secondValue);
+        if (isRead)
+        {
+            this->detectedFaults.push_back(std::make_pair((int)(uint32_t)firstValue, (int)(uint32_t)secondValue));
+        }
+    }
+    isRead = isRead && get_fixed(buffer, position, 4, listSize) && position + listSize <= buffer.size();
+    if (isRead == false)
+    {
+        std::cerr << "Truncated checkpoint: " << filePath << "\n";
+        return false;
+    }
+    this->detectionCounts.assign(buffer.begin() + position, buffer.begin() + position + listSize);
+    return true;
+}
@@ -0,0 +1,108 @@
+#ifndef __GRADINGCHECKPOINT_H__
+#define __GRADINGCHECKPOINT_H__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+/*
+* Binary checkpoint of a pattern grading run
+* Holds what is needed to continue the run after the last graded block: the
+* detected faults, the detection counters of the engine, the pattern source
+* state and the coverage curve. The curve is stored as the vectors where the
+* detected fault count changed, so the file size is bounded by the number of
+* faults rather than the number of vectors. Patterns drawn so far are not
+* stored; a resumed run replays the source from its seed to rebuild the set
+* of patterns to skip and checks it reaches the stored source state.
+*
+* File layout (little endian):
+*   magic, netlist path, pattern source name, pattern width, total faults,
+*   detection limit, patterns drawn, vectors run, vectors since detection,
+*   finished flag, stop reason, source state words, curve points (vector,
+*   detected count), detected faults (node name, fault type), engine
+*   detection counters (one byte per fault, none if not kept by the engine)
+*   Strings and lists are preceded by their 32-bit length
+*/
+
+// Magic at the start of the checkpoint
+const char gradingCheckpointMagic[8] = { 'F', 'S', 'C', 'K', 'P', 'T', '0', '1' };
+
+/*
+* Class for the state of a pattern grading run
+*/
+class GradingCheckpoint
+{
+public:
+
+    // Netlist graded
+    std::string netlistPath;
+
+    // Pattern source name (random, lfsr or ca)
+    std::string patternSource;
+
+    // Number of bits per pattern
+    uint32_t patternWidth;
+
+    // Total faults graded by the engine
+    uint32_t totalFaults;
+
+    // Detections counted per fault before it is dropped (N of N-detect)
+    uint32_t detectionLimit;
+
+    // Patterns drawn from the source, duplicates included
+    uint64_t patternsDrawn;
+
+    // Unique vectors graded
+    uint32_t vectorsRun;
+
+    // Vectors graded since the last new detection
+    uint32_t vectorsSinceDetection;
+
+    // Whether the run reached a stop condition
+    bool isFinished;
+
+    // Stop condition reached (empty while running)
+    std::string stopReason;
+
+    // Pattern source state after patternsDrawn patterns
+    std::vector<uint64_t> sourceState;
+
+    // Coverage curve, pair of entry => first = vector index, second = faults detected from that vector on
+    std::vector<std::pair<uint32_t, uint32_t>> coverageCurve;
+
+    // Faults detected so far, pair of entry => first = node name, second = fault type
+    std::vector<std::pair<int, int>> detectedFaults;
+
+    // Detections per fault in engine order (empty if not kept by the engine)
+    std::vector<uint8_t> detectionCounts;
+
+    /*
+    * Constructor for the class
+    */
+    GradingCheckpoint();
+
+    /*
+    * Function to get the faults detected after a vector from the coverage curve
+    * @param vectorIndex -> index of the vector
+    * @return uint32_t -> number of faults detected by the vectors up to vectorIndex
+    */
+    uint32_t get_detected_count(uint32_t vectorIndex);
+
+    /*
+    * Function to write the checkpoint
+    * The file is written aside and renamed so an interrupted write keeps the previous checkpoint
+    * @param filePath -> location of the checkpoint
+    * @return bool -> if written successfully
+    */
+    bool save(std::string filePath);
+
+    /*
+    * Function to read the checkpoint
+    * @param filePath -> location of the checkpoint
+    * @return bool -> if read successfully
+    */
+    bool load(std::string filePath);
+};
+
+#endif
@@ -0,0 +1,207 @@
+#include <iostream>
+#include <algorithm>
+#include <list>
+#include "LevelizedCircuit.h"
+
+/*
+* Constructor for the class
+*/
+LevelizedCircuit::LevelizedCircuit() : maxLevel(0) {}
+
+/*
+* Function to build the levelized view from a circuit read from netlist
+* The fault universe is taken from the stuck at flags of the nodes
+* @param ckt -> circuit to levelize
+* @return bool -> if the circuit could be levelized (no loops, all nodes driven)
+*/
+bool LevelizedCircuit::build(Circuit& ckt)
+{
+    // Number the nodes in creation order
+    for (int nodeName : ckt.get_node_list())
+    {
+        this->nodeIndexMap[nodeName] = this->nodeNames.size();
+        this->nodeNames.push_back(nodeName);
+    }
+    int numNodes = this->nodeNames.size();
+    this->driverGate.assign(numNodes, -1);
+    this->fanoutGates.assign(numNodes, std::vector<int>());
+    this->nodeLevel.assign(numNodes, -1);
+    this->isOutput.assign(numNodes, false);
+
+    for (int nodeName : ckt.get_input_nodes())
+    {
+        int nodeIndex = this->get_node_index(nodeName);
+        if (nodeIndex == -1)
+        {
+            std::cerr << "Primary input " << nodeName << " is not connected to any gate\n";
+            return false;
+        }
+        this->inputNodes.push_back(nodeIndex);
+        this->nodeLevel[nodeIndex] = 0;
+    }
+    for (int nodeName : ckt.get_output_nodes())
+    {
+        int nodeIndex = this->get_node_index(nodeName);
+        if (nodeIndex == -1)
+        {
+            std::cerr << "Primary output " << nodeName << " is not connected to any gate\n";
+            return false;
+        }
+        this->outputNodes.push_back(nodeIndex);
+        this->isOutput[nodeIndex] = true;
+    }
+
+    // Convert the gates to index form in netlist order
+    std::vector<LevelizedGate> netlistGates;
+    for (Gate* currGate : ckt.get_gate_list())
+    {
+        LevelizedGate newGate;
+        newGate.logic = currGate->get_gate_logic();
+        newGate.input1 = this->get_node_index(currGate->get_input1()->get_name());
+        newGate.input2 = -1;
+        if (currGate->is_single_input() == false)
+        {
+            newGate.input2 = this->get_node_index(currGate->get_input2()->get_name());
+        }
+        newGate.output = this->get_node_index(currGate->get_output()->get_name());
+        newGate.level = -1;
+        if (this->driverGate[newGate.output] != -1)
+        {
+            std::cerr << "Node " << currGate->get_output()->get_name() << " driven by multiple gates\n";
+            return false;
+        }
+        this->driverGate[newGate.output] = netlistGates.size();
+        netlistGates.push_back(newGate);
+    }
+
+    // Assign levels by repeatedly evaluating the gates whose inputs are levelized
+    // (same activation rule as Circuit::apply_test_vector, but done only once)
+    std::vector<int> pendingInputs(netlistGates.size(), 0);
+    std::vector<std::vector<int>> nodeToGates(numNodes);
+    for (unsigned int i = 0; i < netlistGates.size(); ++i)
+    {
+        pendingInputs[i] = (netlistGates[i].input2 == -1) ? 1 : 2;
+        nodeToGates[netlistGates[i].input1].push_back(i);
+        if (netlistGates[i].input2 != -1)
+        {
+            nodeToGates[netlistGates[i].input2].push_back(i);
+        }
+    }
+    std::list<int> readyNodes(this->inputNodes.begin(), this->inputNodes.end());
+    while (readyNodes.size() > 0)
+    {
+        int nodeIndex = readyNodes.front();
+        readyNodes.pop_front();
+        for (int gateIndex : nodeToGates[nodeIndex])
+        {
+            if (--pendingInputs[gateIndex] > 0)
+            {
+                continue;
+            }
+            LevelizedGate& currGate = netlistGates[gateIndex];
+            int inputLevel = this->nodeLevel[currGate.input1];
+            if (currGate.input2 != -1)
+            {
+                inputLevel = std::max(inputLevel, this->nodeLevel[currGate.input2]);
+            }
+            currGate.level = inputLevel + 1;
+            this->nodeLevel[currGate.output] = currGate.level;
+            this->maxLevel = std::max(this->maxLevel, currGate.level);
+            readyNodes.push_back(currGate.output);
+        }
+    }
+    for (unsigned int i = 0; i < netlistGates.size(); ++i)
+    {
+        if (netlistGates[i].level == -1)
+        {
+            std::cerr << "Unable to levelize gate driving node "
+                << this->nodeNames[netlistGates[i].output] << " (loop or undriven input)\n";
+            return false;
+        }
+    }
+
+    // Store the gates in level order, stable to keep netlist order within a level
+    this->gates = netlistGates;
+    std::stable_sort(this->gates.begin(), this->gates.end(),
+        [](const LevelizedGate& gate1, const LevelizedGate& gate2) { return gate1.level < gate2.level; });
+    for (unsigned int i = 0; i < this->gates.size(); ++i)
+    {
+        this->driverGate[this->gates[i].output] = i;
+        this->fanoutGates[this->gates[i].input1].push_back(i);
+        if (this->gates[i].input2 != -1 && this->gates[i].input2 != this->gates[i].input1)
+        {
+            this->fanoutGates[this->gates[i].input2].push_back(i);
+        }
+    }
+
+    // Collect the fault universe from the node fault flags
+    for (int nodeName : this->nodeNames)
+    {
+        Node* currNode = ckt.get_node_from_name(nodeName);
+        if (currNode->get_is_stuck_at_0())
+        {
+            this->faultList.push_back(std::make_pair(nodeName, 0));
+            this->faultNode.push_back(this->get_node_index(nodeName));
+        }
+        if (currNode->get_is_stuck_at_1())
+        {
+            this->faultList.push_back(std::make_pair(nodeName, 1));
+            this->faultNode.push_back(this->get_node_index(nodeName));
+        }
+    }
+    return true;
+}
+
+/*
+* Function to get number of nodes
+* @return int -> number of nodes
+*/
+int LevelizedCircuit::get_num_nodes()
+{
+    return this->nodeNames.size();
+}
+
+/*
+* Function to get number of faults in the fault universe
+* @return int -> number of faults
+*/
+int LevelizedCircuit::get_num_faults()
+{
+    return this->faultList.size();
+}
+
+/*
+* Function to get the node index from netlist name
+* @param nodeName -> name of node in netlist
+* @return int -> index of node, -1 if unknown
+*/
+int LevelizedCircuit::get_node_index(int nodeName)
+{
+    std::unordered_map<int, int>::iterator itr = this->nodeIndexMap.find(nodeName);
+    if (itr == this->nodeIndexMap.end())
+    {
+        return -1;
+    }
+    return itr->second;
+}
+
+/*
+* Function to convert the test vector string to primary input values
+* @param testVector -> test vector applied
+* @param inputValues -> value per primary input (updated in place)
+* @return bool -> if test vector is valid for the circuit
+*/
+bool LevelizedCircuit::parse_test_vector(std::string testVector, std::vector<int>& inputValues)
+{
+    if (testVector.length() != this->inputNodes.size())
+    {
+        std::cerr << "Invalid test vectors as size not same as number of inputs" << "\n";
+        return false;
+    }
+    inputValues.resize(this->inputNodes.size());
+    for (unsigned int i = 0; i < this->inputNodes.size(); ++i)
+    {
+        inputValues[i] = (testVector[i] == '1');
+    }
+    return true;
+}
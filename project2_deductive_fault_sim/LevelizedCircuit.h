@@ -0,0 +1,182 @@
+#ifndef __LEVELIZEDCIRCUIT_H__
+#define __LEVELIZEDCIRCUIT_H__
+
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <cstdint>
+
+#include "Circuit.h"
+
+/*
+* Gate entry of the levelized circuit
+* All nodes are referred to by their index in the levelized circuit
+*/
+struct LevelizedGate
+{
+    // Logic of the gate
+    gateLogic logic;
+    // Index of the input1 node
+    int input1;
+    // Index of the input2 node (-1 for single input gates)
+    int input2;
+    // Index of the output node
+    int output;
+    // Logic level of the gate (primary inputs are at level 0)
+    int level;
+};
+
+/*
+* Class for a compact, index based view of a circuit
+* Nodes are numbered from 0 and gates are stored in level order so that the
+* fault simulation engines can keep their own value/fault state in plain
+* vectors. It is read-only once built and can be shared by several engines.
+*/
+class LevelizedCircuit
+{
+public:
+    // Node index to node name in netlist
+    std::vector<int> nodeNames;
+
+    // Node name in netlist to node index
+    std::unordered_map<int, int> nodeIndexMap;
+
+    // Gates sorted by level (netlist order within a level)
+    std::vector<LevelizedGate> gates;
+
+    // Node index to index of the gate driving it (-1 for primary inputs)
+    std::vector<int> driverGate;
+
+    // Node index to indices of the gates it feeds
+    std::vector<std::vector<int>> fanoutGates;
+
+    // Node index to logic level of the node
+    std::vector<int> nodeLevel;
+
+    // Indices of the primary inputs in test vector order
+    std::vector<int> inputNodes;
+
+    // Indices of the primary outputs in output vector order
+    std::vector<int> outputNodes;
+
+    // Node index to whether it is a primary output
+    std::vector<bool> isOutput;
+
+    // Highest gate level in the circuit
+    int maxLevel;
+
+    // Fault universe, pair of entry => first = node name, second = fault type
+    // Faults are numbered in node creation order, s-a-0 before s-a-1
+    std::vector<std::pair<int, int>> faultList;
+
+    // Fault index to node index of the fault site
+    std::vector<int> faultNode;
+
+    /*
+    * Constructor for the class
+    */
+    LevelizedCircuit();
+
+    /*
+    * Function to build the levelized view from a circuit read from netlist
+    * The fault universe is taken from the stuck at flags of the nodes
+    * @param ckt -> circuit to levelize
+    * @return bool -> if the circuit could be levelized (no loops, all nodes driven)
+    */
+    bool build(Circuit& ckt);
+
+    /*
+    * Function to get number of nodes
+    * @return int -> number of nodes
+    */
+    int get_num_nodes();
+
+    /*
+    * Function to get number of faults in the fault universe
+    * @return int -> number of faults
+    */
+    int get_num_faults();
+
+    /*
+    * Function to get the node index from netlist name
+    * @param nodeName -> name of node in netlist
+    * @return int -> index of node, -1 if unknown
+    */
+    int get_node_index(int nodeName);
+
+    /*
+    * Function to convert the test vector string to primary input values
+    * @param testVector -> test vector applied
+    * @param inputValues -> value per primary input (updated in place)
+    * @return bool -> if test vector is valid for the circuit
+    */
+    bool parse_test_vector(std::string testVector, std::vector<int>& inputValues);
+};
+
+/*
+* Function to evaluate a gate on boolean values
+* @param logic -> logic of the gate
+* @param input1Value -> value of input1 (0 or 1)
+* @param input2Value -> value of input2 (ignored for single input gates)
+* @return int -> output value of the gate
+*/
+inline int evaluate_gate(gateLogic logic, int input1Value, int input2Value)
+{
+    switch (logic)
+    {
+    case(and_l):
+        return input1Value & input2Value;
+    case(or_l):
+        return input1Value | input2Value;
+    case(not_l):
+        return !input1Value;
+    case(nand_l):
+        return !(input1Value & input2Value);
+    case(nor_l):
+        return !(input1Value | input2Value);
+    case(xor_l):
+        return input1Value ^ input2Value;
+    case(xnor_l):
+        return !(input1Value ^ input2Value);
+    case(buf_l):
+        return input1Value;
+    default:
+        break;
+    }
+    return -1;
+}
+
+/*
+* Function to evaluate a gate on 64 packed boolean values at once
+* @param logic -> logic of the gate
+* @param input1Word -> packed values of input1
+* @param input2Word -> packed values of input2 (ignored for single input gates)
+* @return uint64_t -> packed output values of the gate
+*/
+inline uint64_t evaluate_gate_word(gateLogic logic, uint64_t input1Word, uint64_t input2Word)
+{
+    switch (logic)
+    {
+    case(and_l):
+        return input1Word & input2Word;
+    case(or_l):
+        return input1Word | input2Word;
+    case(not_l):
+        return ~input1Word;
+    case(nand_l):
+        return ~(input1Word & input2Word);
+    case(nor_l):
+        return ~(input1Word | input2Word);
+    case(xor_l):
+        return input1Word ^ input2Word;
+    case(xnor_l):
+        return ~(input1Word ^ input2Word);
+    case(buf_l):
+        return input1Word;
+    default:
+        break;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "LfsrPatternSource.h"
+
+// Feedback mask of the Galois LFSR for taps 64, 63, 61, 60
+const uint64_t lfsrFeedbackMask = 0xD800000000000000ULL;
+
+/*
+* Constructor for the class
+* @param inWidth -> number of bits per pattern
+* @param seed -> initial register state (0 is replaced by 1)
+*/
+LfsrPatternSource::LfsrPatternSource(int inWidth, uint64_t seed) :
+    width(inWidth), lfsrState(seed == 0 ? 1 : seed)
+{
+}
+
+/*
+* Function to generate the next pattern
+* @param patternWords -> packed pattern (updated in place)
+*/
+void LfsrPatternSource::next_pattern(std::vector<uint64_t>& patternWords)
+{
+    patternWords.assign(get_pattern_words(this->width), 0);
+    for (int i = 0; i < this->width; ++i)
+    {
+        uint64_t outputBit = this->lfsrState & 1;
+        this->lfsrState >>= 1;
+        if (outputBit)
+        {
+            this->lfsrState ^= lfsrFeedbackMask;
+        }
+        patternWords[i / 64] |= outputBit << (i % 64);
+    }
+}
+
+/*
+* Function to get the pattern width
+* @return int -> number of bits per pattern
+*/
+int LfsrPatternSource::get_width()
+{
+    return this->width;
+}
+
+/*
+* Function to get the generator state, for checkpointing
+* @return vector of uint64_t -> register state
+*/
+std::vector<uint64_t> LfsrPatternSource::get_state()
+{
+    return std::vector<uint64_t>(1, this->lfsrState);
+}
+
+/*
+* Function to restore a generator state returned by get_state
+* @param stateWords -> register state
+* @return bool -> if the state is valid for the generator
+*/
+bool LfsrPatternSource::set_state(const std::vector<uint64_t>& stateWords)
+{
+    if (stateWords.size() != 1 || stateWords[0] == 0)
+    {
+        return false;
+    }
+    this->lfsrState = stateWords[0];
+    return true;
+}
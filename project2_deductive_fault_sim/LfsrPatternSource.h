@@ -0,0 +1,58 @@
+#ifndef __LFSRPATTERNSOURCE_H__
+#define __LFSRPATTERNSOURCE_H__
+
+#include <vector>
+#include <cstdint>
+
+#include "PatternSource.h"
+
+/*
+* LFSR pattern generator of arbitrary width
+* A maximal length 64-bit Galois LFSR (x^64 + x^63 + x^61 + x^60 + 1) feeds
+* its serial output into the pattern bits, as an LFSR driving a single scan
+* chain does. Consecutive patterns are consecutive windows of the sequence.
+*/
+class LfsrPatternSource : public PatternSource
+{
+    // Number of bits per pattern
+    int width;
+
+    // Register state (never 0)
+    uint64_t lfsrState;
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inWidth -> number of bits per pattern
+    * @param seed -> initial register state (0 is replaced by 1)
+    */
+    LfsrPatternSource(int inWidth, uint64_t seed);
+
+    /*
+    * Function to generate the next pattern
+    * @param patternWords -> packed pattern (updated in place)
+    */
+    void next_pattern(std::vector<uint64_t>& patternWords) override;
+
+    /*
+    * Function to get the pattern width
+    * @return int -> number of bits per pattern
+    */
+    int get_width() override;
+
+    /*
+    * Function to get the generator state, for checkpointing
+    * @return vector of uint64_t -> state words
+    */
+    std::vector<uint64_t> get_state() override;
+
+    /*
+    * Function to restore a generator state returned by get_state
+    * @param stateWords -> state words
+    * @return bool -> if the state is valid for the generator
+    */
+    bool set_state(const std::vector<uint64_t>& stateWords) override;
+};
+
+#endif
@@ -22,6 +22,15 @@ std::vector<std::pair<int, int>> Node::get_node_deductive_fault_list()
     return this->listDeductiveFaults;
 }
 
+/*
+* Function to get the length of the node deductive fault list without copying it
+* @return int -> number of deductive faults on node
+*/
+int Node::get_deductive_fault_list_size()
+{
+    return this->listDeductiveFaults.size();
+}
+
 /*
 * Function to set the node deductive fault list
 * @param vector of string -> deductive faults on node
@@ -38,6 +38,12 @@ public:
     */
     std::vector<std::pair<int, int>> get_node_deductive_fault_list();
 
+    /*
+    * Function to get the length of the node deductive fault list without copying it
+    * @return int -> number of deductive faults on node
+    */
+    int get_deductive_fault_list_size();
+
     /*
     * Function to set the node deductive fault list
     * @param vector of string -> deductive faults on node
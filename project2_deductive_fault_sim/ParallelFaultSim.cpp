@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <thread>
+#include "ParallelFaultSim.h"
+
+/*
+* Function run by each worker thread on a block of test vectors
+* @param worker -> engine of the worker
+* @param inputValues -> primary input values per test vector
+* @param detectedPerVector -> fault indices detected per test vector (updated in place)
+*/
+static void run_worker_block(ConcurrentFaultSim* worker, const std::vector<std::vector<int>>* inputValues,
+    std::vector<std::vector<int>>* detectedPerVector)
+{
+    detectedPerVector->resize(inputValues->size());
+    for (unsigned int i = 0; i < inputValues->size(); ++i)
+    {
+        worker->apply_input_values((*inputValues)[i]);
+        (*detectedPerVector)[i] = worker->get_detected_fault_indices();
+    }
+}
+
+/*
+* Constructor for the class
+* @param inTopology -> levelized circuit to simulate
+* @param numThreads -> number of worker threads (0 => hardware concurrency)
+* @param dropDetectedFaults -> drop faults once detected
+*/
+ParallelFaultSim::ParallelFaultSim(LevelizedCircuit* inTopology, int numThreads, bool dropDetectedFaults) :
+    topology(inTopology)
+{
+    if (numThreads <= 0)
+    {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // no point in workers without faults
+    numThreads = std::max(1, std::min(numThreads, this->topology->get_num_faults()));
+
+    // Interleave the faults so that every partition spreads across the circuit
+    std::vector<std::vector<int>> partitions(numThreads);
+    for (int i = 0; i < this->topology->get_num_faults(); ++i)
+    {
+        partitions[i % numThreads].push_back(i);
+    }
+    for (int i = 0; i < numThreads; ++i)
+    {
+        ConcurrentFaultSim* worker = new ConcurrentFaultSim(this->topology);
+        worker->set_active_faults(partitions[i]);
+        worker->set_fault_dropping(dropDetectedFaults);
+        this->workers.push_back(worker);
+    }
+}
+
+/*
+* Function to get the number of worker threads
+* @return int -> number of workers
+*/
+int ParallelFaultSim::get_num_threads()
+{
+    return this->workers.size();
+}
+
+/*
+* Function to apply the test vector and grade the faults
+* @param testVector -> test vector applied
+* @return bool -> if test vector applied successfully
+*/
+bool ParallelFaultSim::apply_test_vector(std::string testVector)
+{
+    std::vector<std::set<std::pair<int, int>>> detectedPerVector;
+    return this->apply_test_vectors(std::vector<std::string>(1, testVector), detectedPerVector);
+}
+
+/*
+* Function to apply a block of test vectors in order on all workers
+* @param testVectors -> test vectors applied
+* @param detectedPerVector -> faults detected by each vector (updated in place)
+* @return bool -> if all test vectors applied successfully
+*/
+bool ParallelFaultSim::apply_test_vectors(const std::vector<std::string>& testVectors,
+    std::vector<std::set<std::pair<int, int>>>& detectedPerVector)
+{
+    detectedPerVector.clear();
+    if (testVectors.size() == 0)
+    {
+        return true;
+    }
+
+    // Decode the block once, shared read-only by the workers
+    std::vector<std::vector<int>> inputValues(testVectors.size());
+    for (unsigned int i = 0; i < testVectors.size(); ++i)
+    {
+        if (this->topology->parse_test_vector(testVectors[i], inputValues[i]) == false)
+        {
+            return false;
+        }
+    }
+
+    // Each worker grades its partition over the complete block
+    std::vector<std::vector<std::vector<int>>> workerResults(this->workers.size());
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < this->workers.size(); ++i)
+    {
+        threads.push_back(std::thread(run_worker_block, this->workers[i], &inputValues, &workerResults[i]));
+    }
+    // calling thread acts as worker 0
+    run_worker_block(this->workers[0], &inputValues, &workerResults[0]);
+    for (std::thread& workerThread : threads)
+    {
+        workerThread.join();
+    }
+
+    // Merge the per-vector detections of all partitions
+    detectedPerVector.resize(testVectors.size());
+    for (unsigned int i = 0; i < this->workers.size(); ++i)
+    {
+        for (unsigned int j = 0; j < testVectors.size(); ++j)
+        {
+            for (int faultIndex : workerResults[i][j])
+            {
+                detectedPerVector[j].insert(this->topology->faultList[faultIndex]);
+            }
+        }
+    }
+    this->detectedFaults = detectedPerVector.back();
+    this->outputVector = this->workers[0]->get_output_vector_lin();
+    return true;
+}
+
+/*
+* Function to get the output vector of the good circuit
+* @return string -> output vector for the last test vector
+*/
+std::string ParallelFaultSim::get_output_vector_lin()
+{
+    return this->outputVector;
+}
+
+/*
+* Function to get the faults detected by the last test vector
+* @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+*/
+std::set<std::pair<int, int>> ParallelFaultSim::get_list_detected_faults()
+{
+    return this->detectedFaults;
+}
+
+/*
+* Function to get total faults graded by the engine
+* @return int -> total faults across all partitions
+*/
+int ParallelFaultSim::get_total_faults_count()
+{
+    int totalFaults = 0;
+    for (ConcurrentFaultSim* worker : this->workers)
+    {
+        totalFaults += worker->get_total_faults_count();
+    }
+    return totalFaults;
+}
+
+/*
+* Function to keep detected faults graded until N vectors detected them
+* @param detectionLimit -> detections counted per fault before it is dropped
+* @return bool -> if all workers support the limit
+*/
+bool ParallelFaultSim::set_detection_limit(int detectionLimit)
+{
+    for (ConcurrentFaultSim* worker : this->workers)
+    {
+        if (worker->set_detection_limit(detectionLimit) == false)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+* Function to get the number of faults detected at least n times over all workers
+* @return vector of int -> entry n - 1 holds the faults detected n or more times
+*/
+std::vector<int> ParallelFaultSim::get_n_detect_counts()
+{
+    // partitions are disjoint => the worker counts add up
+    std::vector<int> nDetectCounts;
+    for (ConcurrentFaultSim* worker : this->workers)
+    {
+        std::vector<int> workerCounts = worker->get_n_detect_counts();
+        nDetectCounts.resize(workerCounts.size(), 0);
+        for (unsigned int n = 0; n < workerCounts.size(); ++n)
+        {
+            nDetectCounts[n] += workerCounts[n];
+        }
+    }
+    return nDetectCounts;
+}
+
+/*
+* Function to get the detections counted per fault over all workers, for checkpointing
+* @param detectionCounts -> detections per fault in topology order (updated in place)
+* @return bool -> if the workers keep detection state
+*/
+bool ParallelFaultSim::get_detection_state(std::vector<uint8_t>& detectionCounts)
+{
+    // partitions are disjoint => a fault is counted by one worker only
+    detectionCounts.assign(this->topology->get_num_faults(), 0);
+    std::vector<uint8_t> workerCounts;
+    for (ConcurrentFaultSim* worker : this->workers)
+    {
+        if (worker->get_detection_state(workerCounts) == false)
+        {
+            return false;
+        }
+        for (unsigned int i = 0; i < workerCounts.size(); ++i)
+        {
+            detectionCounts[i] += workerCounts[i];
+        }
+    }
+    return true;
+}
+
+/*
+* Function to restore the detections per fault on all workers before the first vector is applied
+* @param detectionCounts -> detections per fault returned by get_detection_state
+* @return bool -> if the counts match the fault list
+*/
+bool ParallelFaultSim::set_detection_state(const std::vector<uint8_t>& detectionCounts)
+{
+    for (ConcurrentFaultSim* worker : this->workers)
+    {
+        if (worker->set_detection_state(detectionCounts) == false)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+* Function to get the work counters summed over all workers, for instrumentation
+* Every worker keeps record lists for all nodes, the longest list is the longest of any worker
+* @param stats -> counters and fault list sizes (updated in place)
+* @return bool -> if the workers keep counters
+*/
+bool ParallelFaultSim::get_simulation_stats(SimulationStats& stats)
+{
+    stats = SimulationStats();
+    SimulationStats workerStats;
+    for (ConcurrentFaultSim* worker : this->workers)
+    {
+        if (worker->get_simulation_stats(workerStats) == false)
+        {
+            return false;
+        }
+        stats.gatesEvaluated += workerStats.gatesEvaluated;
+        stats.listOperations += workerStats.listOperations;
+        stats.numLists += workerStats.numLists;
+        stats.listEntries += workerStats.listEntries;
+        stats.maxListLength = std::max(stats.maxListLength, workerStats.maxListLength);
+        stats.activeFaults += workerStats.activeFaults;
+    }
+    return true;
+}
+
+/*
+* Destructor for the class
+*/
+ParallelFaultSim::~ParallelFaultSim()
+{
+    for (ConcurrentFaultSim* worker : this->workers)
+    {
+        delete worker;
+    }
+}
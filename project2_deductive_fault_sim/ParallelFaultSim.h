@@ -0,0 +1,123 @@
+#ifndef __PARALLELFAULTSIM_H__
+#define __PARALLELFAULTSIM_H__
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include "FaultSimEngine.h"
+#include "LevelizedCircuit.h"
+#include "ConcurrentFaultSim.h"
+
+/*
+* Multi-threaded fault simulation engine
+* The fault universe is partitioned across worker threads. All workers share
+* the read-only levelized circuit and keep their own value/fault state in a
+* ConcurrentFaultSim restricted to their partition. Test vectors are graded in
+* blocks and the per-vector detected faults are merged at the end of a block.
+*/
+class ParallelFaultSim : public FaultSimEngine
+{
+    // Read-only topology shared by all workers
+    LevelizedCircuit* topology;
+
+    // One engine per worker thread
+    std::vector<ConcurrentFaultSim*> workers;
+
+    // Output vector of the last test vector
+    std::string outputVector;
+
+    // Faults detected by the last test vector
+    std::set<std::pair<int, int>> detectedFaults;
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inTopology -> levelized circuit to simulate
+    * @param numThreads -> number of worker threads (0 => hardware concurrency)
+    * @param dropDetectedFaults -> drop faults once detected
+    */
+    ParallelFaultSim(LevelizedCircuit* inTopology, int numThreads, bool dropDetectedFaults);
+
+    /*
+    * Function to get the number of worker threads
+    * @return int -> number of workers
+    */
+    int get_num_threads();
+
+    /*
+    * Function to apply the test vector and grade the faults
+    * @param testVector -> test vector applied
+    * @return bool -> if test vector applied successfully
+    */
+    bool apply_test_vector(std::string testVector) override;
+
+    /*
+    * Function to apply a block of test vectors in order on all workers
+    * @param testVectors -> test vectors applied
+    * @param detectedPerVector -> faults detected by each vector (updated in place)
+    * @return bool -> if all test vectors applied successfully
+    */
+    bool apply_test_vectors(const std::vector<std::string>& testVectors,
+        std::vector<std::set<std::pair<int, int>>>& detectedPerVector) override;
+
+    /*
+    * Function to get the output vector of the good circuit
+    * @return string -> output vector for the last test vector
+    */
+    std::string get_output_vector_lin() override;
+
+    /*
+    * Function to get the faults detected by the last test vector
+    * @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+    */
+    std::set<std::pair<int, int>> get_list_detected_faults() override;
+
+    /*
+    * Function to get total faults graded by the engine
+    * @return int -> total faults across all partitions
+    */
+    int get_total_faults_count() override;
+
+    /*
+    * Function to keep detected faults graded until N vectors detected them
+    * @param detectionLimit -> detections counted per fault before it is dropped
+    * @return bool -> if all workers support the limit
+    */
+    bool set_detection_limit(int detectionLimit) override;
+
+    /*
+    * Function to get the number of faults detected at least n times over all workers
+    * @return vector of int -> entry n - 1 holds the faults detected n or more times
+    */
+    std::vector<int> get_n_detect_counts() override;
+
+    /*
+    * Function to get the detections counted per fault, for checkpointing
+    * @param detectionCounts -> detections per fault in topology order (updated in place)
+    * @return bool -> if the engine keeps detection state
+    */
+    bool get_detection_state(std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to restore the detections per fault before the first vector is applied
+    * @param detectionCounts -> detections per fault returned by get_detection_state
+    * @return bool -> if the counts match the fault list
+    */
+    bool set_detection_state(const std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to get the work counters summed over all workers, for instrumentation
+    * @param stats -> counters and fault list sizes (updated in place)
+    * @return bool -> if the workers keep counters
+    */
+    bool get_simulation_stats(SimulationStats& stats) override;
+
+    /*
+    * Destructor for the class
+    */
+    ~ParallelFaultSim();
+};
+
+#endif
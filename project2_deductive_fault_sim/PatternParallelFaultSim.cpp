@@ -0,0 +1,459 @@
+#include <algorithm>
+#include "PatternParallelFaultSim.h"
+
+/*
+* Constructor for the class
+* @param inTopology -> levelized circuit to simulate
+*/
+PatternParallelFaultSim::PatternParallelFaultSim(LevelizedCircuit* inTopology) :
+    topology(inTopology), dropDetectedFaults(false), detectionLimit(1), blockVectors(0),
+    gatesEvaluated(0)
+{
+    int numNodes = this->topology->get_num_nodes();
+    this->goodWords.assign(numNodes, 0);
+    this->faultyWords.assign(numNodes, 0);
+    this->faultyStamp.assign(numNodes, -1);
+    this->faultActive.assign(this->topology->get_num_faults(), true);
+    this->detectionCounts.assign(this->topology->get_num_faults(), 0);
+    this->levelEvents.assign(this->topology->maxLevel + 1, std::vector<int>());
+    this->gateScheduled.assign(this->topology->gates.size(), false);
+}
+
+/*
+* Function to enable dropping of detected faults
+* When enabled, a fault is reported only by the first N vectors detecting it
+* @param inDropDetectedFaults -> drop faults once detected
+*/
+void PatternParallelFaultSim::set_fault_dropping(bool inDropDetectedFaults)
+{
+    this->dropDetectedFaults = inDropDetectedFaults;
+}
+
+/*
+* Function to get the faulty word of a node for the fault being propagated
+* @param nodeIndex -> index of the node
+* @param faultIndex -> fault being propagated
+* @return uint64_t -> faulty word, good word if not reached by the fault
+*/
+uint64_t PatternParallelFaultSim::get_faulty_word(int nodeIndex, int faultIndex)
+{
+    return (this->faultyStamp[nodeIndex] == faultIndex) ?
+        this->faultyWords[nodeIndex] : this->goodWords[nodeIndex];
+}
+
+/*
+* Function to propagate a fault through its fanout cone
+* @param faultIndex -> fault to propagate
+* @param validMask -> bits of the vectors in the block where the fault may be excited
+* @return uint64_t -> bits of the vectors detecting the fault
+*/
+uint64_t PatternParallelFaultSim::propagate_fault(int faultIndex, uint64_t validMask)
+{
+    int faultNode = this->topology->faultNode[faultIndex];
+    uint64_t stuckWord = (this->topology->faultList[faultIndex].second == 0) ? 0 : ~(uint64_t)0;
+    if (((stuckWord ^ this->goodWords[faultNode]) & validMask) == 0)
+    {
+        // fault not excited by any vector of the block
+        return 0;
+    }
+    this->faultyWords[faultNode] = stuckWord;
+    this->faultyStamp[faultNode] = faultIndex;
+
+    uint64_t detectedMask = 0;
+    if (this->topology->isOutput[faultNode])
+    {
+        detectedMask |= (stuckWord ^ this->goodWords[faultNode]) & validMask;
+    }
+    std::vector<int> changedNodes(1, faultNode);
+    int pendingEvents = 0;
+    for (int level = this->topology->nodeLevel[faultNode]; level <= this->topology->maxLevel; ++level)
+    {
+        // schedule the fanout of the nodes changed on the previous level
+        for (int changedNode : changedNodes)
+        {
+            for (int gateIndex : this->topology->fanoutGates[changedNode])
+            {
+                if (this->gateScheduled[gateIndex] == false)
+                {
+                    this->gateScheduled[gateIndex] = true;
+                    this->levelEvents[this->topology->gates[gateIndex].level].push_back(gateIndex);
+                    ++pendingEvents;
+                }
+            }
+        }
+        changedNodes.clear();
+        if (pendingEvents == 0)
+        {
+            // fault effect blocked on every path
+            break;
+        }
+        this->gatesEvaluated += this->levelEvents[level].size();
+        for (int gateIndex : this->levelEvents[level])
+        {
+            this->gateScheduled[gateIndex] = false;
+            --pendingEvents;
+            const LevelizedGate& currGate = this->topology->gates[gateIndex];
+            uint64_t input2Word = (currGate.input2 == -1) ? 0 : this->get_faulty_word(currGate.input2, faultIndex);
+            uint64_t outputWord = evaluate_gate_word(currGate.logic,
+                this->get_faulty_word(currGate.input1, faultIndex), input2Word);
+            uint64_t diffWord = (outputWord ^ this->goodWords[currGate.output]) & validMask;
+            if (diffWord == 0)
+            {
+                continue;
+            }
+            this->faultyWords[currGate.output] = outputWord;
+            this->faultyStamp[currGate.output] = faultIndex;
+            changedNodes.push_back(currGate.output);
+            if (this->topology->isOutput[currGate.output])
+            {
+                detectedMask |= diffWord;
+            }
+        }
+        this->levelEvents[level].clear();
+    }
+    return detectedMask;
+}
+
+/*
+* Function to apply up to 64 test vectors given as packed primary input words
+* @param inputWords -> word per primary input, bit k is the value under vector k
+* @param numVectors -> number of vectors packed in the words (1 to 64)
+*/
+void PatternParallelFaultSim::apply_input_words(const std::vector<uint64_t>& inputWords, int numVectors)
+{
+    this->simulate_good_words(inputWords);
+    this->grade_active_faults(numVectors, false);
+}
+
+/*
+* Function to grade the faults as transition faults on up to 64 vector pairs
+* Fault type 0 is slow-to-rise and 1 is slow-to-fall
+* @param initialInputWords -> word per primary input for the initialization vectors
+* @param launchInputWords -> word per primary input for the launch vectors
+* @param numPairs -> number of pairs packed in the words (1 to 64)
+*/
+void PatternParallelFaultSim::apply_transition_pairs(const std::vector<uint64_t>& initialInputWords,
+    const std::vector<uint64_t>& launchInputWords, int numPairs)
+{
+    this->simulate_good_words(initialInputWords);
+    this->initialWords.swap(this->goodWords);
+    this->goodWords.resize(this->initialWords.size());
+    this->simulate_good_words(launchInputWords);
+    this->grade_active_faults(numPairs, true);
+}
+
+/*
+* Function to simulate the good machine on packed primary input words
+* @param inputWords -> word per primary input
+*/
+void PatternParallelFaultSim::simulate_good_words(const std::vector<uint64_t>& inputWords)
+{
+    // Good machine simulation in level order
+    for (unsigned int i = 0; i < this->topology->inputNodes.size(); ++i)
+    {
+        this->goodWords[this->topology->inputNodes[i]] = inputWords[i];
+    }
+    for (const LevelizedGate& currGate : this->topology->gates)
+    {
+        uint64_t input2Word = (currGate.input2 == -1) ? 0 : this->goodWords[currGate.input2];
+        this->goodWords[currGate.output] = evaluate_gate_word(currGate.logic,
+            this->goodWords[currGate.input1], input2Word);
+    }
+    this->gatesEvaluated += this->topology->gates.size();
+}
+
+/*
+* Function to propagate all active faults and collect the detections per vector
+* @param numVectors -> number of vectors (or pairs) packed in the words
+* @param isTransition -> faults are transition faults conditioned on initialWords
+*/
+void PatternParallelFaultSim::grade_active_faults(int numVectors, bool isTransition)
+{
+    uint64_t validMask = (numVectors >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << numVectors) - 1);
+    this->blockVectors = numVectors;
+
+    // Single fault propagation, faults in index order => per vector lists come out sorted
+    this->detectedPerVector.assign(numVectors, std::vector<int>());
+    for (int faultIndex = 0; faultIndex < this->topology->get_num_faults(); ++faultIndex)
+    {
+        if (this->faultActive[faultIndex] == false)
+        {
+            continue;
+        }
+        uint64_t excitationMask = validMask;
+        if (isTransition)
+        {
+            // the first vector must set the node to the stuck value (0 before a rise)
+            uint64_t initialWord = this->initialWords[this->topology->faultNode[faultIndex]];
+            excitationMask &= (this->topology->faultList[faultIndex].second == 0) ? ~initialWord : initialWord;
+        }
+        uint64_t detectedMask = this->propagate_fault(faultIndex, excitationMask);
+        if (detectedMask == 0)
+        {
+            continue;
+        }
+        // detecting vectors in block order, counted up to the detection limit
+        uint8_t& detectionCount = this->detectionCounts[faultIndex];
+        while (detectedMask != 0)
+        {
+            if (this->dropDetectedFaults && detectionCount == this->detectionLimit)
+            {
+                // only the first N detecting vectors report the fault
+                this->faultActive[faultIndex] = false;
+                break;
+            }
+            this->detectedPerVector[__builtin_ctzll(detectedMask)].push_back(faultIndex);
+            detectedMask &= detectedMask - 1;
+            if (detectionCount < this->detectionLimit)
+            {
+                ++detectionCount;
+            }
+        }
+        if (this->dropDetectedFaults && detectionCount == this->detectionLimit)
+        {
+            this->faultActive[faultIndex] = false;
+        }
+    }
+    // stamps of this block must not match any fault of the next block
+    this->faultyStamp.assign(this->faultyStamp.size(), -1);
+}
+
+/*
+* Function to apply the test vector and grade the faults
+* @param testVector -> test vector applied
+* @return bool -> if test vector applied successfully
+*/
+bool PatternParallelFaultSim::apply_test_vector(std::string testVector)
+{
+    std::vector<std::set<std::pair<int, int>>> detectedFaults;
+    return this->apply_test_vectors(std::vector<std::string>(1, testVector), detectedFaults);
+}
+
+/*
+* Function to apply a block of test vectors, 64 vectors per simulation pass
+* @param testVectors -> test vectors applied
+* @param detectedFaults -> faults detected by each vector (updated in place)
+* @return bool -> if all test vectors applied successfully
+*/
+bool PatternParallelFaultSim::apply_test_vectors(const std::vector<std::string>& testVectors,
+    std::vector<std::set<std::pair<int, int>>>& detectedFaults)
+{
+    detectedFaults.clear();
+    std::vector<uint64_t> inputWords;
+    for (unsigned int first = 0; first < testVectors.size(); first += 64)
+    {
+        std::vector<std::string> blockVectors(testVectors.begin() + first,
+            testVectors.begin() + std::min<size_t>(first + 64, testVectors.size()));
+        if (this->pack_test_vectors(blockVectors, inputWords) == false)
+        {
+            return false;
+        }
+        this->apply_input_words(inputWords, blockVectors.size());
+        this->append_detected_faults(detectedFaults);
+    }
+    return true;
+}
+
+/*
+* Function to grade the faults as transition faults on vector pairs, 64 pairs per pass
+* Fault type 0 is slow-to-rise and 1 is slow-to-fall
+* @param vectorPairs -> pair of entry => first = initialization vector, second = launch vector
+* @param detectedFaults -> faults detected by each pair (updated in place)
+* @return bool -> if all vector pairs applied successfully
+*/
+bool PatternParallelFaultSim::apply_vector_pairs(const std::vector<std::pair<std::string, std::string>>& vectorPairs,
+    std::vector<std::set<std::pair<int, int>>>& detectedFaults)
+{
+    detectedFaults.clear();
+    std::vector<uint64_t> initialInputWords, launchInputWords;
+    for (unsigned int first = 0; first < vectorPairs.size(); first += 64)
+    {
+        std::vector<std::string> initialVectors, launchVectors;
+        for (unsigned int k = first; k < vectorPairs.size() && k < first + 64; ++k)
+        {
+            initialVectors.push_back(vectorPairs[k].first);
+            launchVectors.push_back(vectorPairs[k].second);
+        }
+        if (this->pack_test_vectors(initialVectors, initialInputWords) == false ||
+            this->pack_test_vectors(launchVectors, launchInputWords) == false)
+        {
+            return false;
+        }
+        this->apply_transition_pairs(initialInputWords, launchInputWords, initialVectors.size());
+        this->append_detected_faults(detectedFaults);
+    }
+    return true;
+}
+
+/*
+* Function to pack up to 64 test vectors into primary input words, vector k in bit k
+* @param testVectors -> test vectors to pack
+* @param inputWords -> word per primary input (updated in place)
+* @return bool -> if all test vectors parsed successfully
+*/
+bool PatternParallelFaultSim::pack_test_vectors(const std::vector<std::string>& testVectors,
+    std::vector<uint64_t>& inputWords)
+{
+    inputWords.assign(this->topology->inputNodes.size(), 0);
+    std::vector<int> inputValues;
+    for (unsigned int k = 0; k < testVectors.size(); ++k)
+    {
+        if (this->topology->parse_test_vector(testVectors[k], inputValues) == false)
+        {
+            return false;
+        }
+        for (unsigned int i = 0; i < inputValues.size(); ++i)
+        {
+            inputWords[i] |= (uint64_t)inputValues[i] << k;
+        }
+    }
+    return true;
+}
+
+/*
+* Function to convert the detections of the last block to fault sets
+* @param detectedFaults -> faults detected by each vector, appended (updated in place)
+*/
+void PatternParallelFaultSim::append_detected_faults(std::vector<std::set<std::pair<int, int>>>& detectedFaults)
+{
+    for (int k = 0; k < this->blockVectors; ++k)
+    {
+        std::set<std::pair<int, int>> vectorFaults;
+        for (int faultIndex : this->detectedPerVector[k])
+        {
+            vectorFaults.insert(this->topology->faultList[faultIndex]);
+        }
+        detectedFaults.push_back(vectorFaults);
+    }
+}
+
+/*
+* Function to get the fault indices detected by a vector of the last block
+* @param vectorIndex -> position of the vector in the block
+* @return vector of int -> sorted indices into the topology fault list
+*/
+const std::vector<int>& PatternParallelFaultSim::get_detected_fault_indices(int vectorIndex)
+{
+    return this->detectedPerVector[vectorIndex];
+}
+
+/*
+* Function to get the output vector of the good circuit
+* @return string -> output vector for the last test vector
+*/
+std::string PatternParallelFaultSim::get_output_vector_lin()
+{
+    std::string outputVector = "";
+    for (int nodeIndex : this->topology->outputNodes)
+    {
+        outputVector += std::to_string((this->goodWords[nodeIndex] >> (this->blockVectors - 1)) & 1);
+    }
+    return outputVector;
+}
+
+/*
+* Function to get the faults detected by the last test vector
+* @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+*/
+std::set<std::pair<int, int>> PatternParallelFaultSim::get_list_detected_faults()
+{
+    std::set<std::pair<int, int>> finalFaultList;
+    if (this->blockVectors > 0)
+    {
+        for (int faultIndex : this->detectedPerVector[this->blockVectors - 1])
+        {
+            finalFaultList.insert(this->topology->faultList[faultIndex]);
+        }
+    }
+    return finalFaultList;
+}
+
+/*
+* Function to get total faults graded by the engine
+* @return int -> total faults
+*/
+int PatternParallelFaultSim::get_total_faults_count()
+{
+    return this->topology->get_num_faults();
+}
+
+/*
+* Function to keep detected faults graded until N vectors detected them
+* @param inDetectionLimit -> detections counted per fault before it is dropped (1 to 255)
+* @return bool -> if the limit is supported
+*/
+bool PatternParallelFaultSim::set_detection_limit(int inDetectionLimit)
+{
+    if (inDetectionLimit < 1 || inDetectionLimit > 255)
+    {
+        return false;
+    }
+    this->detectionLimit = inDetectionLimit;
+    return true;
+}
+
+/*
+* Function to get the number of faults detected at least n times
+* @return vector of int -> entry n - 1 holds the faults detected n or more times
+*/
+std::vector<int> PatternParallelFaultSim::get_n_detect_counts()
+{
+    // histogram of the counters, accumulated from the top level down
+    std::vector<int> nDetectCounts(this->detectionLimit + 1, 0);
+    for (uint8_t detectionCount : this->detectionCounts)
+    {
+        ++nDetectCounts[detectionCount];
+    }
+    for (int n = this->detectionLimit - 1; n >= 1; --n)
+    {
+        nDetectCounts[n] += nDetectCounts[n + 1];
+    }
+    return std::vector<int>(nDetectCounts.begin() + 1, nDetectCounts.end());
+}
+
+/*
+* Function to get the detections counted per fault, for checkpointing
+* @param detectionCounts -> detections per fault in topology order (updated in place)
+* @return bool -> if the engine keeps detection state
+*/
+bool PatternParallelFaultSim::get_detection_state(std::vector<uint8_t>& detectionCounts)
+{
+    detectionCounts = this->detectionCounts;
+    return true;
+}
+
+/*
+* Function to restore the detections per fault before the first vector is applied
+* @param detectionCounts -> detections per fault returned by get_detection_state
+* @return bool -> if the counts match the fault list
+*/
+bool PatternParallelFaultSim::set_detection_state(const std::vector<uint8_t>& detectionCounts)
+{
+    if (detectionCounts.size() != this->detectionCounts.size())
+    {
+        return false;
+    }
+    for (unsigned int i = 0; i < detectionCounts.size(); ++i)
+    {
+        this->detectionCounts[i] = std::min<int>(detectionCounts[i], this->detectionLimit);
+        if (this->dropDetectedFaults && this->detectionCounts[i] == this->detectionLimit)
+        {
+            this->faultActive[i] = false;
+        }
+    }
+    return true;
+}
+
+/*
+* Function to get the work counters of the engine, for instrumentation
+* A gate evaluation covers all vectors of the block and no fault lists are kept
+* @param stats -> counters (updated in place)
+* @return bool -> always true
+*/
+bool PatternParallelFaultSim::get_simulation_stats(SimulationStats& stats)
+{
+    stats = SimulationStats();
+    stats.gatesEvaluated = this->gatesEvaluated;
+    stats.activeFaults = std::count(this->faultActive.begin(), this->faultActive.end(), true);
+    return true;
+}
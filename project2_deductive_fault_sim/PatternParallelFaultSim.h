@@ -0,0 +1,229 @@
+#ifndef __PATTERNPARALLELFAULTSIM_H__
+#define __PATTERNPARALLELFAULTSIM_H__
+
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdint>
+
+#include "FaultSimEngine.h"
+#include "LevelizedCircuit.h"
+
+/*
+* Parallel pattern single fault propagation (PPSFP) engine
+* Up to 64 test vectors are packed into one word per node, bit k holding the
+* value under vector k. The good machine is simulated once per block, then
+* every active fault is injected on its node and propagated through its
+* fanout cone only, as far as the faulty words differ from the good words.
+* The word of output differences gives the vectors detecting the fault.
+* For transition faults the words hold vector pairs: a slow-to-rise
+* (slow-to-fall) fault is modelled as s-a-0 (s-a-1) on the second vector,
+* excited only in the pairs whose first vector sets the node to 0 (1).
+*/
+class PatternParallelFaultSim : public FaultSimEngine
+{
+    // Read-only topology shared with other engines
+    LevelizedCircuit* topology;
+
+    // Good machine word per node for the current block
+    std::vector<uint64_t> goodWords;
+
+    // Good machine word per node under the first vectors of the pairs (transition faults)
+    std::vector<uint64_t> initialWords;
+
+    // Faulty machine word per node, valid where faultyStamp matches
+    std::vector<uint64_t> faultyWords;
+
+    // Node index to fault being propagated when its faulty word was set
+    std::vector<int> faultyStamp;
+
+    // Whether the fault is still graded (not dropped)
+    std::vector<bool> faultActive;
+
+    // Drop faults from the active set once detected
+    bool dropDetectedFaults;
+
+    // Detections counted per fault before it is dropped (N of N-detect)
+    int detectionLimit;
+
+    // Detections per fault, saturating at the detection limit
+    std::vector<uint8_t> detectionCounts;
+
+    // Gates scheduled for fault propagation, bucketed by level
+    std::vector<std::vector<int>> levelEvents;
+
+    // Whether the gate is already in the event buckets
+    std::vector<bool> gateScheduled;
+
+    // Number of vectors in the current block
+    int blockVectors;
+
+    // Fault indices detected by each vector of the current block
+    std::vector<std::vector<int>> detectedPerVector;
+
+    // Gate word evaluations of the good and faulty machines since construction
+    long long gatesEvaluated;
+
+    /*
+    * Function to get the faulty word of a node for the fault being propagated
+    * @param nodeIndex -> index of the node
+    * @param faultIndex -> fault being propagated
+    * @return uint64_t -> faulty word, good word if not reached by the fault
+    */
+    uint64_t get_faulty_word(int nodeIndex, int faultIndex);
+
+    /*
+    * Function to propagate a fault through its fanout cone
+    * @param faultIndex -> fault to propagate
+    * @param validMask -> bits of the vectors in the block where the fault may be excited
+    * @return uint64_t -> bits of the vectors detecting the fault
+    */
+    uint64_t propagate_fault(int faultIndex, uint64_t validMask);
+
+    /*
+    * Function to simulate the good machine on packed primary input words
+    * @param inputWords -> word per primary input
+    */
+    void simulate_good_words(const std::vector<uint64_t>& inputWords);
+
+    /*
+    * Function to propagate all active faults and collect the detections per vector
+    * @param numVectors -> number of vectors (or pairs) packed in the words
+    * @param isTransition -> faults are transition faults conditioned on initialWords
+    */
+    void grade_active_faults(int numVectors, bool isTransition);
+
+    /*
+    * Function to pack up to 64 test vectors into primary input words, vector k in bit k
+    * @param testVectors -> test vectors to pack
+    * @param inputWords -> word per primary input (updated in place)
+    * @return bool -> if all test vectors parsed successfully
+    */
+    bool pack_test_vectors(const std::vector<std::string>& testVectors, std::vector<uint64_t>& inputWords);
+
+    /*
+    * Function to convert the detections of the last block to fault sets
+    * @param detectedFaults -> faults detected by each vector, appended (updated in place)
+    */
+    void append_detected_faults(std::vector<std::set<std::pair<int, int>>>& detectedFaults);
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inTopology -> levelized circuit to simulate
+    */
+    PatternParallelFaultSim(LevelizedCircuit* inTopology);
+
+    /*
+    * Function to enable dropping of detected faults
+    * When enabled, a fault is reported only by the first N vectors detecting it
+    * @param inDropDetectedFaults -> drop faults once detected
+    */
+    void set_fault_dropping(bool inDropDetectedFaults);
+
+    /*
+    * Function to apply the test vector and grade the faults
+    * @param testVector -> test vector applied
+    * @return bool -> if test vector applied successfully
+    */
+    bool apply_test_vector(std::string testVector) override;
+
+    /*
+    * Function to apply a block of test vectors, 64 vectors per simulation pass
+    * @param testVectors -> test vectors applied
+    * @param detectedFaults -> faults detected by each vector (updated in place)
+    * @return bool -> if all test vectors applied successfully
+    */
+    bool apply_test_vectors(const std::vector<std::string>& testVectors,
+        std::vector<std::set<std::pair<int, int>>>& detectedFaults) override;
+
+    /*
+    * Function to apply up to 64 test vectors given as packed primary input words
+    * @param inputWords -> word per primary input, bit k is the value under vector k
+    * @param numVectors -> number of vectors packed in the words (1 to 64)
+    */
+    void apply_input_words(const std::vector<uint64_t>& inputWords, int numVectors);
+
+    /*
+    * Function to grade the faults as transition faults on up to 64 vector pairs
+    * Fault type 0 is slow-to-rise and 1 is slow-to-fall
+    * @param initialInputWords -> word per primary input for the initialization vectors
+    * @param launchInputWords -> word per primary input for the launch vectors
+    * @param numPairs -> number of pairs packed in the words (1 to 64)
+    */
+    void apply_transition_pairs(const std::vector<uint64_t>& initialInputWords,
+        const std::vector<uint64_t>& launchInputWords, int numPairs);
+
+    /*
+    * Function to grade the faults as transition faults on vector pairs, 64 pairs per pass
+    * Fault type 0 is slow-to-rise and 1 is slow-to-fall
+    * @param vectorPairs -> pair of entry => first = initialization vector, second = launch vector
+    * @param detectedFaults -> faults detected by each pair (updated in place)
+    * @return bool -> if all vector pairs applied successfully
+    */
+    bool apply_vector_pairs(const std::vector<std::pair<std::string, std::string>>& vectorPairs,
+        std::vector<std::set<std::pair<int, int>>>& detectedFaults);
+
+    /*
+    * Function to get the fault indices detected by a vector of the last block
+    * @param vectorIndex -> position of the vector in the block
+    * @return vector of int -> sorted indices into the topology fault list
+    */
+    const std::vector<int>& get_detected_fault_indices(int vectorIndex);
+
+    /*
+    * Function to get the output vector of the good circuit
+    * @return string -> output vector for the last test vector
+    */
+    std::string get_output_vector_lin() override;
+
+    /*
+    * Function to get the faults detected by the last test vector
+    * @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+    */
+    std::set<std::pair<int, int>> get_list_detected_faults() override;
+
+    /*
+    * Function to get total faults graded by the engine
+    * @return int -> total faults
+    */
+    int get_total_faults_count() override;
+
+    /*
+    * Function to keep detected faults graded until N vectors detected them
+    * @param inDetectionLimit -> detections counted per fault before it is dropped (1 to 255)
+    * @return bool -> if the limit is supported
+    */
+    bool set_detection_limit(int inDetectionLimit) override;
+
+    /*
+    * Function to get the number of faults detected at least n times
+    * @return vector of int -> entry n - 1 holds the faults detected n or more times
+    */
+    std::vector<int> get_n_detect_counts() override;
+
+    /*
+    * Function to get the detections counted per fault, for checkpointing
+    * @param detectionCounts -> detections per fault in topology order (updated in place)
+    * @return bool -> if the engine keeps detection state
+    */
+    bool get_detection_state(std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to restore the detections per fault before the first vector is applied
+    * @param detectionCounts -> detections per fault returned by get_detection_state
+    * @return bool -> if the counts match the fault list
+    */
+    bool set_detection_state(const std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to get the work counters of the engine, for instrumentation
+    * A gate evaluation covers all vectors of the block and no fault lists are kept
+    * @param stats -> counters (updated in place)
+    * @return bool -> always true
+    */
+    bool get_simulation_stats(SimulationStats& stats) override;
+};
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef __PATTERNSOURCE_H__
+#define __PATTERNSOURCE_H__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/*
+* Interface for the test pattern generators
+* A pattern of width bits is packed into 64-bit words, bit i of the pattern
+* (value of primary input i) is bit i % 64 of word i / 64. Bits past the
+* width are always 0 so that packed patterns can be compared and hashed.
+*/
+class PatternSource
+{
+public:
+
+    /*
+    * Function to generate the next pattern
+    * @param patternWords -> packed pattern (updated in place)
+    */
+    virtual void next_pattern(std::vector<uint64_t>& patternWords) = 0;
+
+    /*
+    * Function to get the pattern width
+    * @return int -> number of bits per pattern
+    */
+    virtual int get_width() = 0;
+
+    /*
+    * Function to get the generator state, for checkpointing
+    * @return vector of uint64_t -> state words
+    */
+    virtual std::vector<uint64_t> get_state() = 0;
+
+    /*
+    * Function to restore a generator state returned by get_state
+    * @param stateWords -> state words
+    * @return bool -> if the state is valid for the generator
+    */
+    virtual bool set_state(const std::vector<uint64_t>& stateWords) = 0;
+
+    /*
+    * Destructor for the class
+    */
+    virtual ~PatternSource() {}
+};
+
+/*
+* Hash of a packed pattern for deduplication
+*/
+struct PatternWordsHash
+{
+    size_t operator()(const std::vector<uint64_t>& patternWords) const
+    {
+        uint64_t hashValue = 0x9e3779b97f4a7c15ULL;
+        for (uint64_t word : patternWords)
+        {
+            // mix each word in (splitmix64 finalizer)
+            uint64_t mixed = word + 0x9e3779b97f4a7c15ULL + (hashValue << 6) + (hashValue >> 2);
+            mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+            hashValue ^= mixed ^ (mixed >> 31);
+        }
+        return hashValue;
+    }
+};
+
+/*
+* Function to get the number of words of a packed pattern
+* @param width -> number of bits per pattern
+* @return int -> number of 64-bit words
+*/
+inline int get_pattern_words(int width)
+{
+    return (width + 63) / 64;
+}
+
+/*
+* Function to convert a packed pattern to a test vector
+* @param patternWords -> packed pattern
+* @param width -> number of bits per pattern
+* @return string -> test vector, character i is the value of input i
+*/
+inline std::string pattern_to_string(const std::vector<uint64_t>& patternWords, int width)
+{
+    std::string testVector(width, '0');
+    for (int i = 0; i < width; ++i)
+    {
+        if ((patternWords[i / 64] >> (i % 64)) & 1)
+        {
+            testVector[i] = '1';
+        }
+    }
+    return testVector;
+}
+
+#endif
@@ -0,0 +1,537 @@
+#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <csignal>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include "ProcessFaultSim.h"
+#include "ConcurrentFaultSim.h"
+
+// Milliseconds waited for worker results before checking the worker is alive
+const long processPollMillis = 100;
+
+/*
+* Function to write result words to the ring of a worker, waiting for space
+* @param channel -> channel of the worker
+* @param words -> words to write
+* @param numWords -> number of words to write
+*/
+static void write_words(ProcessChannel* channel, const uint32_t* words, size_t numWords)
+{
+    while (numWords > 0)
+    {
+        uint64_t writePos = channel->writePos;
+        uint64_t readPos = __atomic_load_n(&channel->readPos, __ATOMIC_ACQUIRE);
+        size_t freeWords = processRingWords - (writePos - readPos);
+        if (freeWords == 0)
+        {
+            // ring full => wait for the coordinator to read
+            while (sem_wait(&channel->spaceSem) != 0 && errno == EINTR);
+            continue;
+        }
+        size_t chunkWords = std::min(numWords, freeWords);
+        for (size_t i = 0; i < chunkWords; ++i)
+        {
+            channel->ring[(writePos + i) % processRingWords] = words[i];
+        }
+        __atomic_store_n(&channel->writePos, writePos + chunkWords, __ATOMIC_RELEASE);
+        sem_post(&channel->dataSem);
+        words += chunkWords;
+        numWords -= chunkWords;
+    }
+}
+
+/*
+* Constructor for the class
+* @param inTopology -> levelized circuit to simulate
+* @param numProcesses -> number of worker processes (0 => online processors)
+* @param inDropDetectedFaults -> drop faults once detected
+*/
+ProcessFaultSim::ProcessFaultSim(LevelizedCircuit* inTopology, int numProcesses, bool inDropDetectedFaults) :
+    topology(inTopology), dropDetectedFaults(inDropDetectedFaults), detectionLimit(1),
+    sharedMemory(NULL), sharedSize(0), isFailed(false)
+{
+    if (numProcesses <= 0)
+    {
+        numProcesses = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    // no point in workers without faults
+    numProcesses = std::max(1, std::min(numProcesses, this->topology->get_num_faults()));
+
+    // Interleave the faults so that every partition spreads across the circuit
+    this->partitions.assign(numProcesses, std::vector<int>());
+    for (int i = 0; i < this->topology->get_num_faults(); ++i)
+    {
+        this->partitions[i % numProcesses].push_back(i);
+    }
+}
+
+/*
+* Function to get the number of worker processes
+* @return int -> number of workers
+*/
+int ProcessFaultSim::get_num_processes()
+{
+    return this->partitions.size();
+}
+
+/*
+* Function to get the command header in shared memory
+* @return ProcessCommandHeader* -> command header
+*/
+ProcessCommandHeader* ProcessFaultSim::get_header()
+{
+    return (ProcessCommandHeader*)this->sharedMemory;
+}
+
+/*
+* Function to get the result channel of a worker in shared memory
+* @param workerIndex -> index of the worker
+* @return ProcessChannel* -> channel of the worker
+*/
+ProcessChannel* ProcessFaultSim::get_channel(int workerIndex)
+{
+    return (ProcessChannel*)((uint8_t*)this->sharedMemory + processHeaderBytes) + workerIndex;
+}
+
+/*
+* Function to get the input values of the block in shared memory
+* @return uint8_t* -> input values, vector after vector
+*/
+uint8_t* ProcessFaultSim::get_block_inputs()
+{
+    return (uint8_t*)this->get_channel(this->partitions.size());
+}
+
+/*
+* Function to map the shared memory and fork the workers
+* @return bool -> if all workers started
+*/
+bool ProcessFaultSim::start_workers()
+{
+    int numWorkers = this->partitions.size();
+    this->sharedSize = processHeaderBytes + sizeof(ProcessChannel) * numWorkers +
+        processBlockVectors * this->topology->inputNodes.size();
+    this->sharedMemory = mmap(NULL, this->sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (this->sharedMemory == MAP_FAILED)
+    {
+        std::cerr << "Unable to map shared memory for the worker processes\n";
+        this->sharedMemory = NULL;
+        return false;
+    }
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        ProcessChannel* channel = this->get_channel(i);
+        sem_init(&channel->startSem, 1, 0);
+        sem_init(&channel->dataSem, 1, 0);
+        sem_init(&channel->spaceSem, 1, 0);
+        channel->writePos = 0;
+        channel->readPos = 0;
+    }
+
+    // buffered output must not be written again by the children
+    std::cout.flush();
+    std::cerr.flush();
+    pid_t coordinatorPid = getpid();
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        pid_t workerPid = fork();
+        if (workerPid == -1)
+        {
+            std::cerr << "Unable to fork worker process " << i << "\n";
+            return false;
+        }
+        if (workerPid == 0)
+        {
+            // worker must not outlive the coordinator
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != coordinatorPid)
+            {
+                _exit(1);
+            }
+            this->run_worker(i);
+            _exit(0);
+        }
+        this->workerPids.push_back(workerPid);
+    }
+    return true;
+}
+
+/*
+* Function run by a forked worker until told to exit
+* @param workerIndex -> index of the worker
+*/
+void ProcessFaultSim::run_worker(int workerIndex)
+{
+    // Simulation state is allocated by the worker itself
+    ConcurrentFaultSim worker(this->topology);
+    worker.set_active_faults(this->partitions[workerIndex]);
+    worker.set_fault_dropping(this->dropDetectedFaults);
+    worker.set_detection_limit(this->detectionLimit);
+    if (this->initialCounts.size() > 0)
+    {
+        worker.set_detection_state(this->initialCounts);
+    }
+
+    ProcessChannel* channel = this->get_channel(workerIndex);
+    int numInputs = this->topology->inputNodes.size();
+    std::vector<int> inputValues(numInputs);
+    std::vector<uint32_t> resultWords;
+    while (true)
+    {
+        while (sem_wait(&channel->startSem) != 0 && errno == EINTR);
+        ProcessCommandHeader* header = this->get_header();
+        if (header->command == APPLY_BLOCK)
+        {
+            // per vector => number of detected faults followed by their indices
+            const uint8_t* blockInputs = this->get_block_inputs();
+            for (uint32_t j = 0; j < header->numVectors; ++j)
+            {
+                std::copy(blockInputs + j * numInputs, blockInputs + (j + 1) * numInputs, inputValues.begin());
+                worker.apply_input_values(inputValues);
+                std::vector<int> faultIndices = worker.get_detected_fault_indices();
+                resultWords.assign(1, faultIndices.size());
+                resultWords.insert(resultWords.end(), faultIndices.begin(), faultIndices.end());
+                write_words(channel, resultWords.data(), resultWords.size());
+            }
+        }
+        else if (header->command == SEND_COUNTS)
+        {
+            std::vector<uint8_t> detectionCounts;
+            worker.get_detection_state(detectionCounts);
+            resultWords.assign(detectionCounts.begin(), detectionCounts.end());
+            write_words(channel, resultWords.data(), resultWords.size());
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+/*
+* Function to send a command to all workers
+* @param command -> command to run
+* @param numVectors -> number of vectors in the block (APPLY_BLOCK)
+*/
+void ProcessFaultSim::send_command(processCommand command, int numVectors)
+{
+    ProcessCommandHeader* header = this->get_header();
+    header->command = command;
+    header->numVectors = numVectors;
+    for (unsigned int i = 0; i < this->workerPids.size(); ++i)
+    {
+        sem_post(&this->get_channel(i)->startSem);
+    }
+}
+
+/*
+* Function to read result words from a worker, waiting for them
+* @param workerIndex -> index of the worker
+* @param words -> words read (updated in place)
+* @param numWords -> number of words to read
+* @return bool -> if read, false if the worker exited
+*/
+bool ProcessFaultSim::read_words(int workerIndex, uint32_t* words, size_t numWords)
+{
+    ProcessChannel* channel = this->get_channel(workerIndex);
+    while (numWords > 0)
+    {
+        uint64_t readPos = channel->readPos;
+        uint64_t writePos = __atomic_load_n(&channel->writePos, __ATOMIC_ACQUIRE);
+        if (writePos == readPos)
+        {
+            // nothing written yet => wait, checking now and then that the worker is alive
+            timespec waitLimit;
+            clock_gettime(CLOCK_REALTIME, &waitLimit);
+            waitLimit.tv_nsec += processPollMillis * 1000000;
+            waitLimit.tv_sec += waitLimit.tv_nsec / 1000000000;
+            waitLimit.tv_nsec %= 1000000000;
+            if (sem_timedwait(&channel->dataSem, &waitLimit) != 0 && errno == ETIMEDOUT)
+            {
+                int workerStatus;
+                if (waitpid(this->workerPids[workerIndex], &workerStatus, WNOHANG) != 0)
+                {
+                    std::cerr << "Worker process " << workerIndex << " exited unexpectedly\n";
+                    this->workerPids[workerIndex] = -1;
+                    this->isFailed = true;
+                    return false;
+                }
+            }
+            continue;
+        }
+        size_t chunkWords = std::min<uint64_t>(numWords, writePos - readPos);
+        for (size_t i = 0; i < chunkWords; ++i)
+        {
+            words[i] = channel->ring[(readPos + i) % processRingWords];
+        }
+        __atomic_store_n(&channel->readPos, readPos + chunkWords, __ATOMIC_RELEASE);
+        sem_post(&channel->spaceSem);
+        words += chunkWords;
+        numWords -= chunkWords;
+    }
+    return true;
+}
+
+/*
+* Function to apply the test vector and grade the faults
+* @param testVector -> test vector applied
+* @return bool -> if test vector applied successfully
+*/
+bool ProcessFaultSim::apply_test_vector(std::string testVector)
+{
+    std::vector<std::set<std::pair<int, int>>> detectedPerVector;
+    return this->apply_test_vectors(std::vector<std::string>(1, testVector), detectedPerVector);
+}
+
+/*
+* Function to apply a block of test vectors in order on all workers
+* @param testVectors -> test vectors applied
+* @param detectedPerVector -> faults detected by each vector (updated in place)
+* @return bool -> if all test vectors applied successfully
+*/
+bool ProcessFaultSim::apply_test_vectors(const std::vector<std::string>& testVectors,
+    std::vector<std::set<std::pair<int, int>>>& detectedPerVector)
+{
+    detectedPerVector.clear();
+    if (testVectors.size() == 0)
+    {
+        return true;
+    }
+    if (this->isFailed || (this->workerPids.empty() && this->start_workers() == false))
+    {
+        this->isFailed = true;
+        return false;
+    }
+
+    std::vector<int> inputValues;
+    int numInputs = this->topology->inputNodes.size();
+    detectedPerVector.resize(testVectors.size());
+    for (unsigned int first = 0; first < testVectors.size(); first += processBlockVectors)
+    {
+        // Decode the block into shared memory, read-only for the workers until their results are read
+        int numVectors = std::min<size_t>(processBlockVectors, testVectors.size() - first);
+        uint8_t* blockInputs = this->get_block_inputs();
+        for (int j = 0; j < numVectors; ++j)
+        {
+            if (this->topology->parse_test_vector(testVectors[first + j], inputValues) == false)
+            {
+                return false;
+            }
+            std::copy(inputValues.begin(), inputValues.end(), blockInputs + j * numInputs);
+        }
+        this->send_command(APPLY_BLOCK, numVectors);
+
+        // Merge the per-vector detections of all partitions, streamed worker by worker
+        std::vector<uint32_t> faultIndices;
+        for (unsigned int i = 0; i < this->workerPids.size(); ++i)
+        {
+            for (int j = 0; j < numVectors; ++j)
+            {
+                uint32_t numDetected;
+                if (this->read_words(i, &numDetected, 1) == false)
+                {
+                    return false;
+                }
+                faultIndices.resize(numDetected);
+                if (this->read_words(i, faultIndices.data(), numDetected) == false)
+                {
+                    return false;
+                }
+                for (uint32_t faultIndex : faultIndices)
+                {
+                    detectedPerVector[first + j].insert(this->topology->faultList[faultIndex]);
+                }
+            }
+        }
+    }
+    this->detectedFaults = detectedPerVector.back();
+
+    // Good machine values of the last vector for the output vector
+    std::vector<int> nodeValues(this->topology->get_num_nodes(), 0);
+    for (int i = 0; i < numInputs; ++i)
+    {
+        nodeValues[this->topology->inputNodes[i]] = inputValues[i];
+    }
+    for (const LevelizedGate& currGate : this->topology->gates)
+    {
+        int input2Value = (currGate.input2 == -1) ? 0 : nodeValues[currGate.input2];
+        nodeValues[currGate.output] = evaluate_gate(currGate.logic, nodeValues[currGate.input1], input2Value);
+    }
+    this->outputVector = "";
+    for (int nodeIndex : this->topology->outputNodes)
+    {
+        this->outputVector += std::to_string(nodeValues[nodeIndex]);
+    }
+    return true;
+}
+
+/*
+* Function to get the output vector of the good circuit
+* @return string -> output vector for the last test vector
+*/
+std::string ProcessFaultSim::get_output_vector_lin()
+{
+    return this->outputVector;
+}
+
+/*
+* Function to get the faults detected by the last test vector
+* @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+*/
+std::set<std::pair<int, int>> ProcessFaultSim::get_list_detected_faults()
+{
+    return this->detectedFaults;
+}
+
+/*
+* Function to get total faults graded by the engine
+* @return int -> total faults across all partitions
+*/
+int ProcessFaultSim::get_total_faults_count()
+{
+    return this->topology->get_num_faults();
+}
+
+/*
+* Function to keep detected faults graded until N vectors detected them
+* @param inDetectionLimit -> detections counted per fault before it is dropped (1 to 255)
+* @return bool -> if the limit is supported (only before the workers are started)
+*/
+bool ProcessFaultSim::set_detection_limit(int inDetectionLimit)
+{
+    if (inDetectionLimit < 1 || inDetectionLimit > 255 || this->workerPids.size() > 0)
+    {
+        return false;
+    }
+    this->detectionLimit = inDetectionLimit;
+    return true;
+}
+
+/*
+* Function to get the number of faults detected at least n times over all workers
+* @return vector of int -> entry n - 1 holds the faults detected n or more times
+*/
+std::vector<int> ProcessFaultSim::get_n_detect_counts()
+{
+    std::vector<uint8_t> detectionCounts;
+    if (this->get_detection_state(detectionCounts) == false)
+    {
+        return std::vector<int>();
+    }
+    // histogram of the counters, accumulated from the top level down
+    std::vector<int> nDetectCounts(this->detectionLimit + 1, 0);
+    for (uint8_t detectionCount : detectionCounts)
+    {
+        ++nDetectCounts[detectionCount];
+    }
+    for (int n = this->detectionLimit - 1; n >= 1; --n)
+    {
+        nDetectCounts[n] += nDetectCounts[n + 1];
+    }
+    return std::vector<int>(nDetectCounts.begin() + 1, nDetectCounts.end());
+}
+
+/*
+* Function to get the detections counted per fault, for checkpointing
+* @param detectionCounts -> detections per fault in topology order (updated in place)
+* @return bool -> if the counts were collected from all workers
+*/
+bool ProcessFaultSim::get_detection_state(std::vector<uint8_t>& detectionCounts)
+{
+    int numFaults = this->topology->get_num_faults();
+    if (this->workerPids.empty())
+    {
+        // nothing graded yet
+        detectionCounts = this->initialCounts;
+        detectionCounts.resize(numFaults, 0);
+        return this->isFailed == false;
+    }
+    if (this->isFailed)
+    {
+        return false;
+    }
+
+    // partitions are disjoint => a fault is counted by one worker only
+    this->send_command(SEND_COUNTS, 0);
+    detectionCounts.assign(numFaults, 0);
+    std::vector<uint32_t> workerCounts(numFaults);
+    for (unsigned int i = 0; i < this->workerPids.size(); ++i)
+    {
+        if (this->read_words(i, workerCounts.data(), numFaults) == false)
+        {
+            return false;
+        }
+        for (int j = 0; j < numFaults; ++j)
+        {
+            detectionCounts[j] += workerCounts[j];
+        }
+    }
+    return true;
+}
+
+/*
+* Function to restore the detections per fault before the first vector is applied
+* @param detectionCounts -> detections per fault returned by get_detection_state
+* @return bool -> if the counts match the fault list (only before the workers are started)
+*/
+bool ProcessFaultSim::set_detection_state(const std::vector<uint8_t>& detectionCounts)
+{
+    if ((int)detectionCounts.size() != this->topology->get_num_faults() || this->workerPids.size() > 0)
+    {
+        return false;
+    }
+    this->initialCounts = detectionCounts;
+    return true;
+}
+
+/*
+* Function to stop the workers and unmap the shared memory
+*/
+void ProcessFaultSim::stop_workers()
+{
+    if (this->sharedMemory == NULL)
+    {
+        return;
+    }
+    for (unsigned int i = 0; i < this->workerPids.size(); ++i)
+    {
+        if (this->workerPids[i] == -1)
+        {
+            continue;
+        }
+        if (this->isFailed)
+        {
+            // a worker may be blocked on a full ring
+            kill(this->workerPids[i], SIGKILL);
+        }
+        else
+        {
+            ProcessCommandHeader* header = this->get_header();
+            header->command = EXIT_WORKER;
+            sem_post(&this->get_channel(i)->startSem);
+        }
+        waitpid(this->workerPids[i], NULL, 0);
+    }
+    for (unsigned int i = 0; i < this->partitions.size(); ++i)
+    {
+        ProcessChannel* channel = this->get_channel(i);
+        sem_destroy(&channel->startSem);
+        sem_destroy(&channel->dataSem);
+        sem_destroy(&channel->spaceSem);
+    }
+    munmap(this->sharedMemory, this->sharedSize);
+    this->sharedMemory = NULL;
+    this->workerPids.clear();
+}
+
+/*
+* Destructor for the class
+*/
+ProcessFaultSim::~ProcessFaultSim()
+{
+    this->stop_workers();
+}
@@ -0,0 +1,253 @@
+#ifndef __PROCESSFAULTSIM_H__
+#define __PROCESSFAULTSIM_H__
+
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdint>
+#include <semaphore.h>
+#include <sys/types.h>
+
+#include "FaultSimEngine.h"
+#include "LevelizedCircuit.h"
+
+// Number of 32-bit words in the result ring buffer of a worker
+const uint32_t processRingWords = 1 << 16;
+
+// Maximum number of test vectors sent to the workers per command
+const int processBlockVectors = 64;
+
+// Bytes reserved for the command header at the start of the shared memory
+const size_t processHeaderBytes = 64;
+
+/*
+* Enum for the commands sent to the worker processes
+*/
+enum processCommand
+{
+    // grade the test vectors of the block
+    APPLY_BLOCK = 0,
+    // send the detection counts of the partition
+    SEND_COUNTS = 1,
+    // leave the worker loop
+    EXIT_WORKER = 2
+};
+
+/*
+* Result channel of a worker process, in shared memory
+* Single producer (worker) single consumer (coordinator) ring of 32-bit
+* words. The positions only grow and are published with release/acquire
+* atomics; the semaphores only wake up the side waiting for data or space.
+*/
+struct ProcessChannel
+{
+    // Posted by the coordinator when a command is ready
+    sem_t startSem;
+    // Posted by the worker after words were written
+    sem_t dataSem;
+    // Posted by the coordinator after words were read
+    sem_t spaceSem;
+    // Words written by the worker
+    uint64_t writePos;
+    // Words read by the coordinator
+    uint64_t readPos;
+    // Ring buffer of result words
+    uint32_t ring[processRingWords];
+};
+
+/*
+* Command of the coordinator, in shared memory
+* Shared memory layout => command header (padded), one channel per worker,
+* then the input values of the block, one byte per primary input per vector
+*/
+struct ProcessCommandHeader
+{
+    // Command to run (processCommand)
+    uint32_t command;
+    // Number of test vectors in the block
+    uint32_t numVectors;
+};
+
+/*
+* Multi-process fault simulation engine
+* The fault universe is partitioned across forked worker processes, each
+* running a ConcurrentFaultSim restricted to its partition as in the
+* multi-threaded engine. The workers are forked on the first test vector,
+* after the levelized circuit is built, so they share its pages read-only
+* and allocate their own simulation state after the fork (first touch on
+* their own node). The coordinator writes the test vectors of a block into
+* shared memory, the workers stream the detected fault indices back through
+* their ring buffer and the coordinator merges them per vector. A worker
+* crashing fails the grading instead of the whole program.
+*/
+class ProcessFaultSim : public FaultSimEngine
+{
+    // Read-only topology shared with the workers
+    LevelizedCircuit* topology;
+
+    // Fault indices of each worker's partition
+    std::vector<std::vector<int>> partitions;
+
+    // Drop faults once detected
+    bool dropDetectedFaults;
+
+    // Detections counted per fault before it is dropped (N of N-detect)
+    int detectionLimit;
+
+    // Detection counts restored before the workers are started (empty => none)
+    std::vector<uint8_t> initialCounts;
+
+    // Process id of each worker (empty until started)
+    std::vector<pid_t> workerPids;
+
+    // Shared memory mapping
+    void* sharedMemory;
+
+    // Size of the shared memory mapping
+    size_t sharedSize;
+
+    // Whether a worker failed, the engine cannot grade further
+    bool isFailed;
+
+    // Output vector of the last test vector
+    std::string outputVector;
+
+    // Faults detected by the last test vector
+    std::set<std::pair<int, int>> detectedFaults;
+
+    /*
+    * Function to get the command header in shared memory
+    * @return ProcessCommandHeader* -> command header
+    */
+    ProcessCommandHeader* get_header();
+
+    /*
+    * Function to get the result channel of a worker in shared memory
+    * @param workerIndex -> index of the worker
+    * @return ProcessChannel* -> channel of the worker
+    */
+    ProcessChannel* get_channel(int workerIndex);
+
+    /*
+    * Function to get the input values of the block in shared memory
+    * @return uint8_t* -> input values, vector after vector
+    */
+    uint8_t* get_block_inputs();
+
+    /*
+    * Function to map the shared memory and fork the workers
+    * @return bool -> if all workers started
+    */
+    bool start_workers();
+
+    /*
+    * Function run by a forked worker until told to exit
+    * @param workerIndex -> index of the worker
+    */
+    void run_worker(int workerIndex);
+
+    /*
+    * Function to send a command to all workers
+    * @param command -> command to run
+    * @param numVectors -> number of vectors in the block (APPLY_BLOCK)
+    */
+    void send_command(processCommand command, int numVectors);
+
+    /*
+    * Function to read result words from a worker, waiting for them
+    * @param workerIndex -> index of the worker
+    * @param words -> words read (updated in place)
+    * @param numWords -> number of words to read
+    * @return bool -> if read, false if the worker exited
+    */
+    bool read_words(int workerIndex, uint32_t* words, size_t numWords);
+
+    /*
+    * Function to stop the workers and unmap the shared memory
+    */
+    void stop_workers();
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inTopology -> levelized circuit to simulate
+    * @param numProcesses -> number of worker processes (0 => online processors)
+    * @param inDropDetectedFaults -> drop faults once detected
+    */
+    ProcessFaultSim(LevelizedCircuit* inTopology, int numProcesses, bool inDropDetectedFaults);
+
+    /*
+    * Function to get the number of worker processes
+    * @return int -> number of workers
+    */
+    int get_num_processes();
+
+    /*
+    * Function to apply the test vector and grade the faults
+    * @param testVector -> test vector applied
+    * @return bool -> if test vector applied successfully
+    */
+    bool apply_test_vector(std::string testVector) override;
+
+    /*
+    * Function to apply a block of test vectors in order on all workers
+    * @param testVectors -> test vectors applied
+    * @param detectedPerVector -> faults detected by each vector (updated in place)
+    * @return bool -> if all test vectors applied successfully
+    */
+    bool apply_test_vectors(const std::vector<std::string>& testVectors,
+        std::vector<std::set<std::pair<int, int>>>& detectedPerVector) override;
+
+    /*
+    * Function to get the output vector of the good circuit
+    * @return string -> output vector for the last test vector
+    */
+    std::string get_output_vector_lin() override;
+
+    /*
+    * Function to get the faults detected by the last test vector
+    * @return std::set<std::pair<int, int>> -> pair of node-name and stuck at value
+    */
+    std::set<std::pair<int, int>> get_list_detected_faults() override;
+
+    /*
+    * Function to get total faults graded by the engine
+    * @return int -> total faults across all partitions
+    */
+    int get_total_faults_count() override;
+
+    /*
+    * Function to keep detected faults graded until N vectors detected them
+    * @param inDetectionLimit -> detections counted per fault before it is dropped (1 to 255)
+    * @return bool -> if the limit is supported (only before the workers are started)
+    */
+    bool set_detection_limit(int inDetectionLimit) override;
+
+    /*
+    * Function to get the number of faults detected at least n times over all workers
+    * @return vector of int -> entry n - 1 holds the faults detected n or more times
+    */
+    std::vector<int> get_n_detect_counts() override;
+
+    /*
+    * Function to get the detections counted per fault, for checkpointing
+    * @param detectionCounts -> detections per fault in topology order (updated in place)
+    * @return bool -> if the counts were collected from all workers
+    */
+    bool get_detection_state(std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Function to restore the detections per fault before the first vector is applied
+    * @param detectionCounts -> detections per fault returned by get_detection_state
+    * @return bool -> if the counts match the fault list (only before the workers are started)
+    */
+    bool set_detection_state(const std::vector<uint8_t>& detectionCounts) override;
+
+    /*
+    * Destructor for the class
+    */
+    ~ProcessFaultSim();
+};
+
+#endif
@@ -0,0 +1,78 @@
+#include <sstream>
+#include "RandomPatternSource.h"
+
+/*
+* Constructor for the class
+* @param inWidth -> number of bits per pattern
+* @param seed -> seed of the generator
+*/
+RandomPatternSource::RandomPatternSource(int inWidth, uint64_t seed) :
+    width(inWidth), generator(seed)
+{
+}
+
+/*
+* Function to generate the next pattern
+* @param patternWords -> packed pattern (updated in place)
+*/
+void RandomPatternSource::next_pattern(std::vector<uint64_t>& patternWords)
+{
+    int numWords = get_pattern_words(this->width);
+    patternWords.resize(numWords);
+    for (int i = 0; i < numWords; ++i)
+    {
+        patternWords[i] = this->generator();
+    }
+    if (this->width % 64 != 0)
+    {
+        patternWords[numWords - 1] &= (1ULL << (this->width % 64)) - 1;
+    }
+}
+
+/*
+* Function to get the pattern width
+* @return int -> number of bits per pattern
+*/
+int RandomPatternSource::get_width()
+{
+    return this->width;
+}
+
+/*
+* Function to get the generator state, for checkpointing
+* The engine state is taken from its textual form (state words and position)
+* @return vector of uint64_t -> state words
+*/
+std::vector<uint64_t> RandomPatternSource::get_state()
+{
+    std::stringstream stateStream;
+    stateStream << this->generator;
+    std::vector<uint64_t> stateWords;
+    uint64_t stateWord;
+    while (stateStream >> stateWord)
+    {
+        stateWords.push_back(stateWord);
+    }
+    return stateWords;
+}
+
+/*
+* Function to restore a generator state returned by get_state
+* @param stateWords -> state words
+* @return bool -> if the state is valid for the generator
+*/
+bool RandomPatternSource::set_state(const std::vector<uint64_t>& stateWords)
+{
+    std::stringstream stateStream;
+    for (uint64_t stateWord : stateWords)
+    {
+        stateStream << stateWord << " ";
+    }
+    std::mt19937_64 restoredGenerator;
+    if (!(stateStream >> restoredGenerator))
+    {
+        return false;
+    }
+    this->generator = restoredGenerator;
+    return true;
+}
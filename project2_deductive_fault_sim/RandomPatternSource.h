@@ -0,0 +1,57 @@
+#ifndef __RANDOMPATTERNSOURCE_H__
+#define __RANDOMPATTERNSOURCE_H__
+
+#include <vector>
+#include <random>
+#include <cstdint>
+
+#include "PatternSource.h"
+
+/*
+* Pseudo-random pattern generator
+* Every word of the pattern is drawn from a 64-bit Mersenne twister
+*/
+class RandomPatternSource : public PatternSource
+{
+    // Number of bits per pattern
+    int width;
+
+    // Random number generator
+    std::mt19937_64 generator;
+
+public:
+
+    /*
+    * Constructor for the class
+    * @param inWidth -> number of bits per pattern
+    * @param seed -> seed of the generator
+    */
+    RandomPatternSource(int inWidth, uint64_t seed);
+
+    /*
+    * Function to generate the next pattern
+    * @param patternWords -> packed pattern (updated in place)
+    */
+    void next_pattern(std::vector<uint64_t>& patternWords) override;
+
+    /*
+    * Function to get the pattern width
+    * @return int -> number of bits per pattern
+    */
+    int get_width() override;
+
+    /*
+    * Function to get the generator state, for checkpointing
+    * @return vector of uint64_t -> state words
+    */
+    std::vector<uint64_t> get_state() override;
+
+    /*
+    * Function to restore a generator state returned by get_state
+    * @param stateWords -> state words
+    * @return bool -> if the state is valid for the generator
+    */
+    bool set_state(const std::vector<uint64_t>& stateWords) override;
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include "SimulationStatsWriter.h"
+
+/*
+* Constructor for the class
+*/
+SimulationStatsWriter::SimulationStatsWriter() : isJson(false), numRecords(0), lastStats() {}
+
+/*
+* Function to escape a string for a JSON or CSV field
+* @param value -> string to escape
+* @return string -> quoted string
+*/
+std::string SimulationStatsWriter::quote(const std::string& value)
+{
+    std::string quotedValue = "\"";
+    for (char currChar : value)
+    {
+        if (currChar == '"')
+        {
+            // JSON escapes with a backslash, CSV doubles the quote
+            quotedValue += this->isJson ? "\\\"" : "\"\"";
+        }
+        else if (currChar == '\\' && this->isJson)
+        {
+            quotedValue += "\\\\";
+        }
+        else
+        {
+            quotedValue += currChar;
+        }
+    }
+    return quotedValue + "\"";
+}
+
+/*
+* Function to create the output file and write the CSV header or the JSON array start
+* @param path -> location of the output file
+* @return bool -> if the file was created
+*/
+bool SimulationStatsWriter::open(std::string path)
+{
+    this->outFile.open(path, std::ios::trunc);
+    if (this->outFile.is_open() == false)
+    {
+        std::cerr << "Unable to create instrumentation file: " << path << "\n";
+        return false;
+    }
+    this->isJson = (path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0);
+    this->numRecords = 0;
+    this->outFile << std::setprecision(9);
+    if (this->isJson)
+    {
+        this->outFile << "[";
+    }
+    else
+    {
+        this->outFile << "netlist,engine,vector,seconds,detected_faults,coverage,gates_evaluated,"
+            "list_operations,avg_list_length,max_list_length,active_faults\n";
+    }
+    return true;
+}
+
+/*
+* Function to start the records of a netlist graded by an engine
+* @param inNetlistPath -> netlist graded
+* @param inEngineName -> engine grading the netlist
+* @param engine -> engine whose counters are the baseline of the first record
+*/
+void SimulationStatsWriter::begin_run(std::string inNetlistPath, std::string inEngineName, FaultSimEngine* engine)
+{
+    this->netlistPath = inNetlistPath;
+    this->engineName = inEngineName;
+    this->lastStats = SimulationStats();
+    engine->get_simulation_stats(this->lastStats);
+}
+
+/*
+* Function to write the record of a test vector
+* @param vectorIndex -> index of the vector in the run
+* @param seconds -> wall time of the engine call grading the vector
+* @param detectedFaults -> faults detected so far
+* @param totalFaults -> total faults graded
+* @param engine -> engine that graded the vector
+*/
+void SimulationStatsWriter::write_record(int vectorIndex, double seconds, int detectedFaults, int totalFaults,
+    FaultSimEngine* engine)
+{
+    SimulationStats stats;
+    bool hasStats = engine->get_simulation_stats(stats);
+    double coverageValue = (totalFaults > 0) ? detectedFaults * 100.0 / totalFaults : 0;
+
+    // Counter fields, empty for engines without counters
+    std::string emptyField = this->isJson ? "null" : "";
+    std::string gatesField = emptyField, operationsField = emptyField, averageField = emptyField;
+    std::string maxField = emptyField, activeField = emptyField;
+    if (hasStats)
+    {
+        gatesField = std::to_string(stats.gatesEvaluated - this->lastStats.gatesEvaluated);
+        operationsField = std::to_string(stats.listOperations - this->lastStats.listOperations);
+        activeField = std::to_string(stats.activeFaults);
+        // engines keeping no fault lists report no list sizes
+        if (stats.numLists > 0)
+        {
+            std::ostringstream averageStream;
+            averageStream << std::setprecision(6) << (double)stats.listEntries / stats.numLists;
+            averageField = averageStream.str();
+            maxField = std::to_string(stats.maxListLength);
+        }
+        this->lastStats = stats;
+    }
+
+    if (this->isJson)
+    {
+        this->outFile << ((this->numRecords == 0) ? "\n" : ",\n");
+        this->outFile << "{\"netlist\":" << this->quote(this->netlistPath)
+            << ",\"engine\":" << this->quote(this->engineName)
+            << ",\"vector\":" << vectorIndex
+            << ",\"seconds\":" << seconds
+            << ",\"detected_faults\":" << detectedFaults
+            << ",\"coverage\":" << coverageValue
+            << ",\"gates_evaluated\":" << gatesField
+            << ",\"list_operations\":" << operationsField
+            << ",\"avg_list_length\":" << averageField
+            << ",\"max_list_length\":" << maxField
+            << ",\"active_faults\":" << activeField << "}";
+    }
+    else
+    {
+        this->outFile << this->quote(this->netlistPath) << "," << this->quote(this->engineName) << ","
+            << vectorIndex << "," << seconds << "," << detectedFaults << "," << coverageValue << ","
+            << gatesField << "," << operationsField << "," << averageField << ","
+            << maxField << "," << activeField << "\n";
+    }
+    ++this->numRecords;
+}
+
+/*
+* Function to finish the file (closes the JSON array)
+* @return bool -> if all records were written
+*/
+bool SimulationStatsWriter::close()
+{
+    if (this->outFile.is_open() == false)
+    {
+        return true;
+    }
+    if (this->isJson)
+    {
+        this->outFile << "\n]\n";
+    }
+    this->outFile.close();
+    return this->outFile.good();
+}
+
+/*
+* Destructor for the class, finishes the file if still open
+*/
+SimulationStatsWriter::~SimulationStatsWriter()
+{
+    this->close();
+}
@@ -0,0 +1,92 @@
+#ifndef __SIMULATIONSTATSWRITER_H__
+#define __SIMULATIONSTATSWRITER_H__
+
+#include <string>
+#include <fstream>
+
+#include "FaultSimEngine.h"
+
+/*
+* Class to write per vector instrumentation of a fault simulation run
+* One record per test vector: wall time of the engine call, coverage so far,
+* and the work of the engine for that vector (gate evaluations and fault list
+* operations as differences of the engine counters) with the fault list
+* sizes and active faults after the vector. Counter columns are left empty
+* (null in JSON) for engines without counters.
+*
+* The format follows the file extension: ".json" writes an array of objects,
+* anything else writes CSV with a header line.
+*/
+class SimulationStatsWriter
+{
+    // Output file
+    std::ofstream outFile;
+
+    // Write JSON instead of CSV
+    bool isJson;
+
+    // Records written so far
+    int numRecords;
+
+    // Netlist of the current run
+    std::string netlistPath;
+
+    // Engine of the current run
+    std::string engineName;
+
+    // Engine counters at the previous record, to compute the work per vector
+    SimulationStats lastStats;
+
+    /*
+    * Function to escape a string for a JSON or CSV field
+    * @param value -> string to escape
+    * @return string -> quoted string
+    */
+    std::string quote(const std::string& value);
+
+public:
+
+    /*
+    * Constructor for the class
+    */
+    SimulationStatsWriter();
+
+    /*
+    * Function to create the output file and write the CSV header or the JSON array start
+    * @param path -> location of the output file
+    * @return bool -> if the file was created
+    */
+    bool open(std::string path);
+
+    /*
+    * Function to start the records of a netlist graded by an engine
+    * @param inNetlistPath -> netlist graded
+    * @param inEngineName -> engine grading the netlist
+    * @param engine -> engine whose counters are the baseline of the first record
+    */
+    void begin_run(std::string inNetlistPath, std::string inEngineName, FaultSimEngine* engine);
+
+    /*
+    * Function to write the record of a test vector
+    * @param vectorIndex -> index of the vector in the run
+    * @param seconds -> wall time of the engine call grading the vector
+    * @param detectedFaults -> faults detected so far
+    * @param totalFaults -> total faults graded
+    * @param engine -> engine that graded the vector
+    */
+    void write_record(int vectorIndex, double seconds, int detectedFaults, int totalFaults,
+        FaultSimEngine* engine);
+
+    /*
+    * Function to finish the file (closes the JSON array)
+    * @return bool -> if all records were written
+    */
+    bool close();
+
+    /*
+    * Destructor for the class, finishes the file if still open
+    */
+    ~SimulationStatsWriter();
+};
+
+#endif
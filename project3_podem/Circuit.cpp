@@ -5,6 +5,7 @@
 #include <string>
 #include <list>
 #include <regex>
+#include <chrono>
 #include "Circuit.h"
 #include "Node.h"
 
@@ -118,10 +119,213 @@ bool Circuit::read_netlist(std::string netlistFile)
     for (auto node : node_map)
     {
         node.second->value = X;
+        node.second->dfrontierIndex = -1;
+        node.second->trailStamp = 0;
     }
+    for (int nodeName : this->outputNodes)
+    {
+        this->node_map[nodeName]->isPrimaryOutput = true;
+    }
+
+    // Testability measures guide the PODEM objective and backtrace
+    if (this->levelize() == false)
+    {
+        std::cerr << "Netlist has a combinational loop\n";
+        return false;
+    }
+    this->compute_scoap();
+    this->reset_xpath();
     return true;
 }
 
+/*
+* Function to order the gates topologically and assign the node and gate levels
+* @return bool -> if every gate could be ordered (no combinational loop)
+*/
+bool Circuit::levelize()
+{
+    // A gate is ready once all of its gate driven inputs are ordered
+    std::unordered_map<Gate*, int> inputsLeft;
+    this->levelizedGates.clear();
+    for (Gate* gate : this->gateList)
+    {
+        int numInputs = this->is_gate_output(gate->input1->name);
+        if (gate->is_single_input() == false && gate->input2 != gate->input1)
+        {
+            numInputs += this->is_gate_output(gate->input2->name);
+        }
+        inputsLeft[gate] = numInputs;
+        if (numInputs == 0)
+        {
+            this->levelizedGates.push_back(gate);
+        }
+    }
+    for (unsigned int i = 0; i < this->levelizedGates.size(); ++i)
+    {
+        for (Gate* fanoutGate : this->node_to_gate_map[this->levelizedGates[i]->output->name])
+        {
+            // a gate with both inputs on this node is listed twice and released on the first
+            if (--inputsLeft[fanoutGate] == 0)
+            {
+                this->levelizedGates.push_back(fanoutGate);
+            }
+        }
+    }
+    if (this->levelizedGates.size() != this->gateList.size())
+    {
+        return false;
+    }
+
+    // Inputs of a gate are levelized before it
+    int maxLevel = 0;
+    for (auto node : this->node_map)
+    {
+        node.second->level = 0;
+    }
+    for (Gate* gate : this->levelizedGates)
+    {
+        gate->level = gate->input1->level + 1;
+        if (gate->is_single_input() == false)
+        {
+            gate->level = std::max(gate->level, gate->input2->level + 1);
+        }
+        gate->output->level = gate->level;
+        gate->isScheduled = false;
+        maxLevel = std::max(maxLevel, gate->level);
+    }
+    this->levelBuckets.assign(maxLevel + 1, std::vector<Gate*>());
+    return true;
+}
+
+/*
+* Function to add SCOAP measures, saturating at scoapInfinity
+* @param measure1 -> first measure
+* @param measure2 -> second measure
+* @return int -> sum of the measures
+*/
+static int add_scoap(int measure1, int measure2)
+{
+    return std::min(scoapInfinity, measure1 + measure2);
+}
+
+/*
+* Function to compute the SCOAP controllability and observability of all nodes
+* Nodes that cannot be controlled or observed get scoapInfinity
+*/
+void Circuit::compute_scoap()
+{
+    for (auto node : this->node_map)
+    {
+        node.second->cc0 = scoapInfinity;
+        node.second->cc1 = scoapInfinity;
+        node.second->co = scoapInfinity;
+    }
+    for (int nodeName : this->inputNodes)
+    {
+        this->node_map[nodeName]->cc0 = 1;
+        this->node_map[nodeName]->cc1 = 1;
+    }
+
+    // Controllability from the inputs towards the outputs
+    for (Gate* gate : this->levelizedGates)
+    {
+        Node* input1 = gate->input1;
+        Node* input2 = gate->is_single_input() ? gate->input1 : gate->input2;
+        int allZero = add_scoap(input1->cc0, input2->cc0);
+        int allOne = add_scoap(input1->cc1, input2->cc1);
+        int anyZero = std::min(input1->cc0, input2->cc0);
+        int anyOne = std::min(input1->cc1, input2->cc1);
+        int cc0 = 0, cc1 = 0;
+        switch (gate->get_gate_logic())
+        {
+        case(and_l):
+            cc0 = anyZero;
+            cc1 = allOne;
+            break;
+        case(or_l):
+            cc0 = allZero;
+            cc1 = anyOne;
+            break;
+        case(nand_l):
+            cc0 = allOne;
+            cc1 = anyZero;
+            break;
+        case(nor_l):
+            cc0 = anyOne;
+            cc1 = allZero;
+            break;
+        case(xor_l):
+            cc0 = std::min(allZero, allOne);
+            cc1 = std::min(add_scoap(input1->cc0, input2->cc1), add_scoap(input1->cc1, input2->cc0));
+            break;
+        case(xnor_l):
+            cc0 = std::min(add_scoap(input1->cc0, input2->cc1), add_scoap(input1->cc1, input2->cc0));
+            cc1 = std::min(allZero, allOne);
+            break;
+        case(not_l):
+            cc0 = input1->cc1;
+            cc1 = input1->cc0;
+            break;
+        default:
+            cc0 = input1->cc0;
+            cc1 = input1->cc1;
+            break;
+        }
+        gate->output->cc0 = add_scoap(cc0, 1);
+        gate->output->cc1 = add_scoap(cc1, 1);
+    }
+
+    // Observability from the outputs towards the inputs, a stem takes its most observable branch
+    for (int nodeName : this->outputNodes)
+    {
+        this->node_map[nodeName]->co = 0;
+    }
+    for (auto itr = this->levelizedGates.rbegin(); itr != this->levelizedGates.rend(); ++itr)
+    {
+        Gate* gate = *itr;
+        std::vector<std::pair<Node*, Node*>> inputPairs(1, std::make_pair(gate->input1, gate->input2));
+        if (gate->is_single_input() == false)
+        {
+            inputPairs.push_back(std::make_pair(gate->input2, gate->input1));
+        }
+        for (std::pair<Node*, Node*> inputPair : inputPairs)
+        {
+            // the other input must be at its non-controlling value
+            int sideCost = 0;
+            switch (gate->get_gate_logic())
+            {
+            case(and_l):
+            case(nand_l):
+                sideCost = inputPair.second->cc1;
+                break;
+            case(or_l):
+            case(nor_l):
+                sideCost = inputPair.second->cc0;
+                break;
+            case(xor_l):
+            case(xnor_l):
+                sideCost = std::min(inputPair.second->cc0, inputPair.second->cc1);
+                break;
+            default:
+                break;
+            }
+            int inputObservability = add_scoap(add_scoap(gate->output->co, sideCost), 1);
+            inputPair.first->co = std::min(inputPair.first->co, inputObservability);
+        }
+    }
+}
+
+/*
+* Function to get the SCOAP controllability of a value on a node
+* @param inNode -> node to control
+* @param inValue -> value to set (Zero or One)
+* @return int -> CC0 or CC1 of the node
+*/
+int Circuit::get_controllability(Node* inNode, logicValue inValue)
+{
+    return (inValue == Zero) ? inNode->cc0 : inNode->cc1;
+}
+
 /*
 * Function to create nodes
 * @param nodeName -> name of node in netlist
@@ -213,6 +417,12 @@ void Circuit::add_node_gate_map(int inNode, Gate* inGate)
 
 /*
 * Backtrace function for PODEM
+* When every input has to be set (input value is non-controlling), the input
+* hardest to control is picked first so that a conflict shows up early.
+* When one input is enough (controlling value), the easiest input is picked.
+* Controllability is the SCOAP CC0/CC1 of the input.
+* Through xor/xnor the X input takes the value that gives the output value
+* with the other input, taken as 0 while it is X.
 * @param nodeName -> node name to start the back trace from
 * @param nodeValue -> value to obtain on the node
 * @return pair of primary input and logic value required found
@@ -226,7 +436,9 @@ std::pair<int, logicValue> Circuit::backtracePODEM(int nodeName, logicValue node
         bool didBackPropagate = false;
         for (auto gateToCheck : this->outputnode_to_gate_map[nodeName])
         {
-            logicValue inversionParity = gateToCheck->get_inversion_parity();
+            gateLogic logic = gateToCheck->get_gate_logic();
+            bool isXorGate = (logic == xor_l || logic == xnor_l);
+            logicValue inversionParity = isXorGate ? ((logic == xnor_l) ? One : Zero) : gateToCheck->get_inversion_parity();
             if ((newLogicValue == One && inversionParity == One) ||
                 (newLogicValue == Zero && inversionParity == Zero))
             {
@@ -237,20 +449,43 @@ std::pair<int, logicValue> Circuit::backtracePODEM(int nodeName, logicValue node
             newLogicValue = One;
             }
             Node* inputToCheck = NULL;
-            if (gateToCheck->input1->value == X)
+            if (gateToCheck->is_single_input() || gateToCheck->input2->value != X)
             {
-                nodeName = gateToCheck->input1->name;
-                inputLogicValue = newLogicValue;
-                didBackPropagate = true;
-                break;
+                inputToCheck = gateToCheck->input1;
+            }
+            else if (gateToCheck->input1->value != X)
+            {
+                inputToCheck = gateToCheck->input2;
             }
             else
             {
-                nodeName = gateToCheck->input2->name;
-                inputLogicValue = newLogicValue;
-                didBackPropagate = true;
-                break;
+                int controllability1 = this->get_controllability(gateToCheck->input1, newLogicValue);
+                int controllability2 = this->get_controllability(gateToCheck->input2, newLogicValue);
+                // xor/xnor have no controlling value => easiest input
+                bool allInputsNeeded = (isXorGate == false &&
+                    newLogicValue != gateToCheck->get_controlling_value());
+                if (allInputsNeeded == (controllability1 >= controllability2))
+                {
+                    inputToCheck = gateToCheck->input1;
+                }
+                else
+                {
+                    inputToCheck = gateToCheck->input2;
+                }
             }
+            if (isXorGate && gateToCheck->is_single_input() == false)
+            {
+                // a known 1 on the other input (good value of D is 1) inverts the value
+                Node* otherInput = (inputToCheck == gateToCheck->input1) ? gateToCheck->input2 : gateToCheck->input1;
+                if (otherInput->value == One || otherInput->value == D)
+                {
+                    newLogicValue = get_not_value(newLogicValue);
+                }
+            }
+            nodeName = inputToCheck->name;
+            inputLogicValue = newLogicValue;
+            didBackPropagate = true;
+            break;
         }
         if (didBackPropagate == false)
         {
@@ -264,7 +499,7 @@ std::pair<int, logicValue> Circuit::backtracePODEM(int nodeName, logicValue node
 * Objective function for PODEM
 * @return pair of node name and logic value for PODEM algorithm
 */
-std::pair<int, logicValue> Circuit::objectivePODEM(std::vector<int> dfrontier)
+std::pair<int, logicValue> Circuit::objectivePODEM(const std::vector<int>& dfrontier)
 {
     if (get_node_from_name(this->faultNodeName)->value == X)
     {
@@ -281,8 +516,30 @@ std::pair<int, logicValue> Circuit::objectivePODEM(std::vector<int> dfrontier)
     {
         return std::make_pair(-1, X);
     }
-    Gate* dfrontierGate = this->outputnode_to_gate_map[dfrontier.front()].front();
-    logicValue nonControlling = get_not_value(dfrontierGate->get_controlling_value());
+    // Propagate through the most observable D-frontier gate with an X-path (lowest name on ties)
+    int bestNodeName = -1;
+    for (int nodeName : dfrontier)
+    {
+        if (this->node_map[nodeName]->hasXPath == false)
+        {
+            continue;
+        }
+        int observability = this->node_map[nodeName]->co;
+        if (bestNodeName == -1 || observability < this->node_map[bestNodeName]->co ||
+            (observability == this->node_map[bestNodeName]->co && nodeName < bestNodeName))
+        {
+            bestNodeName = nodeName;
+        }
+    }
+    if (bestNodeName == -1)
+    {
+        return std::make_pair(-1, X);
+    }
+    Gate* dfrontierGate = this->outputnode_to_gate_map[bestNodeName].front();
+    // xor/xnor propagate the fault effect with any known side value, 0 is taken
+    gateLogic logic = dfrontierGate->get_gate_logic();
+    logicValue nonControlling = (logic == xor_l || logic == xnor_l) ? Zero :
+        get_not_value(dfrontierGate->get_controlling_value());
     if (dfrontierGate->input1->value == X)
     {
         return std::make_pair(dfrontierGate->input1->name, nonControlling);
@@ -292,204 +549,466 @@ std::pair<int, logicValue> Circuit::objectivePODEM(std::vector<int> dfrontier)
         return std::make_pair(dfrontierGate->input2->name, nonControlling);
     }
     std::cerr << "Dev Error: Unable to get objective, What to do?\n";
+    return std::make_pair(-1, X);
+}
+
+/*
+* Function to save the value of a node on the trail before it changes
+* Saved once per decision using the node stamp
+* @param inNode -> node about to change
+*/
+void Circuit::save_to_trail(Node* inNode)
+{
+    if (inNode->trailStamp != this->currentTrailStamp)
+    {
+        inNode->trailStamp = this->currentTrailStamp;
+        this->trail.push_back({ inNode, inNode->value });
+    }
 }
 
-void add_to_change_tracker(Circuit *ckt, int nodeName,
-    std::vector<std::pair<int, logicValue>>& changeTracker)
+/*
+* Function to undo the node changes of the trail back to a given size
+* @param trailStart -> trail size to go back to
+*/
+void Circuit::undo_trail(size_t trailStart)
 {
-    bool changeInTracker = false;
-    for (auto change : changeTracker)
+    while (this->trail.size() > trailStart)
     {
-        if (change.first == nodeName)
-        {
-            changeInTracker = true;
-        }
+        TrailEntry entry = this->trail.back();
+        this->trail.pop_back();
+        entry.node->value = entry.oldValue;
+        this->update_dfrontier_node(entry.node);
+        this->update_xpath(entry.node);
     }
-    if (changeInTracker == false)
+}
+
+/*
+* Function to add the fanout gates of a node to the implication event queue
+* @param inNode -> node whose value changed
+*/
+void Circuit::schedule_fanout(Node* inNode)
+{
+    for (Gate* gate : this->node_to_gate_map[inNode->name])
     {
-        changeTracker.push_back(std::make_pair(nodeName, ckt->node_map[nodeName]->value));
+        if (gate->isScheduled == false)
+        {
+            gate->isScheduled = true;
+            this->levelBuckets[gate->level].push_back(gate);
+        }
     }
 }
 
 /*
 * Function to perform imply
+* Gates are evaluated level by level, each at most once per implication
 * @param nodeName -> node name to start forward implication from
 * @param nodeValue -> node value to start the forward implication from
-* @param changeTracker -> vector to track the changes made in this imply
 * @return bool -> if forward implication possible with conflicts
 */
-bool Circuit::implyPODEM(int nodeName, logicValue nodeValue,
-    std::vector<std::pair<int, logicValue>> &changeTracker)
+bool Circuit::implyPODEM(int nodeName, logicValue nodeValue)
 {
-    add_to_change_tracker(this, nodeName, changeTracker);
-    for (auto gate : node_to_gate_map[nodeName])
+    Node* startNode = node_map[nodeName];
+    this->save_to_trail(startNode);
+    startNode->value = nodeValue;
+    bool isConsistent = startNode->set_fault_value();
+    this->update_dfrontier_node(startNode);
+    this->update_xpath(startNode);
+    if (isConsistent == false)
     {
-        // Update changes tracker to be able to revert on failed recursion
-        node_map[nodeName]->value = nodeValue;
-        if (node_map[nodeName]->set_fault_value() == false)
-        {
-            return false;
-        }
-        logicValue oldOutputValue = gate->output->value;
-        add_to_change_tracker(this, gate->output->name, changeTracker);
-        if (gate->simulate() == false)
-        {
-            return false;
-        }
-        if (gate->output->value == oldOutputValue)
+        return false;
+    }
+    this->schedule_fanout(startNode);
+
+    // Fanout gates are on higher levels => a gate is evaluated after all of its changed inputs
+    for (unsigned int level = startNode->level; level < this->levelBuckets.size(); ++level)
+    {
+        std::vector<Gate*>& bucket = this->levelBuckets[level];
+        for (Gate* gate : bucket)
         {
-            continue;
+            gate->isScheduled = false;
+            if (isConsistent == false)
+            {
+                // conflict found, only drain the queue
+                continue;
+            }
+            logicValue oldOutputValue = gate->output->value;
+            this->save_to_trail(gate->output);
+            isConsistent = gate->simulate();
+            if (gate->output->value != oldOutputValue)
+            {
+                this->update_dfrontier_node(gate->output);
+                this->update_xpath(gate->output);
+                this->schedule_fanout(gate->output);
+            }
         }
-        // imply further
-        if (implyPODEM(gate->output->name, gate->output->value, changeTracker) == false)
+        bucket.clear();
+    }
+    return isConsistent;
+}
+
+/*
+* Function to add or remove a gate from the dfrontier after a value change
+* @param gate -> gate to check
+*/
+void Circuit::update_dfrontier_gate(Gate* gate)
+{
+    // Gate is in the dfrontier if its output is X and a fault effect is on an input
+    bool isInDFrontier = false;
+    if (gate->output->value == X)
+    {
+        isInDFrontier = (gate->input1->value == D || gate->input1->value == DBar);
+        if (gate->is_single_input() == false)
         {
-            return false;
+            isInDFrontier = isInDFrontier || (gate->input2->value == D || gate->input2->value == DBar);
         }
     }
-    return true;
+    Node* outputNode = gate->output;
+    if (isInDFrontier && outputNode->dfrontierIndex == -1)
+    {
+        outputNode->dfrontierIndex = this->dfrontier.size();
+        this->dfrontier.push_back(outputNode->name);
+    }
+    else if (isInDFrontier == false && outputNode->dfrontierIndex != -1)
+    {
+        // Move the last entry into the freed position
+        int lastNodeName = this->dfrontier.back();
+        this->dfrontier[outputNode->dfrontierIndex] = lastNodeName;
+        this->node_map[lastNodeName]->dfrontierIndex = outputNode->dfrontierIndex;
+        this->dfrontier.pop_back();
+        outputNode->dfrontierIndex = -1;
+    }
 }
 
 /*
-* Function to update the dfrontier
-* @return vector containing d frontier gates
+* Function to update the dfrontier after the value of a node changed
+* Only the gate driving the node and the gates it feeds can change membership
+* @param changedNode -> node whose value changed
 */
-std::vector<int> Circuit::update_dfrontier()
+void Circuit::update_dfrontier_node(Node* changedNode)
 {
-    // Recreate the d-frontier
-    std::vector<int> localDFrontier;
-    for (auto nodeToGate : node_to_gate_map)
+    auto driverItr = this->outputnode_to_gate_map.find(changedNode->name);
+    if (driverItr != this->outputnode_to_gate_map.end())
     {
-        for (auto gate : nodeToGate.second)
+        this->update_dfrontier_gate(driverItr->second.front());
+    }
+    for (Gate* gate : this->node_to_gate_map[changedNode->name])
+    {
+        this->update_dfrontier_gate(gate);
+    }
+}
+
+/*
+* Function to set the X-path flags of all nodes for a circuit with all values X
+*/
+void Circuit::reset_xpath()
+{
+    for (auto node : this->node_map)
+    {
+        node.second->hasXPath = node.second->isPrimaryOutput;
+    }
+    // A gate output is ordered after its inputs => outputs are final when visited backwards
+    for (auto gateItr = this->levelizedGates.rbegin(); gateItr != this->levelizedGates.rend(); ++gateItr)
+    {
+        if ((*gateItr)->output->hasXPath)
         {
-            if (gate->output->value == X)
+            (*gateItr)->input1->hasXPath = true;
+            if ((*gateItr)->is_single_input() == false)
             {
-                if (gate->input1->value == D || gate->input1->value == DBar)
-                {
-                    // Add gate to dfrontier
-                    localDFrontier.push_back(gate->output->name);
-                    continue;
-                }
-                if (gate->is_single_input() == false)
-                {
-                    if (gate->input2->value == D || gate->input2->value == DBar)
-                    {
-                        // Add gate to dfrontier
-                        localDFrontier.push_back(gate->output->name);
-                        continue;
-                    }
-                }
-
+                (*gateItr)->input2->hasXPath = true;
             }
         }
     }
-
-    // Make the dfrontier entries unique
-    std::sort(localDFrontier.begin(), localDFrontier.end());
-    localDFrontier.erase(unique(localDFrontier.begin(), localDFrontier.end()), localDFrontier.end());
-    return localDFrontier;
 }
 
 /*
-* Function to revert changes from previous imply
-* @param ckt -> circuit object
-* @param changesTracker -> vector of nodes changed
+* Function to update the X-path flags after the value of a node changed
+* A change is propagated backwards to the inputs of the driving gate
+* until the flags stop changing
+* @param changedNode -> node whose value changed
 */
-void revert_changes(Circuit* ckt, std::vector<std::pair<int, logicValue>> changesTracker)
+void Circuit::update_xpath(Node* changedNode)
 {
-    for (auto change : changesTracker)
+    this->xpathWorklist.push_back(changedNode);
+    while (this->xpathWorklist.empty() == false)
     {
-        //std::cout << change.first << " " << print_logic_value(ckt->get_node_from_name(change.first)->value) << " " << print_logic_value(change.second) << "\n";
-        ckt->get_node_from_name(change.first)->value = change.second;
+        Node* node = this->xpathWorklist.back();
+        this->xpathWorklist.pop_back();
+        bool hasXPath = false;
+        if (node->value == X)
+        {
+            hasXPath = node->isPrimaryOutput;
+            for (Gate* gate : this->node_to_gate_map[node->name])
+            {
+                if (hasXPath)
+                {
+                    break;
+                }
+                hasXPath = gate->output->hasXPath;
+            }
+        }
+        if (hasXPath == node->hasXPath)
+        {
+            continue;
+        }
+        node->hasXPath = hasXPath;
+        auto driverItr = this->outputnode_to_gate_map.find(node->name);
+        if (driverItr != this->outputnode_to_gate_map.end())
+        {
+            Gate* driverGate = driverItr->second.front();
+            this->xpathWorklist.push_back(driverGate->input1);
+            if (driverGate->is_single_input() == false)
+            {
+                this->xpathWorklist.push_back(driverGate->input2);
+            }
+        }
     }
 }
 
 /*
-* Function to run PODEM on circuit
-* @return if podem run successfully
+* Function to check if the fault effect reached a primary output
+* @return bool -> if any primary output has D or DBar
 */
-bool Circuit::runPODEM()
+bool Circuit::is_fault_detected()
 {
-    // Check if fault propagated to any of the output nodes
-    for (auto nodeName : this->outputNodes)
+    for (int nodeName : this->outputNodes)
     {
-        if (get_node_from_name(nodeName)->value == D ||
-            get_node_from_name(nodeName)->value == DBar)
+        logicValue outputValue = this->node_map[nodeName]->value;
+        if (outputValue == D || outputValue == DBar)
         {
             return true;
         }
     }
+    return false;
+}
 
-    // Check and update the dfrontier
-    std::vector<int> dfrontier = this->update_dfrontier();
+/*
+* Function to check if the fault site is set to its stuck value
+* @return bool -> if the fault can no longer be activated
+*/
+bool Circuit::is_fault_activation_blocked()
+{
+    Node* faultNode = this->node_map[this->faultNodeName];
+    return (faultNode->is_stuck_at_0 && faultNode->value == Zero) ||
+        (faultNode->is_stuck_at_1 && faultNode->value == One);
+}
 
-    // Check for failure condition -> Target fault cnnot be activated
-    if (this->node_map[this->faultNodeName]->value != X &&
-        ((this->node_map[this->faultNodeName]->is_stuck_at_0 &&
-            this->node_map[this->faultNodeName]->value == Zero) ||
-            (this->node_map[this->faultNodeName]->is_stuck_at_1 &&
-                this->node_map[this->faultNodeName]->value == One)))
+/*
+* Function to check if the fault effect can still reach a primary output
+* @return bool -> if the X fault site or a D-frontier gate has an X-path to an output
+*/
+bool Circuit::has_xpath_to_output()
+{
+    Node* faultNode = this->node_map[this->faultNodeName];
+    if (faultNode->value == X)
     {
-        return false;
+        return faultNode->hasXPath;
     }
-    
-    // Find the objective to be achieved in this recursion of PODEM run
-    std::pair<int, logicValue> objective = this->objectivePODEM(dfrontier);
-
-    // Check failure in object function due to empty d-frontier
-    if (objective.first == -1)
+    for (int nodeName : this->dfrontier)
     {
-        return false;
+        if (this->node_map[nodeName]->hasXPath)
+        {
+            return true;
+        }
     }
+    return false;
+}
 
-    // If objective is setting value at primary input => only 2 things possible
-    // 1. Fault is at primary input => it is OK if the Dfrontier is empty during initial steps
-    // 2. Error condition that the dfrontier is empty
-    // Adding check for point 2
-    if (is_primary_input(objective.first) == true &&
-        objective.first != this->faultNodeName &&
-        dfrontier.size() == 0)
-    {
-        // no test can be found
-        return false;
-    }
+/*
+* Function to push a decision on the stack and imply it
+* @param nodeName -> primary input to assign
+* @param nodeValue -> value to assign
+* @return bool -> if the implication has no conflict
+*/
+bool Circuit::push_decision(int nodeName, logicValue nodeValue)
+{
+    this->decisionStack.push_back({ nodeName, nodeValue, false, this->trail.size() });
+    ++this->currentTrailStamp;
+    return this->implyPODEM(nodeName, nodeValue);
+}
 
-    // Back trace towards a primary input to find the value to be set to achieve objective
-    std::pair<int, logicValue> backtrace = this->backtracePODEM(objective.first, objective.second);
-    std::cout << "Objective is, Node " << objective.first << " value " << print_logic_value(objective.second) << "\n";
-    std::cout << "Backtrace is, Node " << backtrace.first << " value " << print_logic_value(backtrace.second) << "\n\n";
-    // Imply the primary input value achieved from backtrace to update node values
-    // which can be updated through the path
+/*
+* Function to check if the time limit of the run is reached
+* @param startTime -> start of the run
+* @return bool -> if podemLimits.maxSeconds is set and has passed
+*/
+bool Circuit::is_time_limit_reached(std::chrono::steady_clock::time_point startTime)
+{
+    return this->podemLimits.maxSeconds > 0 && std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime).count() >= this->podemLimits.maxSeconds;
+}
 
-    // Create change tracker so as to reset the implied value if PODEM recusion fails
-    std::vector<std::pair<int, logicValue>> changeTracker;
-   // Recursively created more objectives till test generated
-    if (this->implyPODEM(backtrace.first, backtrace.second, changeTracker) == true)
+/*
+* Function to backtrack to the latest decision with an untried value and imply it
+* @param startTime -> start of the PODEM run, for the time limit
+* @return bool -> if a decision could be flipped without conflict, false once the
+* decisions are exhausted or an effort limit is reached (podemAborted set)
+*/
+bool Circuit::backtrack(std::chrono::steady_clock::time_point startTime)
+{
+    while (this->decisionStack.empty() == false)
     {
-        if (this->runPODEM() == true)
+        PodemDecision& decision = this->decisionStack.back();
+        this->undo_trail(decision.trailStart);
+        if (decision.flipped)
+        {
+            // both values failed => the input goes back to X
+            this->decisionStack.pop_back();
+            continue;
+        }
+
+        if ((this->podemLimits.maxBacktracks > 0 && this->numBacktracks >= this->podemLimits.maxBacktracks) ||
+            this->is_time_limit_reached(startTime))
+        {
+            this->podemAborted = true;
+            return false;
+        }
+        ++this->numBacktracks;
+        decision.flipped = true;
+        decision.value = get_not_value(decision.value);
+        ++this->currentTrailStamp;
+        if (this->implyPODEM(decision.nodeName, decision.value) == true)
         {
             return true;
         }
     }
+    return false;
+}
+
+/*
+* Function to run PODEM on circuit
+* Iterative search over the decision stack within the podemLimits
+* @return bool -> if a test was found, else the fault is redundant or aborted (podemAborted)
+*/
+bool Circuit::runPODEM()
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    this->decisionStack.clear();
+    this->trail.clear();
+    this->numBacktracks = 0;
+    this->podemAborted = false;
 
-    // If PODEM run failed, then try
-    // Revert changes (important as same circuit object re-used)
-    revert_changes(this, changeTracker);
-    changeTracker.clear();
-    if (this->implyPODEM(backtrace.first, get_not_value(backtrace.second), changeTracker) == true)
+    while (true)
     {
-        if (this->runPODEM() == true)
+        // Check if fault propagated to any of the output nodes
+        if (this->is_fault_detected())
         {
             return true;
         }
+
+        // A search without conflicts never backtracks, the time limit is checked on every decision
+        if (this->is_time_limit_reached(startTime))
+        {
+            this->podemAborted = true;
+            this->undo_trail(0);
+            this->decisionStack.clear();
+            return false;
+        }
+
+        // D-frontier is kept up to date by implication and undo
+        const std::vector<int>& dfrontier = this->dfrontier;
+
+        bool isConflict = false;
+        std::pair<int, logicValue> objective(-1, X);
+        // Check for failure condition -> Target fault cnnot be activated
+        if (this->is_fault_activation_blocked())
+        {
+            isConflict = true;
+        }
+        else if (this->has_xpath_to_output() == false)
+        {
+            // Fault effect is blocked on every path to the outputs
+            isConflict = true;
+        }
+        else
+        {
+            // Find the objective to be achieved by the next decision
+            objective = this->objectivePODEM(dfrontier);
+        }
+
+        // Check failure in object function due to empty d-frontier
+        if (isConflict == false && objective.first == -1)
+        {
+            isConflict = true;
+        }
+
+        // If objective is setting value at primary input => only 2 things possible
+        // 1. Fault is at primary input => it is OK if the Dfrontier is empty during initial steps
+        // 2. Error condition that the dfrontier is empty
+        // Adding check for point 2
+        if (isConflict == false &&
+            is_primary_input(objective.first) == true &&
+            objective.first != this->faultNodeName &&
+            dfrontier.size() == 0)
+        {
+            isConflict = true;
+        }
+
+        if (isConflict == false)
+        {
+            // Back trace towards a primary input to find the value to be set to achieve objective
+            std::pair<int, logicValue> backtrace = this->backtracePODEM(objective.first, objective.second);
+            if (this->printDecisions)
+            {
+                std::cout << "Objective is, Node " << objective.first << " value " << print_logic_value(objective.second) << "\n";
+                std::cout << "Backtrace is, Node " << backtrace.first << " value " << print_logic_value(backtrace.second) << "\n\n";
+            }
+            // Imply the primary input value achieved from backtrace to update node values
+            // which can be updated through the path, an X value cannot be decided on
+            isConflict = (backtrace.second == X ||
+                this->push_decision(backtrace.first, backtrace.second) == false);
+        }
+
+        // On failure try the other value of the latest open decision
+        if (isConflict && this->backtrack(startTime) == false)
+        {
+            // no test can be found or the effort limit is reached
+            this->undo_trail(0);
+            this->decisionStack.clear();
+            return false;
+        }
     }
+}
 
-    // If the reversed decision also failed, revert to unknown value
-    // Revert changes (important as same circuit object re-used)
-    revert_changes(this, changeTracker);
-    changeTracker.clear();
-    this->implyPODEM(backtrace.first, X, changeTracker);
+/*
+* Function to set all node values back to X and remove the fault
+* so that the circuit can be reused for the next target fault
+*/
+void Circuit::reset_values()
+{
+    for (auto node : this->node_map)
+    {
+        node.second->value = X;
+        node.second->is_stuck_at_0 = false;
+        node.second->is_stuck_at_1 = false;
+        node.second->dfrontierIndex = -1;
+        node.second->trailStamp = 0;
+    }
+    this->dfrontier.clear();
+    this->reset_xpath();
+}
 
-    return false;
+/*
+* Function to get the input vector generated by PODEM
+* @return string -> value per primary input (1, 0 or X), D and DBar resolved to the good value
+*/
+std::string Circuit::get_input_vector_lin()
+{
+    std::string inputVector = "";
+    for (int nodeName : this->inputNodes)
+    {
+        logicValue nodeValue = this->node_map[nodeName]->value;
+        // D = 1/0 and DBar = 0/1, the good value is applied
+        if (nodeValue == D)
+        {
+            nodeValue = One;
+        }
+        else if (nodeValue == DBar)
+        {
+            nodeValue = Zero;
+        }
+        inputVector += print_logic_value(nodeValue);
+    }
+    return inputVector;
 }
 
 /*
@@ -624,14 +1143,7 @@ bool Circuit::is_primary_output(int nodeName)
 */
 bool Circuit::is_gate_output(int nodeName)
 {
-    for (auto node : this->outputnode_to_gate_map)
-    {
-        if (nodeName == node.first)
-        {
-            return true;
-        }
-    }
-    return false;
+    return this->outputnode_to_gate_map.count(nodeName) > 0;
 }
 
 /*
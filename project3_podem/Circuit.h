@@ -5,10 +5,51 @@
 #include <unordered_map>
 #include <string>
 #include <list>
+#include <chrono>
 
 #include "Node.h"
 #include "Gate.h"
 
+// SCOAP measure of a node that cannot be controlled or observed
+const int scoapInfinity = 1 << 28;
+
+/*
+* Per fault effort limits of PODEM (or FAN) and the SAT back end, 0 => no limit
+*/
+struct PodemLimits
+{
+    // Backtracks (flipped decisions) before the fault is aborted
+    int maxBacktracks = 0;
+    // Seconds spent on the fault before it is aborted
+    double maxSeconds = 0;
+    // Conflicts of the SAT back end before the fault is aborted
+    int maxSatConflicts = 0;
+};
+
+/*
+* Primary input assignment on the PODEM decision stack
+*/
+struct PodemDecision
+{
+    // Primary input assigned
+    int nodeName;
+    // Value currently tried
+    logicValue value;
+    // Both values have been tried
+    bool flipped;
+    // Trail size before the assignment was implied
+    size_t trailStart;
+};
+
+/*
+* Node value saved on the PODEM trail, restored on backtrack
+*/
+struct TrailEntry
+{
+    Node* node;
+    logicValue oldValue;
+};
+
 /*
 * Class for the complete circuit
 */
@@ -36,9 +77,42 @@ public:
     // Vector of output nodes
     std::vector<int> outputNodes;
 
+    // Gates in topological order, inputs before outputs
+    std::vector<Gate*> levelizedGates;
+
+    // Implication event queue, gates to evaluate bucketed by level
+    std::vector<std::vector<Gate*>> levelBuckets;
+
+    // Nodes whose X-path flag is to be rechecked
+    std::vector<Node*> xpathWorklist;
+
+    // D-frontier gates given by their output node name, kept up to date on every value change
+    std::vector<int> dfrontier;
+
     // Single stuck at fault to generate test for
     int faultNodeName;
 
+    // Print the objective and backtrace of every PODEM decision
+    bool printDecisions = true;
+
+    // Effort limits applied to every PODEM run
+    PodemLimits podemLimits;
+
+    // Decisions of the current PODEM run, latest on top
+    std::vector<PodemDecision> decisionStack;
+
+    // Old values of the nodes changed by the decisions, in change order
+    std::vector<TrailEntry> trail;
+
+    // Stamp of the latest decision, a node is saved once per decision
+    int currentTrailStamp = 0;
+
+    // Backtracks done by the last PODEM run
+    int numBacktracks = 0;
+
+    // Last PODEM run stopped on an effort limit
+    bool podemAborted = false;
+
     /*
     * Function to read netlist and create circuit
     * @param netlistFile => location of the netlist
@@ -98,6 +172,26 @@ public:
     */
     void add_node_gate_map(int inNode, Gate* inGate);
 
+    /*
+    * Function to order the gates topologically and assign the node and gate levels
+    * @return bool -> if every gate could be ordered (no combinational loop)
+    */
+    bool levelize();
+
+    /*
+    * Function to compute the SCOAP controllability and observability of all nodes
+    * Nodes that cannot be controlled or observed get scoapInfinity
+    */
+    void compute_scoap();
+
+    /*
+    * Function to get the SCOAP controllability of a value on a node
+    * @param inNode -> node to control
+    * @param inValue -> value to set (Zero or One)
+    * @return int -> CC0 or CC1 of the node
+    */
+    int get_controllability(Node* inNode, logicValue inValue);
+
     /*
     * Backtrace function for PODEM
     * @param nodeName -> node name to start the back trace from
@@ -110,29 +204,122 @@ public:
     * Objective function for PODEM
     * @return pair of node name and logic value for PODEM algorithm
     */
-    std::pair<int, logicValue> objectivePODEM(std::vector<int> dfrontier);
+    std::pair<int, logicValue> objectivePODEM(const std::vector<int>& dfrontier);
+
+    /*
+    * Function to save the value of a node on the trail before it changes
+    * Saved once per decision using the node stamp
+    * @param inNode -> node about to change
+    */
+    void save_to_trail(Node* inNode);
+
+    /*
+    * Function to undo the node changes of the trail back to a given size
+    * @param trailStart -> trail size to go back to
+    */
+    void undo_trail(size_t trailStart);
+
+    /*
+    * Function to add the fanout gates of a node to the implication event queue
+    * @param inNode -> node whose value changed
+    */
+    void schedule_fanout(Node* inNode);
 
     /*
     * Function to perform imply
+    * Gates are evaluated level by level, each at most once per implication
     * @param nodeName -> node name to start forward implication from
     * @param nodeValue -> node value to start the forward implication from
     * @return bool -> if forward implication possible with conflicts
     */
-    bool implyPODEM(int nodeName, logicValue nodeValue,
-        std::vector<std::pair<int, logicValue>>& changeTracker);
+    bool implyPODEM(int nodeName, logicValue nodeValue);
+
+    /*
+    * Function to add or remove a gate from the dfrontier after a value change
+    * @param gate -> gate to check
+    */
+    void update_dfrontier_gate(Gate* gate);
+
+    /*
+    * Function to update the dfrontier after the value of a node changed
+    * Only the gate driving the node and the gates it feeds can change membership
+    * @param changedNode -> node whose value changed
+    */
+    void update_dfrontier_node(Node* changedNode);
+
+    /*
+    * Function to push a decision on the stack and imply it
+    * @param nodeName -> primary input to assign
+    * @param nodeValue -> value to assign
+    * @return bool -> if the implication has no conflict
+    */
+    bool push_decision(int nodeName, logicValue nodeValue);
 
     /*
-    * Function to update the dfrontier
-    * @return vector containing d frontier gates
+    * Function to check if the time limit of the run is reached
+    * @param startTime -> start of the run
+    * @return bool -> if podemLimits.maxSeconds is set and has passed
     */
-    std::vector<int> update_dfrontier();
+    bool is_time_limit_reached(std::chrono::steady_clock::time_point startTime);
+
+    /*
+    * Function to backtrack to the latest decision with an untried value and imply it
+    * @param startTime -> start of the PODEM run, for the time limit
+    * @return bool -> if a decision could be flipped without conflict, false once the
+    * decisions are exhausted or an effort limit is reached (podemAborted set)
+    */
+    bool backtrack(std::chrono::steady_clock::time_point startTime);
+
+    /*
+    * Function to set the X-path flags of all nodes for a circuit with all values X
+    */
+    void reset_xpath();
+
+    /*
+    * Function to update the X-path flags after the value of a node changed
+    * A change is propagated backwards to the inputs of the driving gate
+    * until the flags stop changing
+    * @param changedNode -> node whose value changed
+    */
+    void update_xpath(Node* changedNode);
+
+    /*
+    * Function to check if the fault effect reached a primary output
+    * @return bool -> if any primary output has D or DBar
+    */
+    bool is_fault_detected();
+
+    /*
+    * Function to check if the fault site is set to its stuck value
+    * @return bool -> if the fault can no longer be activated
+    */
+    bool is_fault_activation_blocked();
+
+    /*
+    * Function to check if the fault effect can still reach a primary output
+    * @return bool -> if the X fault site or a D-frontier gate has an X-path to an output
+    */
+    bool has_xpath_to_output();
 
     /*
     * Function to run PODEM on circuit
-    * @return if podem run successfully
+    * Iterative search over the decision stack within the podemLimits
+    * @return bool -> if a test was found, else the fault is redundant or aborted (podemAborted)
     */
     bool runPODEM();
 
+    /*
+    * Function to set all node values back to X and remove the fault
+    * so that the circuit can be reused for the next target fault
+    */
+    void reset_values();
+
+    /*
+    * Function to get the input vector generated by PODEM
+    * @return string -> value per primary input (1, 0 or X), D and DBar resolved to the good value
+    */
+    std::string get_input_vector_lin();
+
     /*
     * Function to print all node values
     */
@@ -5,19 +5,35 @@ Description:
     Inputs:
         1. Circuit netlist supporting logic gates
         2. Stuck at fault details (node name and stuck at value)
+        3. Or a netlist (or the directory of known netlists) to generate tests for all faults
     Outputs:
         1. Test vector to detect the input fault
+        2. For all faults: the test vector of each fault PODEM is run on, with the faults it
+           detects dropped by fault simulation, and the fault coverage summary
+        3. Faults on which PODEM reaches the backtrack or time limit are reported as aborted
+        4. With compaction, each test vector also targets the faults its test cube can still detect
+        5. Tests are generated with PODEM, or with FAN when selected
+        6. Faults PODEM or FAN aborts are retried with the SAT back end, which proves redundancy too
 */
 
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <cstring>
+#include <set>
 
 #include "Node.h"
 #include "Gate.h"
 #include "Circuit.h"
 #include "HelperFuncs.h"
+#include "FaultCollapser.h"
+#include "TestGenerator.h"
+
+// Backtracks per fault before PODEM aborts it, unless set with -b
+const int defaultBacktrackLimit = 10000;
+
+// Conflicts per fault before the SAT back end aborts it, unless set with -s
+const int defaultSatConflictLimit = 100000;
 
 /*
 * Function to check if command line option provided
@@ -52,88 +68,96 @@ int checkCommandLineOption(int argc, char** argv, const char inputToCheck[])
     return -1;
 }
 
+/*
+* Function to generate test vectors for all faults of a netlist
+* The netlist is read once and faults detected by earlier test vectors are not targeted
+* @param netlistPath -> location of the netlist
+* @param collapseMode -> fault collapsing (empty => none, eq or dom)
+* @param limits -> effort limits of PODEM per fault
+* @param compactTests -> extend every test cube with secondary target faults
+* @param useFan -> generate tests with FAN instead of PODEM
+* @param useSat -> retry the aborted faults with the SAT back end
+* @return bool -> if the netlist was read
+*/
+bool generate_all_tests(std::string netlistPath, std::string collapseMode, const PodemLimits& limits,
+    bool compactTests, bool useFan, bool useSat)
+{
+    Circuit testCkt;
+    if (testCkt.read_netlist(netlistPath) == false)
+    {
+        // unable to read netlist
+        return false;
+    }
+    testCkt.podemLimits = limits;
+
+    // Collapse the fault list to decide which faults are targeted
+    FaultCollapser collapser(testCkt, collapseMode.compare("dom") == 0);
+    std::vector<std::pair<int, int>> targetFaults = collapser.faultList;
+    if (collapseMode.empty() == false)
+    {
+        targetFaults = collapser.get_representative_faults();
+    }
+
+    // Run PODEM on the faults left undetected by the test vectors so far
+    TestGenerator generator(&testCkt, targetFaults);
+    generator.compactTests = compactTests;
+    generator.useFan = useFan;
+    generator.useSat = useSat;
+    generator.run(true);
+
+    // Report coverage over the complete fault list
+    std::set<std::pair<int, int>> detectedFaults;
+    for (unsigned int i = 0; i < targetFaults.size(); ++i)
+    {
+        if (generator.faultStates[i] == Detected)
+        {
+            detectedFaults.insert(targetFaults[i]);
+        }
+    }
+    int totalDetected = collapser.expand_detected_faults(detectedFaults).size();
+    std::cout << "Total faults: " << collapser.faultList.size() << "\n";
+    std::cout << "Faults targeted: " << targetFaults.size() << "\n";
+    std::string engineName = useFan ? "FAN" : "PODEM";
+    std::cout << engineName << " runs: " << generator.numPodemCalls << "\n";
+    if (compactTests)
+    {
+        std::cout << "Compaction " << engineName << " runs: " << generator.numCompactionCalls << "\n";
+    }
+    std::cout << "Test vectors: " << generator.testVectors.size() << "\n";
+    std::cout << engineName << " backtracks: " << generator.numBacktracks << "\n";
+    if (useSat)
+    {
+        std::cout << "SAT runs: " << generator.numSatCalls << "\n";
+        std::cout << "SAT conflicts: " << generator.numSatConflicts << "\n";
+    }
+    std::cout << "Redundant faults: " << generator.get_num_faults(Redundant) << "\n";
+    std::cout << "Aborted faults: " << generator.get_num_faults(Aborted) << "\n";
+    std::cout << "Faults detected: " << totalDetected << "\n";
+    std::cout << "Fault coverage: " << totalDetected * 100.0 / collapser.faultList.size() << "%\n\n";
+    return true;
+}
+
 /*
 * Function to generate test vectors for all the known netlist files
+* @param parentPath -> directory with the known netlists
+* @param collapseMode -> fault collapsing (empty => none, eq or dom)
+* @param limits -> effort limits of PODEM per fault
+* @param compactTests -> extend every test cube with secondary target faults
+* @param useFan -> generate tests with FAN instead of PODEM
+* @param useSat -> retry the aborted faults with the SAT back end
 */
-void simulateAll(std::string parentPath)
+void simulateAll(std::string parentPath, std::string collapseMode, const PodemLimits& limits, bool compactTests,
+    bool useFan, bool useSat)
 {
-     std::string netlistName[] = { "/s27.txt", "/s298f_2.txt", "/s344f_2.txt", "/s349f_2.txt" };
+    std::string netlistName[] = { "/s27.txt", "/s298f_2.txt", "/s344f_2.txt", "/s349f_2.txt" };
 
     for (auto netlist : netlistName)
     {
         std::string netlistPath = parentPath + netlist;
         std::cout << "Simulating Circuit: " << netlistPath << "\n";
-        std::vector<int> simulatedSoFar;
-
-        bool switchFault = false;
-
-        while (1)
+        if (generate_all_tests(netlistPath, collapseMode, limits, compactTests, useFan, useSat) == false)
         {
-            // Create the circuit data structure
-            Circuit testCkt;
-            // Read the netlist and init the circuit DS values
-            if (testCkt.read_netlist(netlistPath) == false)
-            {
-                // unable to read netlist
-                return;
-            }
-            // Track which faults have already been simulated
-            if (simulatedSoFar.size() == testCkt.node_list.size())
-            {
-                if (switchFault == false)
-                {
-                    switchFault = true;
-                    simulatedSoFar.clear();
-                }
-                else
-                {
-                    break;
-                }
-            }
-            testCkt.node_list.sort();
-
-            // Simulate the PODEM algo to generate the test vector
-            for (auto m : testCkt.node_list)
-            {
-                if (std::find(simulatedSoFar.begin(),
-                    simulatedSoFar.end(), m) == simulatedSoFar.end())
-                {
-                    // Assign the fault node name
-                    testCkt.faultNodeName = m;
-                    // Assign the fault stuck at value to the node
-                    if (switchFault == false)
-                    {
-                        testCkt.node_map[testCkt.faultNodeName]->is_stuck_at_0 = true;
-                    }
-                    else
-                    {
-                        testCkt.node_map[testCkt.faultNodeName]->is_stuck_at_1 = true;
-                    }
-                    // Run PODEM algo
-                    bool podemSuccessful = testCkt.runPODEM();
-                    std::cout << "Node name: " << m << ", Stuck at value: ";
-                    if (testCkt.node_map[testCkt.faultNodeName]->is_stuck_at_0)
-                    {
-                        std::cout << "0 ";
-                    }
-                    else
-                    {
-                        std::cout << "1 ";
-                    }
-                    std::cout << "Test Vector: ";
-                    if (podemSuccessful == false)
-                    {
-                        std::cout << "No test vector generated. Fault is undetectable\n";
-                    }
-                    else
-                    {
-                        // Print the test vector generated
-                        testCkt.print_input_vector_node();
-                    }
-                    simulatedSoFar.push_back(m);
-                    break;
-                }
-            }
+            return;
         }
     }
 }
@@ -156,9 +180,17 @@ void printUsage()
     std::cerr << "\t-d <netlist_dir_path> ->Path to directory with known netlists(s27.txt, s298f_2.txt, s344f_2.txt, s349f_2.txt)\n";
     std::cerr << "\t-n <fault_node_name>  ->Node name with fault\n";
     std::cerr << "\t-v <stuck_at_value>   ->Stuck at value for fault\n";
+    std::cerr << "\t-c <eq|dom>           ->Target only representatives of equivalent (eq) or also dominant (dom) faults (with -d, or -f without -n)\n";
+    std::cerr << "\t-e <podem|fan>        ->Test generation engine (default podem)\n";
+    std::cerr << "\t-b <backtracks>       ->Backtracks per fault before PODEM aborts it (default " << defaultBacktrackLimit << ", 0 => no limit)\n";
+    std::cerr << "\t-t <seconds>          ->Time per fault before PODEM aborts it (default no limit)\n";
+    std::cerr << "\t-s <conflicts>        ->Conflicts per aborted fault before the SAT back end aborts it (default " << defaultSatConflictLimit << ", 0 => no limit)\n";
+    std::cerr << "\t-S                    ->No SAT back end, aborted faults stay aborted\n";
+    std::cerr << "\t-m                    ->Compact tests, each test cube also targets the faults it can still detect (with -d, or -f without -n)\n";
     std::cerr << "Example Usage:\n";
     std::cerr << "\t To generate tests for all faults in netlist directory: <exe> -d <netlist_dir_path>\n";
     std::cerr << "\t To generate test vector for SSF in netlist file: <exe> -f <netlist_path> -n <fault_node_name> -v <stuck_at_value>\n";
+    std::cerr << "\t To generate tests for all faults in netlist file: <exe> -f <netlist_path>\n";
 }
 
 
@@ -188,12 +220,85 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    // Fault collapsing for the runs over all faults
+    std::string collapseMode = "";
+    int collapseIndex = checkCommandLineOption(argc, argv, "-c") + 1;
+    if (collapseIndex != 0 && collapseIndex < argc)
+    {
+        collapseMode = argv[collapseIndex];
+        if (collapseMode.compare("eq") != 0 && collapseMode.compare("dom") != 0)
+        {
+            printCmdError();
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Effort limits of PODEM per fault
+    PodemLimits limits;
+    limits.maxBacktracks = defaultBacktrackLimit;
+    int limitIndex = checkCommandLineOption(argc, argv, "-b") + 1;
+    if (limitIndex != 0)
+    {
+        if (limitIndex >= argc || std::stoi(argv[limitIndex]) < 0)
+        {
+            printCmdError();
+            printUsage();
+            return 1;
+        }
+        limits.maxBacktracks = std::stoi(argv[limitIndex]);
+    }
+    limitIndex = checkCommandLineOption(argc, argv, "-t") + 1;
+    if (limitIndex != 0)
+    {
+        if (limitIndex >= argc || std::stod(argv[limitIndex]) < 0)
+        {
+            printCmdError();
+            printUsage();
+            return 1;
+        }
+        limits.maxSeconds = std::stod(argv[limitIndex]);
+    }
+    limits.maxSatConflicts = defaultSatConflictLimit;
+    limitIndex = checkCommandLineOption(argc, argv, "-s") + 1;
+    if (limitIndex != 0)
+    {
+        if (limitIndex >= argc || std::stoi(argv[limitIndex]) < 0)
+        {
+            printCmdError();
+            printUsage();
+            return 1;
+        }
+        limits.maxSatConflicts = std::stoi(argv[limitIndex]);
+    }
+
+    // SAT back end for the aborted faults
+    bool useSat = (checkCommandLineOption(argc, argv, "-S") == -1);
+
+    // Dynamic compaction for the runs over all faults
+    bool compactTests = (checkCommandLineOption(argc, argv, "-m") != -1);
+
+    // Test generation engine
+    bool useFan = false;
+    int engineIndex = checkCommandLineOption(argc, argv, "-e") + 1;
+    if (engineIndex != 0)
+    {
+        std::string engineName = (engineIndex < argc) ? argv[engineIndex] : "";
+        if (engineName.compare("fan") != 0 && engineName.compare("podem") != 0)
+        {
+            printCmdError();
+            printUsage();
+            return 1;
+        }
+        useFan = (engineName.compare("fan") == 0);
+    }
+
     // Check if netlist directory run initiated
     int index = checkCommandLineOption(argc, argv, "-d") + 1;
     if (index != 0)
     {
         std::string netlistDir = argv[index];
-        simulateAll(netlistDir);
+        simulateAll(netlistDir, collapseMode, limits, compactTests, useFan, useSat);
         return 1;
     }
 
@@ -215,6 +320,25 @@ int main(int argc, char* argv[])
         sfaultValue = argv[index];
     }
 
+    // Without a fault, generate tests for all faults of the netlist
+    if (nodeName.empty() && sfaultValue.empty())
+    {
+        if (netlistPath.empty() || generate_all_tests(netlistPath, collapseMode, limits, compactTests, useFan, useSat) == false)
+        {
+            printCmdError();
+            printUsage();
+            return 1;
+        }
+        return 0;
+    }
+    if (collapseMode.empty() == false || compactTests)
+    {
+        // a single fault is not collapsed or compacted
+        printCmdError();
+        printUsage();
+        return 1;
+    }
+
     // Init the circuit DS
     Circuit testCkt;
     // Read netlist and create complete circuit DS
@@ -245,8 +369,34 @@ int main(int argc, char* argv[])
     }
     
     // Run PODEM algo
-    bool podemSuccessful = testCkt.runPODEM();
-    if (podemSuccessful == false)
+    testCkt.podemLimits = limits;
+    bool podemSuccessful = false;
+    if (useFan)
+    {
+        FanEngine fanEngine(&testCkt);
+        podemSuccessful = fanEngine.run();
+    }
+    else
+    {
+        podemSuccessful = testCkt.runPODEM();
+    }
+    long long numSatConflicts = 0;
+    if (podemSuccessful == false && testCkt.podemAborted && useSat)
+    {
+        SatAtpg satAtpg(&testCkt);
+        podemSuccessful = satAtpg.run();
+        numSatConflicts = satAtpg.numConflicts;
+    }
+    if (podemSuccessful == false && testCkt.podemAborted)
+    {
+        std::cout << "No test vector generated. Fault aborted after " << testCkt.numBacktracks << " backtracks";
+        if (useSat)
+        {
+            std::cout << " and " << numSatConflicts << " SAT conflicts";
+        }
+        std::cout << "\n";
+    }
+    else if (podemSuccessful == false)
     {
         std::cout << "No test vector generated. Fault is undetectable\n";
     }
@@ -0,0 +1,605 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include "FanEngine.h"
+
+/*
+* Function to get the non-controlling value of a gate
+* @param gate -> gate to check
+* @return logicValue -> non-controlling value, Zero for gates without controlling value
+*/
+static logicValue get_non_controlling_value(Gate* gate)
+{
+    gateLogic logic = gate->get_gate_logic();
+    if (logic == and_l || logic == nand_l)
+    {
+        return One;
+    }
+    return Zero;
+}
+
+/*
+* Function to check if a gate inverts its output
+* @param gate -> gate to check
+* @return bool -> if the gate is NAND, NOR, NOT or XNOR
+*/
+static bool is_inverting(Gate* gate)
+{
+    gateLogic logic = gate->get_gate_logic();
+    if (logic == xnor_l)
+    {
+        return true;
+    }
+    return logic != xor_l && gate->get_inversion_parity() == One;
+}
+
+/*
+* Constructor for the class
+* @param inCkt -> circuit read from netlist (levelized)
+*/
+FanEngine::FanEngine(Circuit* inCkt) : ckt(inCkt), currentConeStamp(0)
+{
+    // Inputs first, then the gate outputs in topological order
+    for (int nodeName : this->ckt->inputNodes)
+    {
+        Node* inputNode = this->ckt->node_map[nodeName];
+        this->nodeIndex[inputNode] = this->nodes.size();
+        this->nodes.push_back(inputNode);
+    }
+    int maxLevel = 0;
+    for (Gate* gate : this->ckt->levelizedGates)
+    {
+        this->nodeIndex[gate->output] = this->nodes.size();
+        this->nodes.push_back(gate->output);
+        maxLevel = std::max(maxLevel, gate->level);
+    }
+    this->requests0.assign(this->nodes.size(), 0);
+    this->requests1.assign(this->nodes.size(), 0);
+    this->coneStamps.assign(this->nodes.size(), 0);
+    this->isEnabledHeadline.assign(this->nodes.size(), false);
+    this->backtraceQueue.assign(maxLevel + 1, std::vector<int>());
+    this->find_headlines();
+    this->find_dominators();
+}
+
+/*
+* Function to find the headlines and the region of every free node
+* A node is free if no fanout stem is in its input cone, a headline
+* is a free node that is a stem, an output or feeds a bound gate
+*/
+void FanEngine::find_headlines()
+{
+    std::vector<bool> isFree(this->nodes.size(), true);
+    std::vector<int> numFanouts(this->nodes.size(), 0);
+    for (unsigned int i = 0; i < this->nodes.size(); ++i)
+    {
+        auto fanoutItr = this->ckt->node_to_gate_map.find(this->nodes[i]->name);
+        if (fanoutItr != this->ckt->node_to_gate_map.end())
+        {
+            numFanouts[i] = fanoutItr->second.size();
+        }
+    }
+    for (unsigned int i = this->ckt->inputNodes.size(); i < this->nodes.size(); ++i)
+    {
+        // gate inputs are ordered before the gate output
+        Gate* gate = this->ckt->levelizedGates[i - this->ckt->inputNodes.size()];
+        int input1 = this->nodeIndex[gate->input1];
+        isFree[i] = isFree[input1] && numFanouts[input1] == 1;
+        if (gate->is_single_input() == false)
+        {
+            int input2 = this->nodeIndex[gate->input2];
+            isFree[i] = isFree[i] && isFree[input2] && numFanouts[input2] == 1;
+        }
+    }
+
+    this->isHeadline.assign(this->nodes.size(), false);
+    this->headlineOf.assign(this->nodes.size(), -1);
+    this->regionInputs.assign(this->nodes.size(), std::vector<int>());
+    for (unsigned int i = 0; i < this->nodes.size(); ++i)
+    {
+        if (isFree[i] == false)
+        {
+            continue;
+        }
+        if (numFanouts[i] == 1)
+        {
+            Node* fanoutOutput = this->ckt->node_to_gate_map[this->nodes[i]->name].front()->output;
+            if (isFree[this->nodeIndex[fanoutOutput]])
+            {
+                // inside the region of a later headline
+                continue;
+            }
+        }
+        this->isHeadline[i] = true;
+
+        // Walk the region backwards, its nodes are free with a single fanout
+        std::vector<int> regionNodes(1, i);
+        while (regionNodes.empty() == false)
+        {
+            int regionNode = regionNodes.back();
+            regionNodes.pop_back();
+            this->headlineOf[regionNode] = i;
+            auto driverItr = this->ckt->outputnode_to_gate_map.find(this->nodes[regionNode]->name);
+            if (driverItr == this->ckt->outputnode_to_gate_map.end())
+            {
+                this->regionInputs[i].push_back(regionNode);
+                continue;
+            }
+            Gate* gate = driverItr->second.front();
+            regionNodes.push_back(this->nodeIndex[gate->input1]);
+            if (gate->is_single_input() == false)
+            {
+                regionNodes.push_back(this->nodeIndex[gate->input2]);
+            }
+        }
+    }
+}
+
+/*
+* Function to find the immediate dominator of every node towards the outputs
+*/
+void FanEngine::find_dominators()
+{
+    // Outputs are joined in a sink, a dominator is nearer to the sink in reverse topological order
+    int sinkIndex = this->nodes.size();
+    std::vector<int> dominators(this->nodes.size() + 1, -1);
+    std::vector<int> order(this->nodes.size() + 1, 0);
+    dominators[sinkIndex] = sinkIndex;
+    for (int i = this->nodes.size() - 1; i >= 0; --i)
+    {
+        order[i] = this->nodes.size() - i;
+        std::vector<int> successors;
+        if (this->nodes[i]->isPrimaryOutput)
+        {
+            successors.push_back(sinkIndex);
+        }
+        for (Gate* gate : this->ckt->node_to_gate_map[this->nodes[i]->name])
+        {
+            successors.push_back(this->nodeIndex[gate->output]);
+        }
+        int dominator = -1;
+        for (int successor : successors)
+        {
+            if (dominators[successor] == -1)
+            {
+                // successor cannot reach an output
+                continue;
+            }
+            if (dominator == -1)
+            {
+                dominator = successor;
+                continue;
+            }
+            int finger1 = dominator;
+            int finger2 = successor;
+            while (finger1 != finger2)
+            {
+                while (order[finger1] > order[finger2])
+                {
+                    finger1 = dominators[finger1];
+                }
+                while (order[finger2] > order[finger1])
+                {
+                    finger2 = dominators[finger2];
+                }
+            }
+            dominator = finger1;
+        }
+        dominators[i] = dominator;
+    }
+
+    this->immediateDominator.assign(this->nodes.size(), -1);
+    for (unsigned int i = 0; i < this->nodes.size(); ++i)
+    {
+        if (dominators[i] != sinkIndex)
+        {
+            this->immediateDominator[i] = dominators[i];
+        }
+    }
+}
+
+/*
+* Function to enable the headlines whose region is unassigned and fault free
+*/
+void FanEngine::enable_headlines()
+{
+    int faultHeadline = -1;
+    auto faultItr = this->nodeIndex.find(this->ckt->node_map[this->ckt->faultNodeName]);
+    if (faultItr != this->nodeIndex.end())
+    {
+        faultHeadline = this->headlineOf[faultItr->second];
+    }
+    for (unsigned int i = 0; i < this->nodes.size(); ++i)
+    {
+        this->isEnabledHeadline[i] = this->isHeadline[i] && (int)i != faultHeadline && this->nodes[i]->value == X;
+        for (int inputIndex : this->regionInputs[i])
+        {
+            if (this->isEnabledHeadline[i] && this->nodes[inputIndex]->value != X)
+            {
+                // region partly assigned before the run
+                this->isEnabledHeadline[i] = false;
+            }
+        }
+    }
+}
+
+/*
+* Function to add the requests of an objective to a node
+* @param index -> index of the node
+* @param numRequests0 -> requests for 0
+* @param numRequests1 -> requests for 1
+*/
+void FanEngine::add_requests(int index, int numRequests0, int numRequests1)
+{
+    if (this->requests0[index] == 0 && this->requests1[index] == 0)
+    {
+        this->backtraceQueue[this->nodes[index]->level].push_back(index);
+        this->requestedNodes.push_back(index);
+    }
+    this->requests0[index] += numRequests0;
+    this->requests1[index] += numRequests1;
+}
+
+/*
+* Function to pass the requests on the output of a gate to its X inputs
+* @param gate -> gate driving the requested node
+* @param numRequests0 -> requests for 0 on the output
+* @param numRequests1 -> requests for 1 on the output
+*/
+void FanEngine::backtrace_gate(Gate* gate, int numRequests0, int numRequests1)
+{
+    // Requests on the gate before its output inversion
+    if (is_inverting(gate))
+    {
+        std::swap(numRequests0, numRequests1);
+    }
+    int input1 = this->nodeIndex[gate->input1];
+    if (gate->is_single_input())
+    {
+        this->add_requests(input1, numRequests0, numRequests1);
+        return;
+    }
+    int input2 = this->nodeIndex[gate->input2];
+    bool isInput1X = (gate->input1->value == X);
+    bool isInput2X = (gate->input2->value == X);
+
+    gateLogic logic = gate->get_gate_logic();
+    if (logic == xor_l || logic == xnor_l)
+    {
+        // the X input takes the output value, inverted by a known 1 on the other input
+        int xInput = isInput1X ? input1 : input2;
+        Node* otherInput = isInput1X ? gate->input2 : gate->input1;
+        if (otherInput->value == One || otherInput->value == DBar)
+        {
+            std::swap(numRequests0, numRequests1);
+        }
+        this->add_requests(xInput, numRequests0, numRequests1);
+        return;
+    }
+
+    // Controlling value on the easiest input, non-controlling value on all inputs
+    logicValue controlling = gate->get_controlling_value();
+    int numControlling = (controlling == Zero) ? numRequests0 : numRequests1;
+    int numNonControlling = (controlling == Zero) ? numRequests1 : numRequests0;
+    int easiestInput = input1;
+    if (isInput1X == false || (isInput2X && this->ckt->get_controllability(gate->input2, controlling) <
+        this->ckt->get_controllability(gate->input1, controlling)))
+    {
+        easiestInput = input2;
+    }
+    if (numControlling > 0)
+    {
+        this->add_requests(easiestInput, (controlling == Zero) ? numControlling : 0,
+            (controlling == One) ? numControlling : 0);
+    }
+    if (numNonControlling > 0)
+    {
+        int nonControlling0 = (controlling == One) ? numNonControlling : 0;
+        int nonControlling1 = (controlling == Zero) ? numNonControlling : 0;
+        if (isInput1X)
+        {
+            this->add_requests(input1, nonControlling0, nonControlling1);
+        }
+        if (isInput2X && input2 != input1)
+        {
+            this->add_requests(input2, nonControlling0, nonControlling1);
+        }
+    }
+}
+
+/*
+* Function to clear the requests of the last multiple backtrace
+*/
+void FanEngine::clear_requests()
+{
+    for (int index : this->requestedNodes)
+    {
+        this->requests0[index] = 0;
+        this->requests1[index] = 0;
+    }
+    this->requestedNodes.clear();
+    for (std::vector<int>& bucket : this->backtraceQueue)
+    {
+        bucket.clear();
+    }
+}
+
+/*
+* Function to backtrace a set of objectives to a headline or primary input together
+* @param initialObjectives -> pair of node index and value to achieve
+* @return pair of node name and value to decide on, node -1 if none found
+*/
+std::pair<int, logicValue> FanEngine::multiple_backtrace(const std::vector<std::pair<int, logicValue>>& initialObjectives)
+{
+    this->clear_requests();
+    for (const std::pair<int, logicValue>& objective : initialObjectives)
+    {
+        this->add_requests(objective.first, objective.second == Zero, objective.second == One);
+    }
+
+    // Highest level first => a stem has the requests of all its branches when visited
+    int headObjective = -1;
+    for (int level = this->backtraceQueue.size() - 1; level >= 0; --level)
+    {
+        for (unsigned int i = 0; i < this->backtraceQueue[level].size(); ++i)
+        {
+            int index = this->backtraceQueue[level][i];
+            int numRequests0 = this->requests0[index];
+            int numRequests1 = this->requests1[index];
+            auto driverItr = this->ckt->outputnode_to_gate_map.find(this->nodes[index]->name);
+            if (driverItr == this->ckt->outputnode_to_gate_map.end() || this->isEnabledHeadline[index])
+            {
+                // head objective, the most requested one is decided on
+                if (headObjective == -1 || std::max(numRequests0, numRequests1) >
+                    std::max(this->requests0[headObjective], this->requests1[headObjective]))
+                {
+                    headObjective = index;
+                }
+                continue;
+            }
+            if (numRequests0 > 0 && numRequests1 > 0 &&
+                this->ckt->node_to_gate_map[this->nodes[index]->name].size() > 1)
+            {
+                // stem requested both ways => its majority value is the only objective
+                logicValue stemValue = (numRequests1 > numRequests0) ? One : Zero;
+                return this->multiple_backtrace(std::vector<std::pair<int, logicValue>>(1,
+                    std::make_pair(index, stemValue)));
+            }
+            this->backtrace_gate(driverItr->second.front(), numRequests0, numRequests1);
+        }
+    }
+    if (headObjective == -1)
+    {
+        return std::make_pair(-1, X);
+    }
+    logicValue headValue = (this->requests1[headObjective] > this->requests0[headObjective]) ? One : Zero;
+    return std::make_pair(this->nodes[headObjective]->name, headValue);
+}
+
+/*
+* Function to add the side input objectives of the nearest dominator of the unique D-frontier gate
+* @param dfrontierOutput -> output of the D-frontier gate
+*/
+void FanEngine::add_unique_sensitization_objectives(Node* dfrontierOutput)
+{
+    // Side inputs reached by the fault effect may carry it as well, they are left alone
+    ++this->currentConeStamp;
+    std::vector<Node*> coneNodes(1, dfrontierOutput);
+    this->coneStamps[this->nodeIndex[dfrontierOutput]] = this->currentConeStamp;
+    while (coneNodes.empty() == false)
+    {
+        Node* coneNode = coneNodes.back();
+        coneNodes.pop_back();
+        for (Gate* gate : this->ckt->node_to_gate_map[coneNode->name])
+        {
+            int outputIndex = this->nodeIndex[gate->output];
+            if (this->coneStamps[outputIndex] != this->currentConeStamp)
+            {
+                this->coneStamps[outputIndex] = this->currentConeStamp;
+                coneNodes.push_back(gate->output);
+            }
+        }
+    }
+
+    // Only the nearest dominator that needs side values is sensitized, objectives for
+    // the whole dominator chain at once overconstrain the backtrace
+    for (int dominator = this->immediateDominator[this->nodeIndex[dfrontierOutput]]; dominator != -1;
+        dominator = this->immediateDominator[dominator])
+    {
+        Gate* gate = this->ckt->outputnode_to_gate_map[this->nodes[dominator]->name].front();
+        gateLogic logic = gate->get_gate_logic();
+        if (gate->is_single_input() || logic == xor_l || logic == xnor_l)
+        {
+            // any side value propagates the fault effect
+            continue;
+        }
+        for (Node* sideInput : { gate->input1, gate->input2 })
+        {
+            int sideIndex = this->nodeIndex[sideInput];
+            if (sideInput->value == X && this->coneStamps[sideIndex] != this->currentConeStamp)
+            {
+                this->objectives.push_back(std::make_pair(sideIndex, get_non_controlling_value(gate)));
+            }
+        }
+        return;
+    }
+}
+
+/*
+* Function to collect the objectives of the next decision
+*/
+void FanEngine::collect_objectives()
+{
+    this->objectives.clear();
+    Node* faultNode = this->ckt->node_map[this->ckt->faultNodeName];
+    if (faultNode->value == X)
+    {
+        // activate the fault
+        this->objectives.push_back(std::make_pair(this->nodeIndex[faultNode], faultNode->is_stuck_at_1 ? Zero : One));
+        return;
+    }
+
+    // Propagate through the most observable D-frontier gate with an X-path (lowest name on ties)
+    int bestNodeName = -1;
+    int numOpenGates = 0;
+    for (int nodeName : this->ckt->dfrontier)
+    {
+        Node* dfrontierOutput = this->ckt->node_map[nodeName];
+        if (dfrontierOutput->hasXPath == false)
+        {
+            continue;
+        }
+        ++numOpenGates;
+        if (bestNodeName == -1 || dfrontierOutput->co < this->ckt->node_map[bestNodeName]->co ||
+            (dfrontierOutput->co == this->ckt->node_map[bestNodeName]->co && nodeName < bestNodeName))
+        {
+            bestNodeName = nodeName;
+        }
+    }
+    if (bestNodeName == -1)
+    {
+        return;
+    }
+    Node* bestOutput = this->ckt->node_map[bestNodeName];
+    Gate* dfrontierGate = this->ckt->outputnode_to_gate_map[bestNodeName].front();
+    logicValue nonControlling = get_non_controlling_value(dfrontierGate);
+    for (Node* gateInput : { dfrontierGate->input1, dfrontierGate->input2 })
+    {
+        if (gateInput != NULL && gateInput->value == X)
+        {
+            this->objectives.push_back(std::make_pair(this->nodeIndex[gateInput], nonControlling));
+        }
+    }
+    if (numOpenGates == 1)
+    {
+        this->add_unique_sensitization_objectives(bestOutput);
+    }
+}
+
+/*
+* Function to justify a value on a node of a fanout-free region from the region inputs
+* @param inNode -> node to justify
+* @param inValue -> value to justify (Zero or One)
+* @return bool -> if the value was justified
+*/
+bool FanEngine::justify_node(Node* inNode, logicValue inValue)
+{
+    if (inNode->value != X)
+    {
+        return inNode->value == inValue;
+    }
+    auto driverItr = this->ckt->outputnode_to_gate_map.find(inNode->name);
+    if (driverItr == this->ckt->outputnode_to_gate_map.end())
+    {
+        // region input
+        return this->ckt->implyPODEM(inNode->name, inValue) && inNode->value == inValue;
+    }
+    return this->justify_gate(driverItr->second.front(), inValue);
+}
+
+/*
+* Function to justify the output value of a gate of a fanout-free region
+* @param gate -> gate to justify
+* @param outputValue -> value of its output
+* @return bool -> if the value was justified
+*/
+bool FanEngine::justify_gate(Gate* gate, logicValue outputValue)
+{
+    logicValue gateValue = is_inverting(gate) ? get_not_value(outputValue) : outputValue;
+    if (gate->is_single_input())
+    {
+        return this->justify_node(gate->input1, gateValue);
+    }
+    gateLogic logic = gate->get_gate_logic();
+    if (logic == xor_l || logic == xnor_l)
+    {
+        // input1 to 0 unless already known, input2 completes the parity
+        logicValue input1Value = (gate->input1->value == X) ? Zero : gate->input1->value;
+        if (this->justify_node(gate->input1, input1Value) == false)
+        {
+            return false;
+        }
+        return this->justify_node(gate->input2, (input1Value == gateValue) ? Zero : One);
+    }
+    logicValue controlling = gate->get_controlling_value();
+    if (gateValue == controlling)
+    {
+        // one controlling input is enough, the easiest one
+        Node* easiestInput = gate->input1;
+        if (this->ckt->get_controllability(gate->input2, controlling) <
+            this->ckt->get_controllability(gate->input1, controlling))
+        {
+            easiestInput = gate->input2;
+        }
+        return this->justify_node(easiestInput, controlling);
+    }
+    return this->justify_node(gate->input1, gateValue) && this->justify_node(gate->input2, gateValue);
+}
+
+/*
+* Function to run FAN for the fault of the circuit
+* @return bool -> if a test was found, else the fault is redundant or aborted (ckt->podemAborted)
+*/
+bool FanEngine::run()
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    this->ckt->decisionStack.clear();
+    this->ckt->trail.clear();
+    this->ckt->numBacktracks = 0;
+    this->ckt->podemAborted = false;
+    this->enable_headlines();
+
+    while (true)
+    {
+        if (this->ckt->is_fault_detected())
+        {
+            // Assigned headlines are justified from the inputs of their regions
+            std::vector<PodemDecision> decisions = this->ckt->decisionStack;
+            for (const PodemDecision& decision : decisions)
+            {
+                Node* decisionNode = this->ckt->node_map[decision.nodeName];
+                auto driverItr = this->ckt->outputnode_to_gate_map.find(decision.nodeName);
+                if (driverItr != this->ckt->outputnode_to_gate_map.end() &&
+                    this->justify_gate(driverItr->second.front(), decisionNode->value) == false)
+                {
+                    std::cerr << "Dev Error: Unable to justify headline " << decision.nodeName << "\n";
+                }
+            }
+            return true;
+        }
+
+        // A search without conflicts never backtracks, the time limit is checked on every decision
+        if (this->ckt->is_time_limit_reached(startTime))
+        {
+            this->ckt->podemAborted = true;
+            this->ckt->undo_trail(0);
+            this->ckt->decisionStack.clear();
+            return false;
+        }
+
+        bool isConflict = this->ckt->is_fault_activation_blocked() || this->ckt->has_xpath_to_output() == false;
+        std::pair<int, logicValue> decision(-1, X);
+        if (isConflict == false)
+        {
+            this->collect_objectives();
+            decision = this->multiple_backtrace(this->objectives);
+            isConflict = (decision.first == -1);
+        }
+        if (isConflict == false)
+        {
+            if (this->ckt->printDecisions)
+            {
+                std::cout << "Decision is, Node " << decision.first << " value " << print_logic_value(decision.second) << "\n\n";
+            }
+            isConflict = (this->ckt->push_decision(decision.first, decision.second) == false);
+        }
+
+        // On failure try the other value of the latest open decision
+        if (isConflict && this->ckt->backtrack(startTime) == false)
+        {
+            this->ckt->undo_trail(0);
+            this->ckt->decisionStack.clear();
+            return false;
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#ifndef __FANENGINE_H__
+#define __FANENGINE_H__
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+#include "Circuit.h"
+
+/*
+* Class for the FAN test generation algorithm
+* FAN shares the implication, D-frontier, X-path check, decision stack and
+* effort limits of the circuit with PODEM, it differs in the decisions:
+* 1. Headlines, the roots of the fanout-free regions, can always be justified
+*    from their region inputs, so backtrace stops at headlines and decides on
+*    them. The regions of the assigned headlines are justified once a test is found.
+* 2. Multiple backtrace moves all objectives towards the inputs together in level
+*    order, counting the requests for 0 and 1 per node. A fanout stem requested
+*    both ways becomes the only objective of a new backtrace.
+* 3. Unique sensitization: with a single D-frontier gate, the side inputs of the
+*    nearest gate dominating it (on every path to the outputs) get non-controlling objectives.
+*/
+class FanEngine
+{
+public:
+    // Circuit to generate tests on
+    Circuit* ckt;
+
+    // Node to node index
+    std::unordered_map<Node*, int> nodeIndex;
+
+    // Nodes by index, inputs before the gate outputs in topological order
+    std::vector<Node*> nodes;
+
+    // Node is the root of a fanout-free region
+    std::vector<bool> isHeadline;
+
+    // Headline of the region of a free node (-1 for bound nodes)
+    std::vector<int> headlineOf;
+
+    // Primary inputs of the region per headline
+    std::vector<std::vector<int>> regionInputs;
+
+    // Headline can be decided on in the current run
+    std::vector<bool> isEnabledHeadline;
+
+    // Immediate dominator of a node towards the outputs (-1 for none)
+    std::vector<int> immediateDominator;
+
+    // Requests for 0 and 1 per node in the multiple backtrace
+    std::vector<int> requests0;
+    std::vector<int> requests1;
+
+    // Nodes with requests, bucketed by level
+    std::vector<std::vector<int>> backtraceQueue;
+
+    // Nodes given requests by the current multiple backtrace
+    std::vector<int> requestedNodes;
+
+    // Stamp per node of the last fanout cone walk reaching it
+    std::vector<int> coneStamps;
+    int currentConeStamp;
+
+    // Objectives of the next decision, pair of node index and value
+    std::vector<std::pair<int, logicValue>> objectives;
+
+    /*
+    * Constructor for the class
+    * @param inCkt -> circuit read from netlist (levelized)
+    */
+    FanEngine(Circuit* inCkt);
+
+    /*
+    * Function to find the headlines and the region of every free node
+    * A node is free if no fanout stem is in its input cone, a headline
+    * is a free node that is a stem, an output or feeds a bound gate
+    */
+    void find_headlines();
+
+    /*
+    * Function to find the immediate dominator of every node towards the outputs
+    */
+    void find_dominators();
+
+    /*
+    * Function to enable the headlines whose region is unassigned and fault free
+    */
+    void enable_headlines();
+
+    /*
+    * Function to add the requests of an objective to a node
+    * @param index -> index of the node
+    * @param numRequests0 -> requests for 0
+    * @param numRequests1 -> requests for 1
+    */
+    void add_requests(int index, int numRequests0, int numRequests1);
+
+    /*
+    * Function to pass the requests on the output of a gate to its X inputs
+    * @param gate -> gate driving the requested node
+    * @param numRequests0 -> requests for 0 on the output
+    * @param numRequests1 -> requests for 1 on the output
+    */
+    void backtrace_gate(Gate* gate, int numRequests0, int numRequests1);
+
+    /*
+    * Function to clear the requests of the last multiple backtrace
+    */
+    void clear_requests();
+
+    /*
+    * Function to backtrace a set of objectives to a headline or primary input together
+    * @param initialObjectives -> pair of node index and value to achieve
+    * @return pair of node name and value to decide on, node -1 if none found
+    */
+    std::pair<int, logicValue> multiple_backtrace(const std::vector<std::pair<int, logicValue>>& initialObjectives);
+
+    /*
+    * Function to add the side input objectives of the nearest dominator of the unique D-frontier gate
+    * @param dfrontierOutput -> output of the D-frontier gate
+    */
+    void add_unique_sensitization_objectives(Node* dfrontierOutput);
+
+    /*
+    * Function to collect the objectives of the next decision
+    */
+    void collect_objectives();
+
+    /*
+    * Function to justify a value on a node of a fanout-free region from the region inputs
+    * @param inNode -> node to justify
+    * @param inValue -> value to justify (Zero or One)
+    * @return bool -> if the value was justified
+    */
+    bool justify_node(Node* inNode, logicValue inValue);
+
+    /*
+    * Function to justify the output value of a gate of a fanout-free region
+    * @param gate -> gate to justify
+    * @param outputValue -> value of its output
+    * @return bool -> if the value was justified
+    */
+    bool justify_gate(Gate* gate, logicValue outputValue);
+
+    /*
+    * Function to run FAN for the fault of the circuit
+    * @return bool -> if a test was found, else the fault is redundant or aborted (ckt->podemAborted)
+    */
+    bool run();
+};
+
+#endif
@@ -0,0 +1,222 @@
+#include "FaultCollapser.h"
+
+/*
+* Constructor for the class
+* Builds the equivalence classes and, optionally, prunes dominating classes
+* @param ckt -> circuit read from netlist
+* @param useDominance -> also drop classes dominated by a gate input fault
+*/
+FaultCollapser::FaultCollapser(Circuit& ckt, bool useDominance)
+{
+    // Fault list in sorted node order, s-a-0 before s-a-1
+    std::list<int> sortedNodes = ckt.node_list;
+    sortedNodes.sort();
+    for (int nodeName : sortedNodes)
+    {
+        this->nodeFaultIndex[nodeName] = this->faultList.size();
+        this->faultList.push_back(std::make_pair(nodeName, 0));
+        this->faultList.push_back(std::make_pair(nodeName, 1));
+    }
+    int numFaults = this->faultList.size();
+    for (int i = 0; i < numFaults; ++i)
+    {
+        this->parentFault.push_back(i);
+    }
+
+    // Gate input faults can only be collapsed into the output of the single gate they feed
+    std::vector<std::pair<int, int>> dominanceEdges;
+    for (Gate* gate : ckt.gateList)
+    {
+        std::vector<Node*> inputs(1, gate->input1);
+        if (gate->is_single_input() == false)
+        {
+            if (gate->input2 == gate->input1)
+            {
+                continue;
+            }
+            inputs.push_back(gate->input2);
+        }
+        for (Node* input : inputs)
+        {
+            if (ckt.node_to_gate_map[input->name].size() != 1 ||
+                ckt.is_primary_output(input->name))
+            {
+                continue;
+            }
+            int inputSA0 = this->nodeFaultIndex[input->name];
+            int inputSA1 = inputSA0 + 1;
+            int outputSA0 = this->nodeFaultIndex[gate->output->name];
+            int outputSA1 = outputSA0 + 1;
+            switch (gate->get_gate_logic())
+            {
+            case(and_l):
+                this->merge_faults(inputSA0, outputSA0);
+                dominanceEdges.push_back(std::make_pair(outputSA1, inputSA1));
+                break;
+            case(nand_l):
+                this->merge_faults(inputSA0, outputSA1);
+                dominanceEdges.push_back(std::make_pair(outputSA0, inputSA1));
+                break;
+            case(or_l):
+                this->merge_faults(inputSA1, outputSA1);
+                dominanceEdges.push_back(std::make_pair(outputSA0, inputSA0));
+                break;
+            case(nor_l):
+                this->merge_faults(inputSA1, outputSA0);
+                dominanceEdges.push_back(std::make_pair(outputSA1, inputSA0));
+                break;
+            case(not_l):
+                this->merge_faults(inputSA0, outputSA1);
+                this->merge_faults(inputSA1, outputSA0);
+                break;
+            case(buf_l):
+                this->merge_faults(inputSA0, outputSA0);
+                this->merge_faults(inputSA1, outputSA1);
+                break;
+            default:
+                // no structural equivalence through xor/xnor
+                break;
+            }
+        }
+    }
+
+    // Number the classes in order of their smallest fault index
+    std::vector<int> rootClass(numFaults, -1);
+    this->faultClass.assign(numFaults, -1);
+    for (int i = 0; i < numFaults; ++i)
+    {
+        int rootFault = this->find_root(i);
+        if (rootClass[rootFault] == -1)
+        {
+            rootClass[rootFault] = this->classMembers.size();
+            this->classMembers.push_back(std::vector<int>());
+        }
+        this->faultClass[i] = rootClass[rootFault];
+        this->classMembers[rootClass[rootFault]].push_back(i);
+    }
+    this->classDropped.assign(this->classMembers.size(), false);
+    this->dominatedClasses.assign(this->classMembers.size(), std::vector<int>());
+
+    if (useDominance)
+    {
+        // dominance follows fanout free chains towards the inputs => no cycles
+        for (std::pair<int, int> edge : dominanceEdges)
+        {
+            int dominatingClass = this->faultClass[edge.first];
+            int dominatedClass = this->faultClass[edge.second];
+            if (dominatingClass != dominatedClass)
+            {
+                this->classDropped[dominatingClass] = true;
+                this->dominatedClasses[dominatingClass].push_back(dominatedClass);
+            }
+        }
+    }
+}
+
+/*
+* Function to find the union-find root of a fault
+* @param faultIndex -> index of fault
+* @return int -> root fault index
+*/
+int FaultCollapser::find_root(int faultIndex)
+{
+    while (this->parentFault[faultIndex] != faultIndex)
+    {
+        // path halving
+        this->parentFault[faultIndex] = this->parentFault[this->parentFault[faultIndex]];
+        faultIndex = this->parentFault[faultIndex];
+    }
+    return faultIndex;
+}
+
+/*
+* Function to merge the equivalence classes of two faults
+* @param faultIndex1 -> index of first fault
+* @param faultIndex2 -> index of second fault
+*/
+void FaultCollapser::merge_faults(int faultIndex1, int faultIndex2)
+{
+    int root1 = this->find_root(faultIndex1);
+    int root2 = this->find_root(faultIndex2);
+    // keep the smaller index as root => representative is the first fault of the class
+    if (root1 < root2)
+    {
+        this->parentFault[root2] = root1;
+    }
+    else if (root2 < root1)
+    {
+        this->parentFault[root1] = root2;
+    }
+}
+
+/*
+* Function to get the faults to target, one per kept class
+* @return vector of pairs -> representative faults
+*/
+std::vector<std::pair<int, int>> FaultCollapser::get_representative_faults()
+{
+    std::vector<std::pair<int, int>> representativeFaults;
+    for (unsigned int i = 0; i < this->classMembers.size(); ++i)
+    {
+        if (this->classDropped[i] == false)
+        {
+            representativeFaults.push_back(this->faultList[this->classMembers[i].front()]);
+        }
+    }
+    return representativeFaults;
+}
+
+/*
+* Function to expand detected representatives to the complete fault list
+* Dropped classes count as detected when a class they dominate is detected
+* @param detectedFaults -> detected representative faults
+* @return set of pairs -> detected faults of the complete fault list
+*/
+std::set<std::pair<int, int>> FaultCollapser::expand_detected_faults(const std::set<std::pair<int, int>>& detectedFaults)
+{
+    std::vector<bool> classDetected(this->classMembers.size(), false);
+    for (unsigned int i = 0; i < this->classMembers.size(); ++i)
+    {
+        if (this->classDropped[i] == false &&
+            detectedFaults.count(this->faultList[this->classMembers[i].front()]) > 0)
+        {
+            classDetected[i] = true;
+        }
+    }
+
+    // Infer the dropped classes until nothing changes (chains are short)
+    bool isChanged = true;
+    while (isChanged)
+    {
+        isChanged = false;
+        for (unsigned int i = 0; i < this->classMembers.size(); ++i)
+        {
+            if (classDetected[i])
+            {
+                continue;
+            }
+            for (int dominatedClass : this->dominatedClasses[i])
+            {
+                if (classDetected[dominatedClass])
+                {
+                    classDetected[i] = true;
+                    isChanged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::set<std::pair<int, int>> expandedFaults;
+    for (unsigned int i = 0; i < this->classMembers.size(); ++i)
+    {
+        if (classDetected[i])
+        {
+            for (int faultIndex : this->classMembers[i])
+            {
+                expandedFaults.insert(this->faultList[faultIndex]);
+            }
+        }
+    }
+    return expandedFaults;
+}
@@ -0,0 +1,83 @@
+#ifndef __FAULTCOLLAPSER_H__
+#define __FAULTCOLLAPSER_H__
+
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include "Circuit.h"
+
+/*
+* Class for structural fault collapsing
+* The fault list has s-a-0 and s-a-1 on every node. Faults are modelled on
+* nodes, so a gate input fault is only equivalent to (or dominated by) a gate
+* output fault when the input node feeds that single gate and is not a
+* primary output.
+* Equivalence: AND/NAND input s-a-0, OR/NOR input s-a-1 and both INV/BUF input
+* faults are merged with the matching output fault.
+* Dominance: AND/NAND output s-a-1/s-a-0 and OR/NOR output s-a-0/s-a-1 are
+* detected by any test for the fanout free input s-a-1/s-a-0 => not targeted.
+*/
+class FaultCollapser
+{
+public:
+    // Complete fault list, pair of entry => first = node name, second = stuck at value
+    std::vector<std::pair<int, int>> faultList;
+
+    // Node name to index of its s-a-0 fault (s-a-1 is the next index)
+    std::unordered_map<int, int> nodeFaultIndex;
+
+    // Union-find parent per fault index
+    std::vector<int> parentFault;
+
+    // Fault index to class index
+    std::vector<int> faultClass;
+
+    // Class index to fault indices in the class
+    std::vector<std::vector<int>> classMembers;
+
+    // Class index to whether the class is dropped by dominance
+    std::vector<bool> classDropped;
+
+    // Class index to classes whose detection implies detection of this class
+    std::vector<std::vector<int>> dominatedClasses;
+
+    /*
+    * Constructor for the class
+    * Builds the equivalence classes and, optionally, prunes dominating classes
+    * @param ckt -> circuit read from netlist
+    * @param useDominance -> also drop classes dominated by a gate input fault
+    */
+    FaultCollapser(Circuit& ckt, bool useDominance);
+
+    /*
+    * Function to find the union-find root of a fault
+    * @param faultIndex -> index of fault
+    * @return int -> root fault index
+    */
+    int find_root(int faultIndex);
+
+    /*
+    * Function to merge the equivalence classes of two faults
+    * @param faultIndex1 -> index of first fault
+    * @param faultIndex2 -> index of second fault
+    */
+    void merge_faults(int faultIndex1, int faultIndex2);
+
+    /*
+    * Function to get the faults to target, one per kept class
+    * @return vector of pairs -> representative faults
+    */
+    std::vector<std::pair<int, int>> get_representative_faults();
+
+    /*
+    * Function to expand detected representatives to the complete fault list
+    * Dropped classes count as detected when a class they dominate is detected
+    * @param detectedFaults -> detected representative faults
+    * @return set of pairs -> detected faults of the complete fault list
+    */
+    std::set<std::pair<int, int>> expand_detected_faults(const std::set<std::pair<int, int>>& detectedFaults);
+};
+
+#endif
@@ -0,0 +1,180 @@
+#include <iostream>
+#include <algorithm>
+#include "FaultSimulator.h"
+
+// Number of faulty machines per pass (bit 0 is the good machine)
+const int machinesPerPass = 63;
+
+/*
+* Function to evaluate a gate on node words
+* @param logic -> logic of the gate
+* @param input1Word -> word of input1
+* @param input2Word -> word of input2 (ignored for single input gates)
+* @return uint64_t -> word of the output
+*/
+static uint64_t evaluate_gate_word(gateLogic logic, uint64_t input1Word, uint64_t input2Word)
+{
+    switch (logic)
+    {
+    case(and_l):
+        return input1Word & input2Word;
+    case(or_l):
+        return input1Word | input2Word;
+    case(not_l):
+        return ~input1Word;
+    case(nand_l):
+        return ~(input1Word & input2Word);
+    case(nor_l):
+        return ~(input1Word | input2Word);
+    case(xor_l):
+        return input1Word ^ input2Word;
+    case(xnor_l):
+        return ~(input1Word ^ input2Word);
+    case(buf_l):
+        return input1Word;
+    default:
+        break;
+    }
+    return 0;
+}
+
+/*
+* Constructor for the class
+* @param ckt -> circuit read from netlist
+*/
+FaultSimulator::FaultSimulator(Circuit& ckt)
+{
+    for (int nodeName : ckt.node_list)
+    {
+        int newIndex = this->nodeIndex.size();
+        this->nodeIndex[nodeName] = newIndex;
+    }
+    for (int nodeName : ckt.inputNodes)
+    {
+        this->inputIndices.push_back(this->nodeIndex[nodeName]);
+    }
+    for (int nodeName : ckt.outputNodes)
+    {
+        this->outputIndices.push_back(this->nodeIndex[nodeName]);
+    }
+
+    // Topological order: a gate is ready once all of its input nodes are driven
+    std::vector<bool> isDriven(this->nodeIndex.size(), true);
+    for (Gate* gate : ckt.gateList)
+    {
+        isDriven[this->nodeIndex[gate->output->name]] = false;
+    }
+    std::unordered_map<Gate*, int> inputsLeft;
+    std::vector<Gate*> readyGates;
+    for (Gate* gate : ckt.gateList)
+    {
+        int numInputs = 0;
+        numInputs += (isDriven[this->nodeIndex[gate->input1->name]] == false);
+        if (gate->is_single_input() == false && gate->input2 != gate->input1)
+        {
+            numInputs += (isDriven[this->nodeIndex[gate->input2->name]] == false);
+        }
+        inputsLeft[gate] = numInputs;
+        if (numInputs == 0)
+        {
+            readyGates.push_back(gate);
+        }
+    }
+    for (unsigned int i = 0; i < readyGates.size(); ++i)
+    {
+        Gate* gate = readyGates[i];
+        SimGate simGate;
+        simGate.logic = gate->get_gate_logic();
+        simGate.input1 = this->nodeIndex[gate->input1->name];
+        simGate.input2 = gate->is_single_input() ? -1 : this->nodeIndex[gate->input2->name];
+        simGate.output = this->nodeIndex[gate->output->name];
+        this->gates.push_back(simGate);
+        for (Gate* fanoutGate : ckt.node_to_gate_map[gate->output->name])
+        {
+            // a gate with both inputs on this node is listed twice and released on the first
+            if (--inputsLeft[fanoutGate] == 0)
+            {
+                readyGates.push_back(fanoutGate);
+            }
+        }
+    }
+    if (this->gates.size() != ckt.gateList.size())
+    {
+        std::cerr << "Netlist has a combinational loop, " << ckt.gateList.size() - this->gates.size()
+            << " gates are not simulated\n";
+    }
+
+    this->nodeWords.assign(this->nodeIndex.size(), 0);
+    this->stuckAt0Masks.assign(this->nodeIndex.size(), 0);
+    this->stuckAt1Masks.assign(this->nodeIndex.size(), 0);
+}
+
+/*
+* Function to grade a fully specified test vector against a list of faults
+* @param testVector -> 0/1 value per primary input in netlist order
+* @param faults -> faults to grade, pair of node name and stuck at value
+* @return vector of int -> positions in faults of the detected faults
+*/
+std::vector<int> FaultSimulator::simulate_test_vector(const std::string& testVector,
+    const std::vector<std::pair<int, int>>& faults)
+{
+    std::vector<int> detectedFaults;
+    for (unsigned int passStart = 0; passStart < faults.size(); passStart += machinesPerPass)
+    {
+        // Inject the faults of this pass, fault k of the pass in bit k + 1
+        unsigned int passEnd = std::min<size_t>(passStart + machinesPerPass, faults.size());
+        std::vector<int> faultyNodes;
+        for (unsigned int i = passStart; i < passEnd; ++i)
+        {
+            int faultyNode = this->nodeIndex[faults[i].first];
+            uint64_t machineBit = (uint64_t)1 << (i - passStart + 1);
+            if (faults[i].second == 0)
+            {
+                this->stuckAt0Masks[faultyNode] |= machineBit;
+            }
+            else
+            {
+                this->stuckAt1Masks[faultyNode] |= machineBit;
+            }
+            faultyNodes.push_back(faultyNode);
+        }
+
+        // Good value is copied to all machines, then the faults are forced
+        for (unsigned int i = 0; i < this->inputIndices.size(); ++i)
+        {
+            int nodeIndex = this->inputIndices[i];
+            uint64_t inputWord = (testVector[i] == '1') ? ~(uint64_t)0 : 0;
+            this->nodeWords[nodeIndex] = (inputWord & ~this->stuckAt0Masks[nodeIndex]) | this->stuckAt1Masks[nodeIndex];
+        }
+        for (const SimGate& gate : this->gates)
+        {
+            uint64_t input2Word = (gate.input2 == -1) ? 0 : this->nodeWords[gate.input2];
+            uint64_t outputWord = evaluate_gate_word(gate.logic, this->nodeWords[gate.input1], input2Word);
+            this->nodeWords[gate.output] = (outputWord & ~this->stuckAt0Masks[gate.output]) |
+                this->stuckAt1Masks[gate.output];
+        }
+
+        // A machine is detected when it differs from the good machine on any output
+        uint64_t detectedMask = 0;
+        for (int nodeIndex : this->outputIndices)
+        {
+            uint64_t goodWord = (this->nodeWords[nodeIndex] & 1) ? ~(uint64_t)0 : 0;
+            detectedMask |= this->nodeWords[nodeIndex] ^ goodWord;
+        }
+        for (unsigned int i = passStart; i < passEnd; ++i)
+        {
+            if ((detectedMask >> (i - passStart + 1)) & 1)
+            {
+                detectedFaults.push_back(i);
+            }
+        }
+
+        // Clear the injected faults for the next pass
+        for (int faultyNode : faultyNodes)
+        {
+            this->stuckAt0Masks[faultyNode] = 0;
+            this->stuckAt1Masks[faultyNode] = 0;
+        }
+    }
+    return detectedFaults;
+}
@@ -0,0 +1,75 @@
+#ifndef __FAULTSIMULATOR_H__
+#define __FAULTSIMULATOR_H__
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+
+#include "Circuit.h"
+
+/*
+* Gate of the fault simulator, nodes given by their index
+*/
+struct SimGate
+{
+    // Logic of the gate
+    gateLogic logic;
+    // Index of input1
+    int input1;
+    // Index of input2 (-1 for single input gates)
+    int input2;
+    // Index of the output
+    int output;
+};
+
+/*
+* Class for parallel fault simulation of single test vectors
+* The circuit is read once and its gates are put in topological order.
+* Bit 0 of a node word holds the good machine and bits 1 to 63 hold one
+* faulty machine each, so a test vector is graded against 63 stuck-at
+* faults per pass over the gates. Faults are injected by forcing the bit of
+* their machine on the faulty node.
+*/
+class FaultSimulator
+{
+public:
+    // Node name to node index
+    std::unordered_map<int, int> nodeIndex;
+
+    // Gates in topological order
+    std::vector<SimGate> gates;
+
+    // Primary input node indices in netlist order
+    std::vector<int> inputIndices;
+
+    // Primary output node indices in netlist order
+    std::vector<int> outputIndices;
+
+    // Node word of the current pass
+    std::vector<uint64_t> nodeWords;
+
+    // Machines forced to 0 per node in the current pass
+    std::vector<uint64_t> stuckAt0Masks;
+
+    // Machines forced to 1 per node in the current pass
+    std::vector<uint64_t> stuckAt1Masks;
+
+    /*
+    * Constructor for the class
+    * @param ckt -> circuit read from netlist
+    */
+    FaultSimulator(Circuit& ckt);
+
+    /*
+    * Function to grade a fully specified test vector against a list of faults
+    * @param testVector -> 0/1 value per primary input in netlist order
+    * @param faults -> faults to grade, pair of node name and stuck at value
+    * @return vector of int -> positions in faults of the detected faults
+    */
+    std::vector<int> simulate_test_vector(const std::string& testVector,
+        const std::vector<std::pair<int, int>>& faults);
+};
+
+#endif
@@ -56,157 +56,103 @@ gateLogic Gate::get_gate_logic()
     return this->logic;
 }
 
+/*
+* Two-rail form of the logic values, a rail holds the value in the good or
+* faulty circuit: 0, 1 or 2 for unknown
+*/
+constexpr int get_good_rail(logicValue inValue)
+{
+    return (inValue == One || inValue == D) ? 1 : ((inValue == Zero || inValue == DBar) ? 0 : 2);
+}
+
+constexpr int get_faulty_rail(logicValue inValue)
+{
+    return (inValue == One || inValue == DBar) ? 1 : ((inValue == Zero || inValue == D) ? 0 : 2);
+}
+
+constexpr int invert_rail(int rail)
+{
+    return (rail == 2) ? 2 : 1 - rail;
+}
+
+/*
+* Function to evaluate a gate on one rail with 3-valued logic
+* @param logic -> logic of the gate
+* @param rail1 -> input1 rail value
+* @param rail2 -> input2 rail value (ignored by single input gates)
+* @return int -> output rail value
+*/
+constexpr int simulate_rail(gateLogic logic, int rail1, int rail2)
+{
+    return (logic == and_l) ? ((rail1 == 0 || rail2 == 0) ? 0 : ((rail1 == 1 && rail2 == 1) ? 1 : 2)) :
+        (logic == or_l) ? ((rail1 == 1 || rail2 == 1) ? 1 : ((rail1 == 0 && rail2 == 0) ? 0 : 2)) :
+        (logic == xor_l) ? ((rail1 == 2 || rail2 == 2) ? 2 : (rail1 ^ rail2)) :
+        (logic == buf_l) ? rail1 :
+        (logic == nand_l) ? invert_rail(simulate_rail(and_l, rail1, rail2)) :
+        (logic == nor_l) ? invert_rail(simulate_rail(or_l, rail1, rail2)) :
+        (logic == xnor_l) ? invert_rail(simulate_rail(xor_l, rail1, rail2)) :
+        (logic == not_l) ? invert_rail(rail1) :
+        2;
+}
+
+/*
+* Function to merge the good and faulty rails back to a logic value
+* @param goodRail -> value in the good circuit
+* @param faultyRail -> value in the faulty circuit
+* @return logicValue -> X unless both rails are known
+*/
+constexpr logicValue merge_rails(int goodRail, int faultyRail)
+{
+    return (goodRail == 2 || faultyRail == 2) ? X :
+        (goodRail == faultyRail) ? (goodRail == 1 ? One : Zero) :
+        (goodRail == 1 ? D : DBar);
+}
+
+/*
+* Function to evaluate a gate on the 5-valued D-calculus from the two-rail semantics
+* @param logic -> logic of the gate
+* @param input1Value -> value of input1
+* @param input2Value -> value of input2 (X for single input gates)
+* @return logicValue -> output value
+*/
+constexpr logicValue evaluate_two_rail(gateLogic logic, logicValue input1Value, logicValue input2Value)
+{
+    return merge_rails(simulate_rail(logic, get_good_rail(input1Value), get_good_rail(input2Value)),
+        simulate_rail(logic, get_faulty_rail(input1Value), get_faulty_rail(input2Value)));
+}
+
+#define TRUTH_TABLE_ROW(logic, input1Value) { evaluate_two_rail(logic, input1Value, Zero), \
+    evaluate_two_rail(logic, input1Value, One), evaluate_two_rail(logic, input1Value, D), \
+    evaluate_two_rail(logic, input1Value, DBar), evaluate_two_rail(logic, input1Value, X) }
+#define TRUTH_TABLE(logic) { TRUTH_TABLE_ROW(logic, Zero), TRUTH_TABLE_ROW(logic, One), \
+    TRUTH_TABLE_ROW(logic, D), TRUTH_TABLE_ROW(logic, DBar), TRUTH_TABLE_ROW(logic, X) }
+
+// Output value per gate logic, input1 value and input2 value, generated at compile time
+static constexpr logicValue truthTables[none_l][X + 1][X + 1] = {
+    TRUTH_TABLE(and_l), TRUTH_TABLE(or_l), TRUTH_TABLE(not_l), TRUTH_TABLE(nand_l),
+    TRUTH_TABLE(nor_l), TRUTH_TABLE(xor_l), TRUTH_TABLE(xnor_l), TRUTH_TABLE(buf_l)
+};
+
+#undef TRUTH_TABLE
+#undef TRUTH_TABLE_ROW
+
+static_assert(truthTables[and_l][D][DBar] == Zero && truthTables[nor_l][DBar][DBar] == D &&
+    truthTables[xor_l][D][One] == DBar && truthTables[not_l][D][X] == DBar && truthTables[nand_l][One][X] == X,
+    "Truth tables do not follow the D-calculus");
+
 /*
 * Function to simulate the gate
 * @return bool -> simulate gates taking into account all input types 0, 1, D, DBar, X
 */
 bool Gate::simulate()
 {
-    // NOTE: Bitwise not was found to work different => switching to boolean not
-    logicValue input1Value = this->input1->value;
-    logicValue input2Value = X;
-    if (this->is_single_input() == false)
-    {
-        input2Value = this->input2->value;
-    };
-    switch (this->get_gate_logic())
+    if (this->logic >= none_l)
     {
-    case(and_l):
-        if (input1Value == Zero || input2Value == Zero)
-        {
-            this->output->value = Zero;
-        }
-        else if (input1Value == One)
-        {
-            this->output->value = input2Value;
-        }
-        else if (input2Value == One)
-        {
-            this->output->value = input1Value;
-        }
-        else if (input1Value == D && input2Value == D)
-        {
-            this->output->value = D;
-        }
-        else if (input1Value == DBar && input2Value == DBar)
-        {
-            this->output->value = DBar;
-        }
-        else if (input1Value == D && input2Value == DBar)
-        {
-            this->output->value = Zero;
-        }
-        else if (input1Value == DBar && input2Value == D)
-        {
-            this->output->value = Zero;
-        }
-        break;
-    case(or_l):
-        if (input1Value == One || input2Value == One)
-        {
-            this->output->value = One;
-        }
-        else if (input1Value == Zero)
-        {
-            this->output->value = input2Value;
-        }
-        else if (input2Value == Zero)
-        {
-            this->output->value = input1Value;
-        }
-        else if (input1Value == D && input2Value == D)
-        {
-            this->output->value = D;
-        }
-        else if (input1Value == DBar && input2Value == DBar)
-        {
-            this->output->value = DBar;
-        }
-        else if (input1Value == D && input2Value == DBar)
-        {
-            this->output->value = One;
-        }
-        else if (input1Value == DBar && input2Value == D)
-        {
-            this->output->value = One;
-        }
-        break;
-    case(not_l):
-        this->output->value = get_not_value(input1Value);
-        break;
-    case(nand_l):
-        if (input1Value == Zero || input2Value == Zero)
-        {
-            this->output->value = One;
-        }
-        else if (input1Value == One)
-        {
-            this->output->value = get_not_value(input2Value);
-        }
-        else if (input2Value == One)
-        {
-            this->output->value = get_not_value(input1Value);
-        }
-        else if (input1Value == D && input2Value == D)
-        {
-            this->output->value = DBar;
-        }
-        else if (input1Value == DBar && input2Value == DBar)
-        {
-            this->output->value = D;
-        }
-        else if (input1Value == D && input2Value == DBar)
-        {
-            this->output->value = One;
-        }
-        else if (input1Value == DBar && input2Value == D)
-        {
-            this->output->value = One;
-        }
-        break;
-    case(nor_l):
-        if (input1Value == One || input2Value == One)
-        {
-            this->output->value = Zero;
-        }
-        else if (input1Value == Zero)
-        {
-            this->output->value = get_not_value(input2Value);
-        }
-        else if (input2Value == Zero)
-        {
-            this->output->value = get_not_value(input1Value);
-        }
-        else if (input1Value == D && input2Value == D)
-        {
-            this->output->value = DBar;
-        }
-        else if (input1Value == DBar && input2Value == DBar)
-        {
-            this->output->value = D;
-        }
-        else if (input1Value == D && input2Value == DBar)
-        {
-            this->output->value = Zero;
-        }
-        else if (input1Value == DBar && input2Value == D)
-        {
-            this->output->value = Zero;
-        }
-        break;
-    case(xor_l):
-        std::cerr << "Dev Error: XOR gate not supported\n";
-        break;
-    case(xnor_l):
-        std::cerr << "Dev Error: XNOR gate not supported\n";
-        break;
-    case(buf_l):
-        this->output->value = input1Value;
-        break;
-    default:
         std::cerr << "Gate at uninitialized logic." << "\n";
-        break;
+        return this->output->set_fault_value();
     }
+    logicValue input2Value = this->is_single_input() ? X : this->input2->value;
+    this->output->value = truthTables[this->logic][this->input1->value][input2Value];
 
     // Update output value based on whether a fault exists on the node
     return this->output->set_fault_value();
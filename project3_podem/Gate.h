@@ -25,6 +25,10 @@ public:
     Node* output;
     // Logic for the gate
     gateLogic logic;
+    // Logic level, one more than the highest level of its inputs
+    int level;
+    // Gate is waiting in the implication event queue
+    bool isScheduled;
 
     /*
     * Setter for the logic of the gate
@@ -29,6 +29,20 @@ public:
     // Stuck at flags
     bool is_stuck_at_0;
     bool is_stuck_at_1;
+    // SCOAP 0-controllability, 1-controllability and observability
+    int cc0;
+    int cc1;
+    int co;
+    // Position of the driving gate in the circuit D-frontier (-1 if not in it)
+    int dfrontierIndex;
+    // Decision stamp of the last PODEM trail entry saving this node
+    int trailStamp;
+    // Logic level, 0 for primary inputs, level of the driving gate otherwise
+    int level;
+    // Node is a primary output
+    bool isPrimaryOutput;
+    // Node is X and has a path of X nodes to a primary output
+    bool hasXPath;
 
     /*
     * Function to check if the node has a fault and update
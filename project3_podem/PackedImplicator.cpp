@@ -0,0 +1,215 @@
+#include <iostream>
+#include "PackedImplicator.h"
+
+/*
+* Constructor for the class
+* @param ckt -> circuit read from netlist (levelized)
+*/
+PackedImplicator::PackedImplicator(Circuit& ckt) : conflictLanes(0)
+{
+    for (int nodeName : ckt.node_list)
+    {
+        int newIndex = this->nodeIndex.size();
+        this->nodeIndex[nodeName] = newIndex;
+    }
+    for (int nodeName : ckt.inputNodes)
+    {
+        this->inputIndices.push_back(this->nodeIndex[nodeName]);
+    }
+    for (int nodeName : ckt.outputNodes)
+    {
+        this->outputIndices.push_back(this->nodeIndex[nodeName]);
+    }
+    for (Gate* gate : ckt.levelizedGates)
+    {
+        SimGate simGate;
+        simGate.logic = gate->get_gate_logic();
+        simGate.input1 = this->nodeIndex[gate->input1->name];
+        simGate.input2 = gate->is_single_input() ? -1 : this->nodeIndex[gate->input2->name];
+        simGate.output = this->nodeIndex[gate->output->name];
+        this->gates.push_back(simGate);
+    }
+    this->clear();
+}
+
+/*
+* Function to set all lanes back to X and remove their faults
+*/
+void PackedImplicator::clear()
+{
+    this->nodeValues.assign(this->nodeIndex.size(), get_packed_x());
+    this->stuckAt0Masks.assign(this->nodeIndex.size(), 0);
+    this->stuckAt1Masks.assign(this->nodeIndex.size(), 0);
+    this->faultNodes.assign(packedLanes, -1);
+    this->conflictLanes = 0;
+}
+
+/*
+* Function to set the target fault of a lane
+* @param lane -> lane of the problem
+* @param nodeName -> node with the fault
+* @param stuckAtValue -> stuck at value (0 or 1)
+* @return bool -> if the node exists
+*/
+bool PackedImplicator::set_fault(int lane, int nodeName, int stuckAtValue)
+{
+    auto nodeItr = this->nodeIndex.find(nodeName);
+    if (nodeItr == this->nodeIndex.end())
+    {
+        std::cerr << "Unknown fault node " << nodeName << "\n";
+        return false;
+    }
+    uint64_t laneBit = (uint64_t)1 << lane;
+    if (this->faultNodes[lane] != -1)
+    {
+        this->stuckAt0Masks[this->faultNodes[lane]] &= ~laneBit;
+        this->stuckAt1Masks[this->faultNodes[lane]] &= ~laneBit;
+    }
+    this->faultNodes[lane] = nodeItr->second;
+    if (stuckAtValue == 0)
+    {
+        this->stuckAt0Masks[nodeItr->second] |= laneBit;
+    }
+    else
+    {
+        this->stuckAt1Masks[nodeItr->second] |= laneBit;
+    }
+    return true;
+}
+
+/*
+* Function to assign a primary input value on a lane
+* @param lane -> lane of the problem
+* @param nodeName -> primary input to assign
+* @param inValue -> value to assign
+* @return bool -> if the node exists
+*/
+bool PackedImplicator::assign_input(int lane, int nodeName, logicValue inValue)
+{
+    auto nodeItr = this->nodeIndex.find(nodeName);
+    if (nodeItr == this->nodeIndex.end())
+    {
+        std::cerr << "Unknown input node " << nodeName << "\n";
+        return false;
+    }
+    set_packed_lane(this->nodeValues[nodeItr->second], lane, inValue);
+    return true;
+}
+
+/*
+* Function to force the faulty plane of the fault sites, packed form of Node::set_fault_value
+* @param nodeValue -> value of the node (updated in place)
+* @param stuckAt0Mask -> lanes with a stuck-at-0 fault on the node
+* @param stuckAt1Mask -> lanes with a stuck-at-1 fault on the node
+* @return uint64_t -> lanes where the node has its stuck value in the good machine
+*/
+static uint64_t set_packed_fault_value(PackedValue& nodeValue, uint64_t stuckAt0Mask, uint64_t stuckAt1Mask)
+{
+    // only known lanes are forced, 1 becomes D and 0 becomes DBar
+    uint64_t knownLanes = nodeValue.goodKnown & nodeValue.faultyKnown;
+    nodeValue.faulty = (nodeValue.faulty & ~stuckAt0Mask) | (stuckAt1Mask & knownLanes);
+    return knownLanes & ((stuckAt0Mask & ~nodeValue.good) | (stuckAt1Mask & nodeValue.good));
+}
+
+/*
+* Function to imply the primary input values of all lanes
+* @return uint64_t -> lanes without conflict
+*/
+uint64_t PackedImplicator::imply()
+{
+    this->conflictLanes = 0;
+    for (int inputIndex : this->inputIndices)
+    {
+        if (this->stuckAt0Masks[inputIndex] | this->stuckAt1Masks[inputIndex])
+        {
+            // faulty plane follows the assigned value before the fault is forced again
+            PackedValue& inputValue = this->nodeValues[inputIndex];
+            inputValue.faulty = inputValue.good;
+            this->conflictLanes |= set_packed_fault_value(inputValue,
+                this->stuckAt0Masks[inputIndex], this->stuckAt1Masks[inputIndex]);
+        }
+    }
+    for (const SimGate& gate : this->gates)
+    {
+        const PackedValue& input2Value = (gate.input2 == -1) ? this->nodeValues[gate.input1] : this->nodeValues[gate.input2];
+        PackedValue& outputValue = this->nodeValues[gate.output];
+        outputValue = simulate_packed(gate.logic, this->nodeValues[gate.input1], input2Value);
+        if (this->stuckAt0Masks[gate.output] | this->stuckAt1Masks[gate.output])
+        {
+            this->conflictLanes |= set_packed_fault_value(outputValue,
+                this->stuckAt0Masks[gate.output], this->stuckAt1Masks[gate.output]);
+        }
+    }
+    return ~this->conflictLanes;
+}
+
+/*
+* Function to get the implied value of a node on a lane
+* @param lane -> lane of the problem
+* @param nodeName -> node to read
+* @return logicValue -> value of the node
+*/
+logicValue PackedImplicator::get_value(int lane, int nodeName)
+{
+    return get_packed_lane(this->nodeValues[this->nodeIndex[nodeName]], lane);
+}
+
+/*
+* Function to get the lanes with a fault effect on a primary output
+* @return uint64_t -> lanes whose fault is detected
+*/
+uint64_t PackedImplicator::get_detected_lanes()
+{
+    uint64_t detectedLanes = 0;
+    for (int outputIndex : this->outputIndices)
+    {
+        detectedLanes |= get_fault_effect_lanes(this->nodeValues[outputIndex]);
+    }
+    return detectedLanes & ~this->conflictLanes;
+}
+
+/*
+* Function to get the lanes whose fault can still be detected by assigning X inputs
+* A lane is testable if its fault is detected, or if its X fault site or a D-frontier
+* gate has a path of X nodes to a primary output
+* @return uint64_t -> testable lanes
+*/
+uint64_t PackedImplicator::get_testable_lanes()
+{
+    // Lanes per node with a path of X nodes to a primary output, from the outputs backwards
+    std::vector<uint64_t> xpathLanes(this->nodeValues.size(), 0);
+    for (int outputIndex : this->outputIndices)
+    {
+        xpathLanes[outputIndex] = get_x_lanes(this->nodeValues[outputIndex]);
+    }
+    for (auto gateItr = this->gates.rbegin(); gateItr != this->gates.rend(); ++gateItr)
+    {
+        uint64_t outputLanes = xpathLanes[gateItr->output];
+        xpathLanes[gateItr->input1] |= outputLanes & get_x_lanes(this->nodeValues[gateItr->input1]);
+        if (gateItr->input2 != -1)
+        {
+            xpathLanes[gateItr->input2] |= outputLanes & get_x_lanes(this->nodeValues[gateItr->input2]);
+        }
+    }
+
+    uint64_t testableLanes = this->get_detected_lanes();
+    for (const SimGate& gate : this->gates)
+    {
+        // D-frontier gate: X output (part of the path) and a fault effect on an input
+        uint64_t faultEffectLanes = get_fault_effect_lanes(this->nodeValues[gate.input1]);
+        if (gate.input2 != -1)
+        {
+            faultEffectLanes |= get_fault_effect_lanes(this->nodeValues[gate.input2]);
+        }
+        testableLanes |= faultEffectLanes & xpathLanes[gate.output];
+    }
+    for (int lane = 0; lane < packedLanes; ++lane)
+    {
+        // fault not activated yet
+        if (this->faultNodes[lane] != -1)
+        {
+            testableLanes |= xpathLanes[this->faultNodes[lane]] & ((uint64_t)1 << lane);
+        }
+    }
+    return testableLanes & ~this->conflictLanes;
+}
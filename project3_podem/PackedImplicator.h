@@ -0,0 +1,108 @@
+#ifndef __PACKEDIMPLICATOR_H__
+#define __PACKEDIMPLICATOR_H__
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "Circuit.h"
+#include "FaultSimulator.h"
+#include "PackedLogic.h"
+
+/*
+* Class for implication of 64 independent ATPG problems in one pass
+* Every lane has its own target fault and primary input assignment. A pass
+* over the gates in topological order evaluates all lanes with bitwise
+* operations on the packed 5-valued values, with the same results as the
+* serial implication of each lane. The fault of a lane is injected on the
+* faulty plane of its node once the good value is known.
+*/
+class PackedImplicator
+{
+public:
+    // Node name to node index
+    std::unordered_map<int, int> nodeIndex;
+
+    // Gates in topological order
+    std::vector<SimGate> gates;
+
+    // Primary input node indices
+    std::vector<int> inputIndices;
+
+    // Primary output node indices
+    std::vector<int> outputIndices;
+
+    // Packed value per node
+    std::vector<PackedValue> nodeValues;
+
+    // Lanes with a stuck-at-0 fault per node
+    std::vector<uint64_t> stuckAt0Masks;
+
+    // Lanes with a stuck-at-1 fault per node
+    std::vector<uint64_t> stuckAt1Masks;
+
+    // Fault node index per lane (-1 if the lane has no fault)
+    std::vector<int> faultNodes;
+
+    // Lanes whose fault site was implied to its stuck value by the last imply
+    uint64_t conflictLanes;
+
+    /*
+    * Constructor for the class
+    * @param ckt -> circuit read from netlist (levelized)
+    */
+    PackedImplicator(Circuit& ckt);
+
+    /*
+    * Function to set all lanes back to X and remove their faults
+    */
+    void clear();
+
+    /*
+    * Function to set the target fault of a lane
+    * @param lane -> lane of the problem
+    * @param nodeName -> node with the fault
+    * @param stuckAtValue -> stuck at value (0 or 1)
+    * @return bool -> if the node exists
+    */
+    bool set_fault(int lane, int nodeName, int stuckAtValue);
+
+    /*
+    * Function to assign a primary input value on a lane
+    * @param lane -> lane of the problem
+    * @param nodeName -> primary input to assign
+    * @param inValue -> value to assign
+    * @return bool -> if the node exists
+    */
+    bool assign_input(int lane, int nodeName, logicValue inValue);
+
+    /*
+    * Function to imply the primary input values of all lanes
+    * @return uint64_t -> lanes without conflict
+    */
+    uint64_t imply();
+
+    /*
+    * Function to get the implied value of a node on a lane
+    * @param lane -> lane of the problem
+    * @param nodeName -> node to read
+    * @return logicValue -> value of the node
+    */
+    logicValue get_value(int lane, int nodeName);
+
+    /*
+    * Function to get the lanes with a fault effect on a primary output
+    * @return uint64_t -> lanes whose fault is detected
+    */
+    uint64_t get_detected_lanes();
+
+    /*
+    * Function to get the lanes whose fault can still be detected by assigning X inputs
+    * A lane is testable if its fault is detected, or if its X fault site or a D-frontier
+    * gate has a path of X nodes to a primary output
+    * @return uint64_t -> testable lanes
+    */
+    uint64_t get_testable_lanes();
+};
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef __PACKEDLOGIC_H__
+#define __PACKEDLOGIC_H__
+
+#include <cstdint>
+
+#include "Gate.h"
+
+// Number of independent problems (lanes) in a packed value
+const int packedLanes = 64;
+
+/*
+* 5-valued logic of 64 lanes packed as good and faulty machine bit planes
+* Lane i holds a known value on a plane when bit i of its known mask is set,
+* the value bit of an unknown lane is kept 0. Zero, One, D and DBar are
+* known on both planes, X is unknown on both.
+*/
+struct PackedValue
+{
+    // Value in the good machine
+    uint64_t good;
+    // Lanes with a known good value
+    uint64_t goodKnown;
+    // Value in the faulty machine
+    uint64_t faulty;
+    // Lanes with a known faulty value
+    uint64_t faultyKnown;
+};
+
+/*
+* Function to get the packed value with X on all lanes
+* @return PackedValue -> all lanes unknown
+*/
+inline PackedValue get_packed_x()
+{
+    return { 0, 0, 0, 0 };
+}
+
+/*
+* Function to set the value of one lane
+* @param packedValue -> value to update (updated in place)
+* @param lane -> lane to set
+* @param inValue -> logic value of the lane
+*/
+inline void set_packed_lane(PackedValue& packedValue, int lane, logicValue inValue)
+{
+    uint64_t laneBit = (uint64_t)1 << lane;
+    packedValue.good &= ~laneBit;
+    packedValue.goodKnown &= ~laneBit;
+    packedValue.faulty &= ~laneBit;
+    packedValue.faultyKnown &= ~laneBit;
+    if (inValue == X)
+    {
+        return;
+    }
+    packedValue.goodKnown |= laneBit;
+    packedValue.faultyKnown |= laneBit;
+    if (inValue == One || inValue == D)
+    {
+        packedValue.good |= laneBit;
+    }
+    if (inValue == One || inValue == DBar)
+    {
+        packedValue.faulty |= laneBit;
+    }
+}
+
+/*
+* Function to get the value of one lane
+* @param packedValue -> value to read
+* @param lane -> lane to get
+* @return logicValue -> logic value of the lane
+*/
+inline logicValue get_packed_lane(const PackedValue& packedValue, int lane)
+{
+    if (((packedValue.goodKnown & packedValue.faultyKnown) >> lane & 1) == 0)
+    {
+        return X;
+    }
+    bool goodBit = (packedValue.good >> lane) & 1;
+    bool faultyBit = (packedValue.faulty >> lane) & 1;
+    if (goodBit == faultyBit)
+    {
+        return goodBit ? One : Zero;
+    }
+    return goodBit ? D : DBar;
+}
+
+/*
+* Function to get the lanes with X
+* @param packedValue -> value to check
+* @return uint64_t -> mask of the unknown lanes
+*/
+inline uint64_t get_x_lanes(const PackedValue& packedValue)
+{
+    return ~(packedValue.goodKnown & packedValue.faultyKnown);
+}
+
+/*
+* Function to get the lanes with a fault effect (D or DBar)
+* @param packedValue -> value to check
+* @return uint64_t -> mask of the lanes with D or DBar
+*/
+inline uint64_t get_fault_effect_lanes(const PackedValue& packedValue)
+{
+    return packedValue.goodKnown & packedValue.faultyKnown & (packedValue.good ^ packedValue.faulty);
+}
+
+/*
+* Function to invert all lanes, packed form of get_not_value
+* @param inValue -> value to invert
+* @return PackedValue -> inverted value, X lanes stay X
+*/
+inline PackedValue get_packed_not(const PackedValue& inValue)
+{
+    return { inValue.goodKnown & ~inValue.good, inValue.goodKnown,
+        inValue.faultyKnown & ~inValue.faulty, inValue.faultyKnown };
+}
+
+/*
+* Function to evaluate a gate on all lanes, packed form of Gate::simulate without the fault
+* Each plane is evaluated with 3-valued logic, a lane is then known only if known
+* on both planes so that the result matches the 5-valued truth tables
+* @param logic -> logic of the gate
+* @param input1Value -> value of input1
+* @param input2Value -> value of input2 (ignored by single input gates)
+* @return PackedValue -> value of the output
+*/
+inline PackedValue simulate_packed(gateLogic logic, const PackedValue& input1Value, const PackedValue& input2Value)
+{
+    PackedValue outValue = get_packed_x();
+    switch (logic)
+    {
+    case(and_l):
+    case(nand_l):
+        // known 0 on any input, or known 1 on both
+        outValue.good = input1Value.good & input2Value.good;
+        outValue.goodKnown = (input1Value.goodKnown & ~input1Value.good) |
+            (input2Value.goodKnown & ~input2Value.good) | outValue.good;
+        outValue.faulty = input1Value.faulty & input2Value.faulty;
+        outValue.faultyKnown = (input1Value.faultyKnown & ~input1Value.faulty) |
+            (input2Value.faultyKnown & ~input2Value.faulty) | outValue.faulty;
+        break;
+    case(or_l):
+    case(nor_l):
+        // known 1 on any input, or known 0 on both
+        outValue.good = input1Value.good | input2Value.good;
+        outValue.goodKnown = (input1Value.goodKnown & input2Value.goodKnown) | outValue.good;
+        outValue.faulty = input1Value.faulty | input2Value.faulty;
+        outValue.faultyKnown = (input1Value.faultyKnown & input2Value.faultyKnown) | outValue.faulty;
+        break;
+    case(xor_l):
+    case(xnor_l):
+        outValue.goodKnown = input1Value.goodKnown & input2Value.goodKnown;
+        outValue.good = (input1Value.good ^ input2Value.good) & outValue.goodKnown;
+        outValue.faultyKnown = input1Value.faultyKnown & input2Value.faultyKnown;
+        outValue.faulty = (input1Value.faulty ^ input2Value.faulty) & outValue.faultyKnown;
+        break;
+    case(not_l):
+    case(buf_l):
+        outValue = input1Value;
+        break;
+    default:
+        return get_packed_x();
+    }
+    if (logic == nand_l || logic == nor_l || logic == xnor_l || logic == not_l)
+    {
+        outValue = get_packed_not(outValue);
+    }
+
+    // 5-valued logic keeps a lane only if it is known on both planes
+    uint64_t knownLanes = outValue.goodKnown & outValue.faultyKnown;
+    return { outValue.good & knownLanes, knownLanes, outValue.faulty & knownLanes, knownLanes };
+}
+
+#endif
@@ -0,0 +1,260 @@
+#include <iostream>
+#include <unordered_set>
+#include <algorithm>
+#include "SatAtpg.h"
+
+/*
+* Constructor for the class
+* @param inCkt -> circuit read from netlist (levelized)
+*/
+SatAtpg::SatAtpg(Circuit* inCkt) : ckt(inCkt), numConflicts(0)
+{
+}
+
+/*
+* Function to find the fault cone and the good machine cone of the fault
+*/
+void SatAtpg::find_cones()
+{
+    this->coneInputs.clear();
+    this->coneGates.clear();
+    this->faultConeGates.clear();
+    this->faultConeOutputs.clear();
+
+    // Fault cone: gates reached from the fault site, in topological order
+    std::unordered_set<int> faultCone = { this->ckt->faultNodeName };
+    for (Gate* gate : this->ckt->levelizedGates)
+    {
+        if (faultCone.count(gate->input1->name) || (gate->is_single_input() == false && faultCone.count(gate->input2->name)))
+        {
+            faultCone.insert(gate->output->name);
+            this->faultConeGates.push_back(gate);
+        }
+    }
+    for (int nodeName : this->ckt->outputNodes)
+    {
+        if (faultCone.count(nodeName))
+        {
+            this->faultConeOutputs.push_back(nodeName);
+        }
+    }
+
+    // Good machine cone: fanin of the reachable outputs and of the fault site (for activation)
+    std::unordered_set<int> goodCone(this->faultConeOutputs.begin(), this->faultConeOutputs.end());
+    goodCone.insert(this->ckt->faultNodeName);
+    for (auto gateItr = this->ckt->levelizedGates.rbegin(); gateItr != this->ckt->levelizedGates.rend(); ++gateItr)
+    {
+        if (goodCone.count((*gateItr)->output->name))
+        {
+            goodCone.insert((*gateItr)->input1->name);
+            if ((*gateItr)->is_single_input() == false)
+            {
+                goodCone.insert((*gateItr)->input2->name);
+            }
+            this->coneGates.push_back(*gateItr);
+        }
+    }
+    std::reverse(this->coneGates.begin(), this->coneGates.end());
+    for (int nodeName : this->ckt->inputNodes)
+    {
+        if (goodCone.count(nodeName))
+        {
+            this->coneInputs.push_back(nodeName);
+        }
+    }
+
+    // Fault cone gates that reach no output cannot help the detection
+    this->faultConeGates.erase(std::remove_if(this->faultConeGates.begin(), this->faultConeGates.end(),
+        [&goodCone](Gate* gate) { return goodCone.count(gate->output->name) == 0; }), this->faultConeGates.end());
+}
+
+/*
+* Function to add the clauses of a gate, output <=> logic(input1, input2)
+* @param solver -> solver to add the clauses to
+* @param logic -> logic of the gate
+* @param outputVariable -> variable of the output
+* @param input1Variable -> variable of input1
+* @param input2Variable -> variable of input2 (ignored by single input gates)
+*/
+void SatAtpg::add_gate_clauses(SatSolver& solver, gateLogic logic, int outputVariable, int input1Variable, int input2Variable)
+{
+    // Inverting gates are encoded as their base logic on the negated output
+    bool isInverting = (logic == nand_l || logic == nor_l || logic == xnor_l || logic == not_l);
+    int output = get_literal(outputVariable, isInverting);
+    int notOutput = get_negated_literal(output);
+    int input1 = get_literal(input1Variable, false);
+    int notInput1 = get_negated_literal(input1);
+    int input2 = get_literal(input2Variable, false);
+    int notInput2 = get_negated_literal(input2);
+    switch (logic)
+    {
+    case(and_l):
+    case(nand_l):
+        solver.add_clause({ notOutput, input1 });
+        solver.add_clause({ notOutput, input2 });
+        solver.add_clause({ output, notInput1, notInput2 });
+        break;
+    case(or_l):
+    case(nor_l):
+        solver.add_clause({ output, notInput1 });
+        solver.add_clause({ output, notInput2 });
+        solver.add_clause({ notOutput, input1, input2 });
+        break;
+    case(xor_l):
+    case(xnor_l):
+        solver.add_clause({ notOutput, input1, input2 });
+        solver.add_clause({ notOutput, notInput1, notInput2 });
+        solver.add_clause({ output, notInput1, input2 });
+        solver.add_clause({ output, input1, notInput2 });
+        break;
+    case(buf_l):
+    case(not_l):
+        solver.add_clause({ notOutput, input1 });
+        solver.add_clause({ output, notInput1 });
+        break;
+    default:
+        std::cerr << "Dev Error: Unknown gate logic in SAT encoding\n";
+        break;
+    }
+}
+
+/*
+* Function to encode the miter of the fault
+* @param solver -> solver to add the variables and clauses to
+*/
+void SatAtpg::build_miter(SatSolver& solver)
+{
+    this->goodVariables.clear();
+    this->faultyVariables.clear();
+    this->differenceVariables.clear();
+
+    // Good machine
+    for (int nodeName : this->coneInputs)
+    {
+        this->goodVariables[nodeName] = solver.new_variable();
+    }
+    for (Gate* gate : this->coneGates)
+    {
+        int outputVariable = solver.new_variable();
+        this->goodVariables[gate->output->name] = outputVariable;
+        int input1Variable = this->goodVariables[gate->input1->name];
+        this->add_gate_clauses(solver, gate->get_gate_logic(), outputVariable, input1Variable,
+            gate->is_single_input() ? input1Variable : this->goodVariables[gate->input2->name]);
+    }
+
+    // Faulty machine, nodes outside the fault cone share the good machine variable
+    int faultNodeName = this->ckt->faultNodeName;
+    bool isStuckAt1 = this->ckt->node_map[faultNodeName]->is_stuck_at_1;
+    this->faultyVariables[faultNodeName] = solver.new_variable();
+    solver.add_clause({ get_literal(this->faultyVariables[faultNodeName], isStuckAt1 == false) });
+    solver.add_clause({ get_literal(this->goodVariables[faultNodeName], isStuckAt1) });
+    auto get_faulty_variable = [this](Node* inNode)
+    {
+        auto variableItr = this->faultyVariables.find(inNode->name);
+        return (variableItr == this->faultyVariables.end()) ? this->goodVariables[inNode->name] : variableItr->second;
+    };
+    std::vector<int> faultConeNodes(1, faultNodeName);
+    for (Gate* gate : this->faultConeGates)
+    {
+        int outputVariable = solver.new_variable();
+        this->faultyVariables[gate->output->name] = outputVariable;
+        faultConeNodes.push_back(gate->output->name);
+        int input1Variable = get_faulty_variable(gate->input1);
+        this->add_gate_clauses(solver, gate->get_gate_logic(), outputVariable, input1Variable,
+            gate->is_single_input() ? input1Variable : get_faulty_variable(gate->input2));
+    }
+
+    // Difference => good and faulty values differ
+    for (int nodeName : faultConeNodes)
+    {
+        int differenceVariable = solver.new_variable();
+        this->differenceVariables[nodeName] = differenceVariable;
+        int goodVariable = this->goodVariables[nodeName];
+        int faultyVariable = this->faultyVariables[nodeName];
+        solver.add_clause({ get_literal(differenceVariable, true), get_literal(goodVariable, false), get_literal(faultyVariable, false) });
+        solver.add_clause({ get_literal(differenceVariable, true), get_literal(goodVariable, true), get_literal(faultyVariable, true) });
+    }
+    solver.add_clause({ get_literal(this->differenceVariables[faultNodeName], false) });
+
+    // D-chain: the difference of a node continues on the output of one of its fanout gates
+    for (int nodeName : faultConeNodes)
+    {
+        if (this->ckt->node_map[nodeName]->isPrimaryOutput)
+        {
+            continue;
+        }
+        std::vector<int> chainClause(1, get_literal(this->differenceVariables[nodeName], true));
+        for (Gate* gate : this->ckt->node_to_gate_map[nodeName])
+        {
+            auto variableItr = this->differenceVariables.find(gate->output->name);
+            if (variableItr != this->differenceVariables.end())
+            {
+                chainClause.push_back(get_literal(variableItr->second, false));
+            }
+        }
+        solver.add_clause(chainClause);
+    }
+
+    // Fault detected on at least one output (no clause literal if the fault reaches none)
+    std::vector<int> detectionClause;
+    for (int nodeName : this->faultConeOutputs)
+    {
+        detectionClause.push_back(get_literal(this->differenceVariables[nodeName], false));
+    }
+    solver.add_clause(detectionClause);
+
+    // Primary inputs assigned in the circuit keep their good value
+    for (int nodeName : this->coneInputs)
+    {
+        logicValue inputValue = this->ckt->node_map[nodeName]->value;
+        if (inputValue != X)
+        {
+            bool isOne = (inputValue == One || inputValue == D);
+            solver.add_clause({ get_literal(this->goodVariables[nodeName], isOne == false) });
+        }
+    }
+}
+
+/*
+* Function to run SAT based test generation for the fault of the circuit
+* The test found is applied to the circuit: the primary inputs of the model are
+* assigned as decisions until the fault is detected, the rest are left X
+* @return bool -> if a test was found, else the fault is redundant or aborted (ckt->podemAborted)
+*/
+bool SatAtpg::run()
+{
+    this->find_cones();
+    SatSolver solver;
+    this->build_miter(solver);
+    satResult result = solver.solve(this->ckt->podemLimits.maxSatConflicts);
+    this->numConflicts = solver.numConflicts;
+    this->ckt->podemAborted = (result == Unknown);
+    if (result != Satisfiable)
+    {
+        return false;
+    }
+
+    for (int nodeName : this->coneInputs)
+    {
+        if (this->ckt->is_fault_detected())
+        {
+            return true;
+        }
+        if (this->ckt->node_map[nodeName]->value != X)
+        {
+            continue;
+        }
+        logicValue inputValue = solver.get_model_value(this->goodVariables[nodeName]) ? One : Zero;
+        if (this->ckt->push_decision(nodeName, inputValue) == false)
+        {
+            break;
+        }
+    }
+    if (this->ckt->is_fault_detected())
+    {
+        return true;
+    }
+    std::cerr << "Dev Error: SAT model does not detect the fault " << this->ckt->faultNodeName << "\n";
+    this->ckt->podemAborted = true;
+    return false;
+}
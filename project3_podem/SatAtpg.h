@@ -0,0 +1,85 @@
+#ifndef __SATATPG_H__
+#define __SATATPG_H__
+
+#include <vector>
+#include <unordered_map>
+
+#include "Circuit.h"
+#include "SatSolver.h"
+
+/*
+* Class for SAT based test generation of the fault of the circuit
+* The fault is encoded as a miter in CNF (Tseitin encoding of every gate):
+* 1. Good machine variables for the fanin cone of the outputs the fault can reach
+* 2. Faulty machine variables for the fanout cone of the fault, the fault site
+*    is fixed to its stuck value and the good value to the opposite one
+* 3. A difference variable per fanout cone node, true only if the good and
+*    faulty values differ, at least one output has a difference
+* 4. D-chain: a node with a difference that is not an output passes it on to
+*    one of its fanout gates, which prunes paths blocked for the fault effect
+* The primary inputs already assigned in the circuit are kept. A model gives
+* the test, no model proves the fault redundant (under the assigned inputs).
+*/
+class SatAtpg
+{
+public:
+    // Circuit to generate tests on
+    Circuit* ckt;
+
+    // Variables per node name in the good machine, faulty machine and of the difference
+    std::unordered_map<int, int> goodVariables;
+    std::unordered_map<int, int> faultyVariables;
+    std::unordered_map<int, int> differenceVariables;
+
+    // Primary inputs of the good machine cone
+    std::vector<int> coneInputs;
+
+    // Gates of the good machine cone in topological order
+    std::vector<Gate*> coneGates;
+
+    // Gates of the fault cone in topological order
+    std::vector<Gate*> faultConeGates;
+
+    // Outputs the fault can reach
+    std::vector<int> faultConeOutputs;
+
+    // Conflicts of the last run
+    long long numConflicts;
+
+    /*
+    * Constructor for the class
+    * @param inCkt -> circuit read from netlist (levelized)
+    */
+    SatAtpg(Circuit* inCkt);
+
+    /*
+    * Function to find the fault cone and the good machine cone of the fault
+    */
+    void find_cones();
+
+    /*
+    * Function to add the clauses of a gate, output <=> logic(input1, input2)
+    * @param solver -> solver to add the clauses to
+    * @param logic -> logic of the gate
+    * @param outputVariable -> variable of the output
+    * @param input1Variable -> variable of input1
+    * @param input2Variable -> variable of input2 (ignored by single input gates)
+    */
+    void add_gate_clauses(SatSolver& solver, gateLogic logic, int outputVariable, int input1Variable, int input2Variable);
+
+    /*
+    * Function to encode the miter of the fault
+    * @param solver -> solver to add the variables and clauses to
+    */
+    void build_miter(SatSolver& solver);
+
+    /*
+    * Function to run SAT based test generation for the fault of the circuit
+    * The test found is applied to the circuit: the primary inputs of the model are
+    * assigned as decisions until the fault is detected, the rest are left X
+    * @return bool -> if a test was found, else the fault is redundant or aborted (ckt->podemAborted)
+    */
+    bool run();
+};
+
+#endif
@@ -0,0 +1,656 @@
+#include <algorithm>
+#include "SatSolver.h"
+
+// Decay of the variable activities per conflict
+const double variableDecay = 0.95;
+
+// Decay of the learnt clause activities per conflict
+const double clauseDecay = 0.999;
+
+// Conflicts of the first restart interval, scaled by the Luby sequence
+const long long restartBase = 100;
+
+// Learnt clause limit at the start, and its growth per reduction
+const double minLearnts = 2000;
+const double learntGrowth = 1.1;
+
+/*
+* Function to get the element of the Luby sequence (1, 1, 2, 1, 1, 2, 4, ...)
+* @param index -> index in the sequence, from 0
+* @return long long -> element of the sequence
+*/
+long long get_luby(long long index)
+{
+    // find the complete subsequence holding the index, of size 2^(seq+1) - 1
+    long long size = 1;
+    int seq = 0;
+    while (size < index + 1)
+    {
+        ++seq;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != index)
+    {
+        size = (size - 1) >> 1;
+        --seq;
+        index = index % size;
+    }
+    return 1LL << seq;
+}
+
+/*
+* Constructor for the class
+*/
+SatSolver::SatSolver() : propagationHead(0), activityIncrement(1), clauseActivityIncrement(1),
+    maxLearnts(0), numLearnts(0), isUnsat(false), numConflicts(0), numDecisions(0), numPropagations(0)
+{
+}
+
+/*
+* Function to add a new variable
+* @return int -> index of the variable
+*/
+int SatSolver::new_variable()
+{
+    int variable = this->assignments.size();
+    this->watches.resize(2 * (variable + 1));
+    this->assignments.push_back(-1);
+    this->levels.push_back(0);
+    this->reasons.push_back(-1);
+    this->savedPhases.push_back(0);
+    this->activities.push_back(0);
+    this->heapPositions.push_back(-1);
+    this->seen.push_back(false);
+    this->heap_insert(variable);
+    return variable;
+}
+
+/*
+* Function to get the value of a literal
+* @param literal -> literal to check
+* @return int -> -1 unassigned, 0 false, 1 true
+*/
+int SatSolver::get_literal_value(int literal)
+{
+    int value = this->assignments[literal >> 1];
+    return (value == -1) ? -1 : (value ^ (literal & 1));
+}
+
+/*
+* Function to get the current decision level
+* @return int -> number of decisions on the trail
+*/
+int SatSolver::get_decision_level()
+{
+    return this->trailLimits.size();
+}
+
+/*
+* Function to add a clause before solving
+* Literals false at level 0 and duplicate literals are removed
+* @param literals -> literals of the clause
+* @return bool -> if the clauses can still be satisfied
+*/
+bool SatSolver::add_clause(std::vector<int> literals)
+{
+    if (this->isUnsat)
+    {
+        return false;
+    }
+    std::sort(literals.begin(), literals.end());
+    literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+    std::vector<int> clauseLiterals;
+    for (unsigned int i = 0; i < literals.size(); ++i)
+    {
+        // a literal and its negation (adjacent once sorted), or a true literal, satisfy the clause
+        if ((i + 1 < literals.size() && literals[i + 1] == get_negated_literal(literals[i])) ||
+            this->get_literal_value(literals[i]) == 1)
+        {
+            return true;
+        }
+        if (this->get_literal_value(literals[i]) == -1)
+        {
+            clauseLiterals.push_back(literals[i]);
+        }
+    }
+
+    if (clauseLiterals.empty())
+    {
+        this->isUnsat = true;
+        return false;
+    }
+    if (clauseLiterals.size() == 1)
+    {
+        this->enqueue(clauseLiterals[0], -1);
+        if (this->propagate() != -1)
+        {
+            this->isUnsat = true;
+            return false;
+        }
+        return true;
+    }
+    this->clauses.push_back({ clauseLiterals, false, 0 });
+    this->attach_clause(this->clauses.size() - 1);
+    return true;
+}
+
+/*
+* Function to assign a literal true
+* @param literal -> literal to assign
+* @param reason -> clause implying it (-1 for decisions and level 0 units)
+*/
+void SatSolver::enqueue(int literal, int reason)
+{
+    int variable = literal >> 1;
+    this->assignments[variable] = (literal & 1) ? 0 : 1;
+    this->levels[variable] = this->get_decision_level();
+    this->reasons[variable] = reason;
+    this->trail.push_back(literal);
+}
+
+/*
+* Function to attach a clause to the watch lists of its first two literals
+* @param clauseIndex -> clause to watch
+*/
+void SatSolver::attach_clause(int clauseIndex)
+{
+    const std::vector<int>& literals = this->clauses[clauseIndex].literals;
+    this->watches[literals[0]].push_back(clauseIndex);
+    this->watches[literals[1]].push_back(clauseIndex);
+}
+
+/*
+* Function to propagate the assigned literals with the watched literals
+* @return int -> index of a falsified clause, -1 if no conflict
+*/
+int SatSolver::propagate()
+{
+    while (this->propagationHead < this->trail.size())
+    {
+        int falseLiteral = get_negated_literal(this->trail[this->propagationHead++]);
+        ++this->numPropagations;
+
+        // Clauses keep watching the false literal only if no other literal can be watched
+        std::vector<int>& watchList = this->watches[falseLiteral];
+        unsigned int numKept = 0;
+        for (unsigned int i = 0; i < watchList.size(); ++i)
+        {
+            int clauseIndex = watchList[i];
+            std::vector<int>& literals = this->clauses[clauseIndex].literals;
+            if (literals[0] == falseLiteral)
+            {
+                std::swap(literals[0], literals[1]);
+            }
+            if (this->get_literal_value(literals[0]) == 1)
+            {
+                // satisfied by the other watched literal
+                watchList[numKept++] = clauseIndex;
+                continue;
+            }
+
+            bool isNewWatch = false;
+            for (unsigned int k = 2; k < literals.size(); ++k)
+            {
+                if (this->get_literal_value(literals[k]) != 0)
+                {
+                    std::swap(literals[1], literals[k]);
+                    this->watches[literals[1]].push_back(clauseIndex);
+                    isNewWatch = true;
+                    break;
+                }
+            }
+            if (isNewWatch)
+            {
+                continue;
+            }
+
+            watchList[numKept++] = clauseIndex;
+            if (this->get_literal_value(literals[0]) == 0)
+            {
+                // all literals false, keep the rest of the watch list as is
+                for (++i; i < watchList.size(); ++i)
+                {
+                    watchList[numKept++] = watchList[i];
+                }
+                watchList.resize(numKept);
+                this->propagationHead = this->trail.size();
+                return clauseIndex;
+            }
+            // unit clause, the first literal is implied
+            this->enqueue(literals[0], clauseIndex);
+        }
+        watchList.resize(numKept);
+    }
+    return -1;
+}
+
+/*
+* Function to learn a clause from a conflict
+* The learnt clause is asserting: its first literal is the only one of the conflict level
+* @param conflictClause -> index of the falsified clause
+* @param learntClause -> learnt clause (updated in place)
+* @return int -> decision level to jump back to
+*/
+int SatSolver::analyze(int conflictClause, std::vector<int>& learntClause)
+{
+    learntClause.assign(1, -1);
+    int numOpenPaths = 0;
+    int literal = -1;
+    int trailIndex = this->trail.size() - 1;
+    int clauseIndex = conflictClause;
+
+    // Resolve the conflict with the reasons of the conflict level, latest first,
+    // until a single literal of the conflict level is left (first UIP)
+    do
+    {
+        if (this->clauses[clauseIndex].isLearnt)
+        {
+            this->bump_clause(clauseIndex);
+        }
+        const std::vector<int>& literals = this->clauses[clauseIndex].literals;
+        // the first literal of a reason is the implied literal itself
+        for (unsigned int k = (literal == -1) ? 0 : 1; k < literals.size(); ++k)
+        {
+            int variable = literals[k] >> 1;
+            if (this->seen[variable] || this->levels[variable] == 0)
+            {
+                continue;
+            }
+            this->seen[variable] = true;
+            this->bump_variable(variable);
+            if (this->levels[variable] >= this->get_decision_level())
+            {
+                ++numOpenPaths;
+            }
+            else
+            {
+                learntClause.push_back(literals[k]);
+            }
+        }
+        while (this->seen[this->trail[trailIndex] >> 1] == false)
+        {
+            --trailIndex;
+        }
+        literal = this->trail[trailIndex--];
+        clauseIndex = this->reasons[literal >> 1];
+        this->seen[literal >> 1] = false;
+        --numOpenPaths;
+    } while (numOpenPaths > 0);
+    learntClause[0] = get_negated_literal(literal);
+
+    // Drop the literals implied by the other literals of the clause
+    std::vector<int> analyzedLiterals(learntClause);
+    unsigned int numKept = 1;
+    for (unsigned int i = 1; i < learntClause.size(); ++i)
+    {
+        if (this->reasons[learntClause[i] >> 1] == -1 || this->is_redundant_literal(learntClause[i]) == false)
+        {
+            learntClause[numKept++] = learntClause[i];
+        }
+    }
+    learntClause.resize(numKept);
+    for (int analyzedLiteral : analyzedLiterals)
+    {
+        this->seen[analyzedLiteral >> 1] = false;
+    }
+
+    if (learntClause.size() == 1)
+    {
+        return 0;
+    }
+    // The literal of the highest level is watched with the asserting literal
+    unsigned int maxIndex = 1;
+    for (unsigned int i = 2; i < learntClause.size(); ++i)
+    {
+        if (this->levels[learntClause[i] >> 1] > this->levels[learntClause[maxIndex] >> 1])
+        {
+            maxIndex = i;
+        }
+    }
+    std::swap(learntClause[1], learntClause[maxIndex]);
+    return this->levels[learntClause[1] >> 1];
+}
+
+/*
+* Function to check if a literal of a learnt clause is implied by the other literals
+* @param literal -> literal to check
+* @return bool -> if all literals of its reason are in the clause or at level 0
+*/
+bool SatSolver::is_redundant_literal(int literal)
+{
+    const std::vector<int>& literals = this->clauses[this->reasons[literal >> 1]].literals;
+    for (unsigned int k = 1; k < literals.size(); ++k)
+    {
+        int variable = literals[k] >> 1;
+        if (this->seen[variable] == false && this->levels[variable] > 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+* Function to undo the assignments above a decision level
+* @param level -> decision level to go back to
+*/
+void SatSolver::cancel_until(int level)
+{
+    if (this->get_decision_level() <= level)
+    {
+        return;
+    }
+    for (int i = this->trail.size() - 1; i >= this->trailLimits[level]; --i)
+    {
+        int variable = this->trail[i] >> 1;
+        this->savedPhases[variable] = this->assignments[variable];
+        this->assignments[variable] = -1;
+        this->reasons[variable] = -1;
+        this->heap_insert(variable);
+    }
+    this->trail.resize(this->trailLimits[level]);
+    this->trailLimits.resize(level);
+    this->propagationHead = this->trail.size();
+}
+
+/*
+* Function to bump the activity of a variable
+* @param variable -> variable in a conflict
+*/
+void SatSolver::bump_variable(int variable)
+{
+    this->activities[variable] += this->activityIncrement;
+    if (this->activities[variable] > 1e100)
+    {
+        // rescale before the activities overflow
+        for (double& activity : this->activities)
+        {
+            activity *= 1e-100;
+        }
+        this->activityIncrement *= 1e-100;
+    }
+    if (this->heapPositions[variable] != -1)
+    {
+        this->heap_sift_up(this->heapPositions[variable]);
+    }
+}
+
+/*
+* Function to bump the activity of a learnt clause
+* @param clauseIndex -> learnt clause in a conflict
+*/
+void SatSolver::bump_clause(int clauseIndex)
+{
+    this->clauses[clauseIndex].activity += this->clauseActivityIncrement;
+    if (this->clauses[clauseIndex].activity > 1e20)
+    {
+        for (SatClause& clause : this->clauses)
+        {
+            clause.activity *= 1e-20;
+        }
+        this->clauseActivityIncrement *= 1e-20;
+    }
+}
+
+/*
+* Function to remove half of the learnt clauses, those with lowest activity
+* Called at level 0 where no clause is the reason of an assignment
+*/
+void SatSolver::reduce_learnts()
+{
+    // Binary learnt clauses are cheap and kept
+    std::vector<int> learntIndices;
+    for (unsigned int i = 0; i < this->clauses.size(); ++i)
+    {
+        if (this->clauses[i].isLearnt && this->clauses[i].literals.size() > 2)
+        {
+            learntIndices.push_back(i);
+        }
+    }
+    std::sort(learntIndices.begin(), learntIndices.end(), [this](int index1, int index2)
+        { return this->clauses[index1].activity < this->clauses[index2].activity; });
+    std::vector<bool> isRemoved(this->clauses.size(), false);
+    for (unsigned int i = 0; i < learntIndices.size() / 2; ++i)
+    {
+        isRemoved[learntIndices[i]] = true;
+    }
+
+    // Level 0 is propagated: a clause is satisfied there or keeps two unassigned literals
+    // after its false literals are dropped, so the watches can be rebuilt from scratch
+    std::vector<SatClause> keptClauses;
+    this->numLearnts = 0;
+    for (unsigned int i = 0; i < this->clauses.size(); ++i)
+    {
+        if (isRemoved[i])
+        {
+            continue;
+        }
+        SatClause& clause = this->clauses[i];
+        std::vector<int> literals;
+        bool isSatisfied = false;
+        for (int literal : clause.literals)
+        {
+            int value = this->get_literal_value(literal);
+            isSatisfied = isSatisfied || (value == 1);
+            if (value == -1)
+            {
+                literals.push_back(literal);
+            }
+        }
+        if (isSatisfied)
+        {
+            continue;
+        }
+        clause.literals.swap(literals);
+        this->numLearnts += clause.isLearnt ? 1 : 0;
+        keptClauses.push_back(clause);
+    }
+    this->clauses.swap(keptClauses);
+    std::fill(this->reasons.begin(), this->reasons.end(), -1);
+    for (std::vector<int>& watchList : this->watches)
+    {
+        watchList.clear();
+    }
+    for (unsigned int i = 0; i < this->clauses.size(); ++i)
+    {
+        this->attach_clause(i);
+    }
+}
+
+/*
+* Function to pick the next decision literal
+* @return int -> literal to assign, -1 if all variables are assigned
+*/
+int SatSolver::pick_decision_literal()
+{
+    while (this->heap.empty() == false)
+    {
+        int variable = this->heap_pop();
+        if (this->assignments[variable] == -1)
+        {
+            // the value the variable had last, false at first
+            return get_literal(variable, this->savedPhases[variable] != 1);
+        }
+    }
+    return -1;
+}
+
+/*
+* Function to solve the clauses
+* @param maxConflicts -> conflicts before the run stops with Unknown (0 => no limit)
+* @return satResult -> result of the run, the model is kept if Satisfiable
+*/
+satResult SatSolver::solve(long long maxConflicts)
+{
+    if (this->isUnsat || this->propagate() != -1)
+    {
+        this->isUnsat = true;
+        return Unsatisfiable;
+    }
+    this->maxLearnts = std::max(this->maxLearnts, std::max(this->clauses.size() / 3.0, minLearnts));
+
+    long long numRunConflicts = 0;
+    long long numRestartConflicts = 0;
+    long long restartIndex = 0;
+    std::vector<int> learntClause;
+    while (true)
+    {
+        int conflictClause = this->propagate();
+        if (conflictClause != -1)
+        {
+            ++this->numConflicts;
+            ++numRunConflicts;
+            ++numRestartConflicts;
+            if (this->get_decision_level() == 0)
+            {
+                // conflict without decisions
+                this->isUnsat = true;
+                return Unsatisfiable;
+            }
+            this->cancel_until(this->analyze(conflictClause, learntClause));
+            if (learntClause.size() == 1)
+            {
+                this->enqueue(learntClause[0], -1);
+            }
+            else
+            {
+                this->clauses.push_back({ learntClause, true, 0 });
+                int clauseIndex = this->clauses.size() - 1;
+                this->attach_clause(clauseIndex);
+                this->bump_clause(clauseIndex);
+                ++this->numLearnts;
+                this->enqueue(learntClause[0], clauseIndex);
+            }
+            this->activityIncrement /= variableDecay;
+            this->clauseActivityIncrement /= clauseDecay;
+            if (maxConflicts > 0 && numRunConflicts >= maxConflicts)
+            {
+                this->cancel_until(0);
+                return Unknown;
+            }
+            continue;
+        }
+
+        if (numRestartConflicts >= restartBase * get_luby(restartIndex))
+        {
+            numRestartConflicts = 0;
+            ++restartIndex;
+            this->cancel_until(0);
+            if (this->numLearnts >= this->maxLearnts)
+            {
+                this->reduce_learnts();
+                this->maxLearnts *= learntGrowth;
+            }
+            continue;
+        }
+
+        int decisionLiteral = this->pick_decision_literal();
+        if (decisionLiteral == -1)
+        {
+            // every variable assigned without conflict
+            this->model.assign(this->assignments.size(), false);
+            for (unsigned int i = 0; i < this->assignments.size(); ++i)
+            {
+                this->model[i] = (this->assignments[i] == 1);
+            }
+            this->cancel_until(0);
+            return Satisfiable;
+        }
+        ++this->numDecisions;
+        this->trailLimits.push_back(this->trail.size());
+        this->enqueue(decisionLiteral, -1);
+    }
+}
+
+/*
+* Function to get the value of a variable in the model
+* @param variable -> variable index
+* @return bool -> value of the variable
+*/
+bool SatSolver::get_model_value(int variable)
+{
+    return this->model[variable];
+}
+
+/*
+* Function to insert a variable in the heap
+* @param variable -> variable to insert (ignored if already in)
+*/
+void SatSolver::heap_insert(int variable)
+{
+    if (this->heapPositions[variable] != -1)
+    {
+        return;
+    }
+    this->heapPositions[variable] = this->heap.size();
+    this->heap.push_back(variable);
+    this->heap_sift_up(this->heap.size() - 1);
+}
+
+/*
+* Function to move a heap entry up to its position
+* @param position -> position in the heap
+*/
+void SatSolver::heap_sift_up(int position)
+{
+    int variable = this->heap[position];
+    while (position > 0)
+    {
+        int parent = (position - 1) / 2;
+        if (this->activities[this->heap[parent]] >= this->activities[variable])
+        {
+            break;
+        }
+        this->heap[position] = this->heap[parent];
+        this->heapPositions[this->heap[position]] = position;
+        position = parent;
+    }
+    this->heap[position] = variable;
+    this->heapPositions[variable] = position;
+}
+
+/*
+* Function to move a heap entry down to its position
+* @param position -> position in the heap
+*/
+void SatSolver::heap_sift_down(int position)
+{
+    int variable = this->heap[position];
+    int heapSize = this->heap.size();
+    while (2 * position + 1 < heapSize)
+    {
+        int child = 2 * position + 1;
+        if (child + 1 < heapSize && this->activities[this->heap[child + 1]] > this->activities[this->heap[child]])
+        {
+            ++child;
+        }
+        if (this->activities[this->heap[child]] <= this->activities[variable])
+        {
+            break;
+        }
+        this->heap[position] = this->heap[child];
+        this->heapPositions[this->heap[position]] = position;
+        position = child;
+    }
+    this->heap[position] = variable;
+    this->heapPositions[variable] = position;
+}
+
+/*
+* Function to remove the variable of highest activity from the heap
+* @return int -> variable removed
+*/
+int SatSolver::heap_pop()
+{
+    int variable = this->heap[0];
+    int lastVariable = this->heap.back();
+    this->heap.pop_back();
+    this->heapPositions[variable] = -1;
+    if (this->heap.empty() == false)
+    {
+        this->heap[0] = lastVariable;
+        this->heapPositions[lastVariable] = 0;
+        this->heap_sift_down(0);
+    }
+    return variable;
+}
@@ -0,0 +1,267 @@
+#ifndef __SATSOLVER_H__
+#define __SATSOLVER_H__
+
+#include <vector>
+
+/*
+* Result of a SAT solver run
+*/
+typedef enum satResult
+{
+    Satisfiable,    // a model was found
+    Unsatisfiable,  // no model exists
+    Unknown,        // the conflict limit was reached first
+} satResult;
+
+/*
+* Function to get the literal of a variable
+* @param variable -> variable index
+* @param isNegative -> literal is the negation of the variable
+* @return int -> literal, 2 * variable for the positive and 2 * variable + 1 for the negative literal
+*/
+inline int get_literal(int variable, bool isNegative)
+{
+    return 2 * variable + (isNegative ? 1 : 0);
+}
+
+/*
+* Function to get the negation of a literal
+* @param literal -> literal to negate
+* @return int -> negated literal
+*/
+inline int get_negated_literal(int literal)
+{
+    return literal ^ 1;
+}
+
+/*
+* Clause of the SAT solver
+* The first two literals are watched, a learnt clause keeps its activity
+* so that the least used learnt clauses can be removed
+*/
+struct SatClause
+{
+    std::vector<int> literals;
+    bool isLearnt;
+    double activity;
+};
+
+/*
+* Class for a conflict driven clause learning (CDCL) SAT solver on CNF
+* 1. Unit propagation with two watched literals per clause
+* 2. Decisions on the unassigned variable of highest VSIDS activity, with
+*    the last value of the variable (phase saving)
+* 3. A conflict learns the first unique implication point clause and jumps
+*    back to the second highest level of the clause
+* 4. Restarts follow the Luby sequence, the learnt clause database is
+*    halved on a restart once it outgrows its limit
+*/
+class SatSolver
+{
+public:
+    // Clauses, original and learnt
+    std::vector<SatClause> clauses;
+
+    // Clause indices per literal watched in them, visited when the literal becomes false
+    std::vector<std::vector<int>> watches;
+
+    // Value per variable (-1 unassigned, 0 false, 1 true)
+    std::vector<int> assignments;
+
+    // Decision level per assigned variable
+    std::vector<int> levels;
+
+    // Clause implying the variable (-1 for decisions and level 0 units)
+    std::vector<int> reasons;
+
+    // Last value per variable, the value of its next decision
+    std::vector<int> savedPhases;
+
+    // Assigned literals in assignment order
+    std::vector<int> trail;
+
+    // Trail size at the start of each decision level
+    std::vector<int> trailLimits;
+
+    // Trail position of the next literal to propagate
+    unsigned int propagationHead;
+
+    // VSIDS activity per variable
+    std::vector<double> activities;
+
+    // Activity added to the variables of a conflict, grows to decay older conflicts
+    double activityIncrement;
+
+    // Activity added to the learnt clauses of a conflict
+    double clauseActivityIncrement;
+
+    // Binary max-heap of variables ordered by activity
+    std::vector<int> heap;
+
+    // Position per variable in the heap (-1 if not in it)
+    std::vector<int> heapPositions;
+
+    // Variables seen by the conflict analysis
+    std::vector<bool> seen;
+
+    // Learnt clauses kept before the database is reduced
+    double maxLearnts;
+
+    // Number of learnt clauses in the database
+    int numLearnts;
+
+    // A clause added at level 0 was falsified
+    bool isUnsat;
+
+    // Satisfying value per variable of the last Satisfiable run
+    std::vector<bool> model;
+
+    // Statistics over all runs
+    long long numConflicts;
+    long long numDecisions;
+    long long numPropagations;
+
+    /*
+    * Constructor for the class
+    */
+    SatSolver();
+
+    /*
+    * Function to add a new variable
+    * @return int -> index of the variable
+    */
+    int new_variable();
+
+    /*
+    * Function to add a clause before solving
+    * Literals false at level 0 and duplicate literals are removed
+    * @param literals -> literals of the clause
+    * @return bool -> if the clauses can still be satisfied
+    */
+    bool add_clause(std::vector<int> literals);
+
+    /*
+    * Function to solve the clauses
+    * @param maxConflicts -> conflicts before the run stops with Unknown (0 => no limit)
+    * @return satResult -> result of the run, the model is kept if Satisfiable
+    */
+    satResult solve(long long maxConflicts);
+
+    /*
+    * Function to get the value of a variable in the model
+    * @param variable -> variable index
+    * @return bool -> value of the variable
+    */
+    bool get_model_value(int variable);
+
+    /*
+    * Function to get the value of a literal
+    * @param literal -> literal to check
+    * @return int -> -1 unassigned, 0 false, 1 true
+    */
+    int get_literal_value(int literal);
+
+    /*
+    * Function to get the current decision level
+    * @return int -> number of decisions on the trail
+    */
+    int get_decision_level();
+
+    /*
+    * Function to assign a literal true
+    * @param literal -> literal to assign
+    * @param reason -> clause implying it (-1 for decisions and level 0 units)
+    */
+    void enqueue(int literal, int reason);
+
+    /*
+    * Function to attach a clause to the watch lists of its first two literals
+    * @param clauseIndex -> clause to watch
+    */
+    void attach_clause(int clauseIndex);
+
+    /*
+    * Function to propagate the assigned literals with the watched literals
+    * @return int -> index of a falsified clause, -1 if no conflict
+    */
+    int propagate();
+
+    /*
+    * Function to learn a clause from a conflict
+    * The learnt clause is asserting: its first literal is the only one of the conflict level
+    * @param conflictClause -> index of the falsified clause
+    * @param learntClause -> learnt clause (updated in place)
+    * @return int -> decision level to jump back to
+    */
+    int analyze(int conflictClause, std::vector<int>& learntClause);
+
+    /*
+    * Function to check if a literal of a learnt clause is implied by the other literals
+    * @param literal -> literal to check
+    * @return bool -> if all literals of its reason are in the clause or at level 0
+    */
+    bool is_redundant_literal(int literal);
+
+    /*
+    * Function to undo the assignments above a decision level
+    * @param level -> decision level to go back to
+    */
+    void cancel_until(int level);
+
+    /*
+    * Function to bump the activity of a variable
+    * @param variable -> variable in a conflict
+    */
+    void bump_variable(int variable);
+
+    /*
+    * Function to bump the activity of a learnt clause
+    * @param clauseIndex -> learnt clause in a conflict
+    */
+    void bump_clause(int clauseIndex);
+
+    /*
+    * Function to remove half of the learnt clauses, those with lowest activity
+    * Called at level 0 where no clause is the reason of an assignment
+    */
+    void reduce_learnts();
+
+    /*
+    * Function to pick the next decision literal
+    * @return int -> literal to assign, -1 if all variables are assigned
+    */
+    int pick_decision_literal();
+
+    /*
+    * Function to insert a variable in the heap
+    * @param variable -> variable to insert (ignored if already in)
+    */
+    void heap_insert(int variable);
+
+    /*
+    * Function to move a heap entry up to its position
+    * @param position -> position in the heap
+    */
+    void heap_sift_up(int position);
+
+    /*
+    * Function to move a heap entry down to its position
+    * @param position -> position in the heap
+    */
+    void heap_sift_down(int position);
+
+    /*
+    * Function to remove the variable of highest activity from the heap
+    * @return int -> variable removed
+    */
+    int heap_pop();
+};
+
+/*
+* Function to get the element of the Luby sequence (1, 1, 2, 1, 1, 2, 4, ...)
+* @param index -> index in the sequence, from 0
+* @return long long -> element of the sequence
+*/
+long long get_luby(long long index);
+
+#endif
@@ -0,0 +1,267 @@
+#include <iostream>
+#include <algorithm>
+#include "TestGenerator.h"
+
+// Seed of the random fill of the X inputs
+const unsigned int fillSeed = 1;
+
+/*
+* Constructor for the class
+* @param inCkt -> circuit read from netlist
+* @param inFaultList -> faults to generate tests for
+*/
+TestGenerator::TestGenerator(Circuit* inCkt, const std::vector<std::pair<int, int>>& inFaultList) :
+    ckt(inCkt), simulator(*inCkt), packedImplicator(*inCkt), compactTests(false),
+    fanEngine(inCkt), useFan(false), satAtpg(inCkt), useSat(true), faultList(inFaultList),
+    numPodemCalls(0), numCompactionCalls(0), numSatCalls(0), numBacktracks(0), numSatConflicts(0),
+    fillGenerator(fillSeed)
+{
+    this->faultStates.assign(this->faultList.size(), Undetected);
+    this->detectingVector.assign(this->faultList.size(), -1);
+    this->ckt->printDecisions = false;
+}
+
+/*
+* Function to fill the X inputs of a test cube randomly
+* @param testCube -> value per primary input (1, 0 or X)
+* @return string -> fully specified test vector
+*/
+std::string TestGenerator::fill_test_cube(std::string testCube)
+{
+    for (char& inputValue : testCube)
+    {
+        if (inputValue == 'X')
+        {
+            inputValue = (this->fillGenerator() & 1) ? '1' : '0';
+        }
+    }
+    return testCube;
+}
+
+/*
+* Function to set up the circuit for a target fault, all node values X
+* @param faultPosition -> position of the fault in the fault list
+*/
+void TestGenerator::set_target_fault(int faultPosition)
+{
+    // Reuse the circuit read once, only the node values and the fault change
+    this->ckt->reset_values();
+    this->ckt->faultNodeName = this->faultList[faultPosition].first;
+    if (this->faultList[faultPosition].second == 0)
+    {
+        this->ckt->node_map[this->ckt->faultNodeName]->is_stuck_at_0 = true;
+    }
+    else
+    {
+        this->ckt->node_map[this->ckt->faultNodeName]->is_stuck_at_1 = true;
+    }
+}
+
+/*
+* Function to run the selected test generation engine on the target fault of the circuit
+* The SAT back end takes over if the engine aborts
+* @return bool -> if a test was found, else the fault is redundant or aborted (ckt->podemAborted)
+*/
+bool TestGenerator::run_engine()
+{
+    bool testFound = this->useFan ? this->fanEngine.run() : this->ckt->runPODEM();
+    this->numBacktracks += this->ckt->numBacktracks;
+    if (testFound == false && this->ckt->podemAborted && this->useSat)
+    {
+        // the engine restored the circuit, assigned inputs of a test cube are kept
+        ++this->numSatCalls;
+        testFound = this->satAtpg.run();
+        this->numSatConflicts += this->satAtpg.numConflicts;
+    }
+    return testFound;
+}
+
+/*
+* Function to run PODEM for a secondary fault with the assigned inputs of a test cube kept
+* @param faultPosition -> position of the secondary fault in the fault list
+* @param testCube -> test cube to extend (updated in place if a test was found)
+* @return bool -> if the cube was extended to detect the fault
+*/
+bool TestGenerator::extend_test_cube(int faultPosition, std::string& testCube)
+{
+    this->set_target_fault(faultPosition);
+    for (unsigned int i = 0; i < testCube.size(); ++i)
+    {
+        // assigned inputs are implied before the search, PODEM only decides on X inputs
+        if (testCube[i] != 'X' &&
+            this->ckt->implyPODEM(this->ckt->inputNodes[i], (testCube[i] == '1') ? One : Zero) == false)
+        {
+            return false;
+        }
+    }
+    ++this->numCompactionCalls;
+    if (this->run_engine() == false)
+    {
+        return false;
+    }
+    testCube = this->ckt->get_input_vector_lin();
+    return true;
+}
+
+/*
+* Function to extend a test cube with the undetected faults that can still be detected under it
+* @param faultPosition -> position of the target fault of the cube
+* @param testCube -> test cube to extend (updated in place)
+*/
+void TestGenerator::compact_test_cube(int faultPosition, std::string& testCube)
+{
+    std::vector<int> candidatePositions;
+    for (unsigned int i = 0; i < this->faultList.size(); ++i)
+    {
+        if (this->faultStates[i] == Undetected && (int)i != faultPosition)
+        {
+            candidatePositions.push_back(i);
+        }
+    }
+    for (unsigned int batchStart = 0; batchStart < candidatePositions.size(); batchStart += packedLanes)
+    {
+        if (testCube.find('X') == std::string::npos)
+        {
+            // no input left to assign
+            return;
+        }
+
+        // Imply the cube for one candidate fault per lane
+        unsigned int batchEnd = std::min<size_t>(batchStart + packedLanes, candidatePositions.size());
+        this->packedImplicator.clear();
+        for (unsigned int i = batchStart; i < batchEnd; ++i)
+        {
+            const std::pair<int, int>& fault = this->faultList[candidatePositions[i]];
+            this->packedImplicator.set_fault(i - batchStart, fault.first, fault.second);
+            for (unsigned int j = 0; j < testCube.size(); ++j)
+            {
+                if (testCube[j] != 'X')
+                {
+                    this->packedImplicator.assign_input(i - batchStart, this->ckt->inputNodes[j],
+                        (testCube[j] == '1') ? One : Zero);
+                }
+            }
+        }
+        this->packedImplicator.imply();
+
+        // Faults detected by the cube are dropped by the fault simulation anyway,
+        // faults without a path of X nodes to an output cannot be detected under the cube
+        uint64_t candidateLanes = this->packedImplicator.get_testable_lanes() &
+            ~this->packedImplicator.get_detected_lanes();
+        for (unsigned int i = batchStart; i < batchEnd; ++i)
+        {
+            if ((candidateLanes >> (i - batchStart)) & 1)
+            {
+                this->extend_test_cube(candidatePositions[i], testCube);
+            }
+        }
+    }
+}
+
+/*
+* Function to run PODEM on a fault and drop all faults its test vector detects
+* @param faultPosition -> position of the target fault in the fault list
+* @param numDropped -> faults detected by the test vector, target included (updated in place)
+* @return bool -> if a test vector was generated, else the fault is marked redundant or aborted
+*/
+bool TestGenerator::generate_test(int faultPosition, int& numDropped)
+{
+    numDropped = 0;
+    this->set_target_fault(faultPosition);
+    ++this->numPodemCalls;
+    if (this->run_engine() == false)
+    {
+        this->faultStates[faultPosition] = this->ckt->podemAborted ? Aborted : Redundant;
+        return false;
+    }
+    std::string testCube = this->ckt->get_input_vector_lin();
+    if (this->compactTests)
+    {
+        this->compact_test_cube(faultPosition, testCube);
+    }
+    this->testCubes.push_back(testCube);
+    std::string testVector = this->fill_test_cube(testCube);
+
+    // Fault simulate the vector against the faults left and drop the detected ones
+    // aborted faults are simulated too, a later vector may still detect them
+    std::vector<int> undetectedPositions;
+    std::vector<std::pair<int, int>> undetectedFaults;
+    for (unsigned int i = 0; i < this->faultList.size(); ++i)
+    {
+        if (this->faultStates[i] == Undetected || this->faultStates[i] == Aborted)
+        {
+            undetectedPositions.push_back(i);
+            undetectedFaults.push_back(this->faultList[i]);
+        }
+    }
+    int vectorIndex = this->testVectors.size();
+    this->testVectors.push_back(testVector);
+    for (int position : this->simulator.simulate_test_vector(testVector, undetectedFaults))
+    {
+        this->faultStates[undetectedPositions[position]] = Detected;
+        this->detectingVector[undetectedPositions[position]] = vectorIndex;
+        ++numDropped;
+    }
+    if (this->faultStates[faultPosition] != Detected)
+    {
+        std::cerr << "Dev Error: Test vector " << testVector << " does not detect the target fault "
+            << this->faultList[faultPosition].first << " stuck at " << this->faultList[faultPosition].second << "\n";
+        this->faultStates[faultPosition] = Detected;
+        this->detectingVector[faultPosition] = vectorIndex;
+        ++numDropped;
+    }
+    return true;
+}
+
+/*
+* Function to generate tests until every fault is detected, proven redundant or aborted by PODEM
+* @param printTests -> print the test vector of each targeted fault
+*/
+void TestGenerator::run(bool printTests)
+{
+    for (unsigned int i = 0; i < this->faultList.size(); ++i)
+    {
+        // Faults detected by an earlier test vector are not targeted
+        if (this->faultStates[i] != Undetected)
+        {
+            continue;
+        }
+        int numDropped;
+        bool testGenerated = this->generate_test(i, numDropped);
+        if (printTests == false)
+        {
+            continue;
+        }
+        std::cout << "Node name: " << this->faultList[i].first << ", Stuck at value: "
+            << this->faultList[i].second << " Test Vector: ";
+        if (testGenerated == false && this->faultStates[i] == Aborted)
+        {
+            std::cout << "No test vector generated. Fault aborted after "
+                << this->ckt->numBacktracks << " backtracks";
+            if (this->useSat)
+            {
+                std::cout << " and " << this->satAtpg.numConflicts << " SAT conflicts";
+            }
+            std::cout << "\n";
+        }
+        else if (testGenerated == false)
+        {
+            std::cout << "No test vector generated. Fault is undetectable\n";
+        }
+        else
+        {
+            std::cout << this->testCubes.back() << " Filled: " << this->testVectors.back()
+                << " Faults dropped: " << numDropped << "\n";
+        }
+    }
+}
+
+/*
+* Function to get the faults in a given state
+* @param status -> state to count
+* @return int -> number of faults in the state
+*/
+int TestGenerator::get_num_faults(faultStatus status)
+{
+    return std::count(this->faultStates.begin(), this->faultStates.end(), status);
+}
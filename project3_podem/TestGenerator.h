@@ -0,0 +1,163 @@
+#ifndef __TESTGENERATOR_H__
+#define __TESTGENERATOR_H__
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <random>
+
+#include "Circuit.h"
+#include "FaultSimulator.h"
+#include "PackedImplicator.h"
+#include "FanEngine.h"
+#include "SatAtpg.h"
+
+/*
+* ATPG state of a target fault
+*/
+typedef enum faultStatus
+{
+    Undetected, // no test vector detects the fault yet
+    Detected,   // detected by one of the generated test vectors
+    Redundant,  // PODEM, FAN or the SAT back end proved that no test exists for the fault
+    Aborted,    // reached the effort limits, may still be detected by a later test vector
+} faultStatus;
+
+/*
+* Class for the ATPG flow over a fault list
+* The netlist is read once. Faults are targeted in list order and PODEM (or
+* FAN) is only run on faults no earlier test vector detects: every generated test
+* vector has its X inputs filled randomly and is fault simulated against
+* all undetected and aborted faults, which are dropped when detected.
+* With compaction, the X inputs of a test cube are first used to detect
+* more undetected faults: the faults are screened 64 at a time by packed
+* implication of the cube, and PODEM extends the cube for the ones that
+* can still be detected under it.
+* Faults the engine aborts are handed to the SAT back end, which finds a
+* test or proves them redundant.
+*/
+class TestGenerator
+{
+public:
+    // Circuit PODEM runs on (values reset between target faults)
+    Circuit* ckt;
+
+    // Fault simulator of the same netlist
+    FaultSimulator simulator;
+
+    // Packed implication of the same netlist, screens faults against a test cube
+    PackedImplicator packedImplicator;
+
+    // Extend every test cube with secondary target faults before the X fill
+    bool compactTests;
+
+    // FAN engine on the same circuit
+    FanEngine fanEngine;
+
+    // Generate tests with FAN instead of PODEM
+    bool useFan;
+
+    // SAT back end on the same circuit
+    SatAtpg satAtpg;
+
+    // Run the SAT back end on the faults the engine aborts
+    bool useSat;
+
+    // Faults to cover, pair of entry => first = node name, second = stuck at value
+    std::vector<std::pair<int, int>> faultList;
+
+    // ATPG state per fault
+    std::vector<faultStatus> faultStates;
+
+    // Index of the first test vector detecting the fault (-1 if none)
+    std::vector<int> detectingVector;
+
+    // Generated test vectors, X inputs filled
+    std::vector<std::string> testVectors;
+
+    // Test cube of each test vector, before the X fill
+    std::vector<std::string> testCubes;
+
+    // Number of faults the test generation engine was run on
+    int numPodemCalls;
+
+    // Number of engine runs extending a test cube with a secondary fault
+    int numCompactionCalls;
+
+    // Number of engine runs aborted and handed to the SAT back end
+    int numSatCalls;
+
+    // Backtracks summed over all engine runs
+    long long numBacktracks;
+
+    // Conflicts summed over all SAT back end runs
+    long long numSatConflicts;
+
+    // Random source of the X input fill
+    std::mt19937 fillGenerator;
+
+    /*
+    * Constructor for the class
+    * @param inCkt -> circuit read from netlist
+    * @param inFaultList -> faults to generate tests for
+    */
+    TestGenerator(Circuit* inCkt, const std::vector<std::pair<int, int>>& inFaultList);
+
+    /*
+    * Function to set up the circuit for a target fault, all node values X
+    * @param faultPosition -> position of the fault in the fault list
+    */
+    void set_target_fault(int faultPosition);
+
+    /*
+    * Function to run the selected test generation engine on the target fault of the circuit
+    * The SAT back end takes over if the engine aborts
+    * @return bool -> if a test was found, else the fault is redundant or aborted (ckt->podemAborted)
+    */
+    bool run_engine();
+
+    /*
+    * Function to run PODEM for a secondary fault with the assigned inputs of a test cube kept
+    * @param faultPosition -> position of the secondary fault in the fault list
+    * @param testCube -> test cube to extend (updated in place if a test was found)
+    * @return bool -> if the cube was extended to detect the fault
+    */
+    bool extend_test_cube(int faultPosition, std::string& testCube);
+
+    /*
+    * Function to extend a test cube with the undetected faults that can still be detected under it
+    * @param faultPosition -> position of the target fault of the cube
+    * @param testCube -> test cube to extend (updated in place)
+    */
+    void compact_test_cube(int faultPosition, std::string& testCube);
+
+    /*
+    * Function to run PODEM on a fault and drop all faults its test vector detects
+    * @param faultPosition -> position of the target fault in the fault list
+    * @param numDropped -> faults detected by the test vector, target included (updated in place)
+    * @return bool -> if a test vector was generated, else the fault is marked redundant or aborted
+    */
+    bool generate_test(int faultPosition, int& numDropped);
+
+    /*
+    * Function to generate tests until every fault is detected, proven redundant or aborted by PODEM
+    * @param printTests -> print the test vector of each targeted fault
+    */
+    void run(bool printTests);
+
+    /*
+    * Function to fill the X inputs of a test cube randomly
+    * @param testCube -> value per primary input (1, 0 or X)
+    * @return string -> fully specified test vector
+    */
+    std::string fill_test_cube(std::string testCube);
+
+    /*
+    * Function to get the faults in a given state
+    * @param status -> state to count
+    * @return int -> number of faults in the state
+    */
+    int get_num_faults(faultStatus status);
+};
+
+#endif